@@ -0,0 +1,48 @@
+#include "bench.hpp"
+#include <biovoltron/algo/align/batch_aligner.hpp>
+#include <biovoltron/utility/simulator.hpp>
+
+using namespace biovoltron;
+
+namespace {
+
+auto bench_mode(bench::State &state, BatchAligner aligner) {
+  const auto genome =
+      simulate_genome<true>({.length = std::size_t{1} << 20}, state.seed());
+  const auto reads = simulate_reads<true>(
+      genome, 0, state.arg(),
+      {.substitution_rate = 0.01, .insertion_rate = 0.002,
+       .deletion_rate = 0.002, .reverse_rate = 0},
+      state.seed());
+  // The part of the reference every read comes from, with 20 flanking
+  // bases on both sides. Reads are named <chrom>_<start>_<strand>_<number>.
+  auto windows = std::vector<istring_view>{};
+  auto cells = std::size_t{};
+  for (const auto &read : reads) {
+    const auto start = std::stoul(read.name.substr(read.name.find('_') + 1));
+    const auto begin = std::max<std::size_t>(start, 20) - 20;
+    windows.push_back(istring_view{genome[0].seq}.substr(begin, 190));
+    cells += read.seq.size() * windows.back().size();
+  }
+  // Items are cells of the dynamic programming matrices.
+  state.items(cells);
+  state.run([&] { bench::keep(aligner(reads, windows).size()); });
+}
+
+} // namespace
+
+BENCHMARK("batch_aligner/local/150", 1 << 12) {
+  bench_mode(state, {.mode = AlignMode::LOCAL});
+}
+
+BENCHMARK("batch_aligner/global/150", 1 << 12) {
+  bench_mode(state, {.mode = AlignMode::GLOBAL});
+}
+
+BENCHMARK("batch_aligner/extend/150", 1 << 12) {
+  bench_mode(state, {.mode = AlignMode::EXTEND});
+}
+
+BENCHMARK("batch_aligner/local_cigar/150", 1 << 12) {
+  bench_mode(state, {.mode = AlignMode::LOCAL, .cigar = true});
+}
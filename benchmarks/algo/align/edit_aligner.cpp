@@ -0,0 +1,64 @@
+#include "bench.hpp"
+#include <biovoltron/algo/align/edit_aligner.hpp>
+#include <biovoltron/utility/simulator.hpp>
+
+using namespace biovoltron;
+
+namespace {
+
+// Simulated forward reads and the part of the reference they come from,
+// with 8 flanking bases on both sides.
+auto read_pairs(std::size_t count, std::size_t length, std::uint64_t seed) {
+  const auto genome =
+      simulate_genome<true>({.length = std::size_t{1} << 20}, seed);
+  const auto reads = simulate_reads<true>(
+      genome, 0, count,
+      {.read_length = length, .substitution_rate = 0.01,
+       .insertion_rate = 0.002, .deletion_rate = 0.002, .reverse_rate = 0},
+      seed);
+  auto pairs = std::vector<std::pair<istring, istring>>{};
+  for (const auto &read : reads) {
+    // Reads are named <chrom>_<start>_<strand>_<number>.
+    const auto start = std::stoul(read.name.substr(read.name.find('_') + 1));
+    const auto begin = std::max<std::size_t>(start, 8) - 8;
+    pairs.emplace_back(read.seq, genome[0].seq.substr(begin, length + 16));
+  }
+  return pairs;
+}
+
+auto bench_mode(bench::State &state, std::size_t length, EditAligner aligner) {
+  const auto pairs = read_pairs(state.arg(), length, state.seed());
+  auto cells = std::size_t{};
+  for (const auto &[pattern, text] : pairs)
+    cells += pattern.size() * text.size();
+  // Items are cells of the dynamic programming matrix.
+  state.items(cells);
+  state.run([&] {
+    auto total = 0l;
+    for (const auto &[pattern, text] : pairs)
+      total += aligner(pattern, text).distance;
+    bench::keep(total);
+  });
+}
+
+} // namespace
+
+BENCHMARK("edit_aligner/global/150", 1 << 12) {
+  bench_mode(state, 150, {});
+}
+
+BENCHMARK("edit_aligner/infix/150", 1 << 12) {
+  bench_mode(state, 150, {.mode = EditMode::INFIX});
+}
+
+BENCHMARK("edit_aligner/infix_k8/150", 1 << 12) {
+  bench_mode(state, 150, {.mode = EditMode::INFIX, .max_distance = 8});
+}
+
+BENCHMARK("edit_aligner/infix_cigar/150", 1 << 12) {
+  bench_mode(state, 150, {.mode = EditMode::INFIX, .cigar = true});
+}
+
+BENCHMARK("edit_aligner/global_k32/2000", 1 << 8) {
+  bench_mode(state, 2000, {.max_distance = 32});
+}
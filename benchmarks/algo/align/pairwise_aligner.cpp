@@ -0,0 +1,62 @@
+#include "bench.hpp"
+#include <biovoltron/algo/align/pairwise_aligner.hpp>
+#include <biovoltron/utility/simulator.hpp>
+
+using namespace biovoltron;
+
+namespace {
+
+// Simulated forward reads and the part of the reference they come from,
+// with length / 8 flanking bases on both sides.
+auto read_pairs(std::size_t count, std::size_t length, std::uint64_t seed) {
+  const auto genome =
+      simulate_genome<true>({.length = std::size_t{1} << 20}, seed);
+  const auto reads = simulate_reads<true>(
+      genome, 0, count,
+      {.read_length = length, .substitution_rate = 0.01,
+       .insertion_rate = 0.002, .deletion_rate = 0.002, .reverse_rate = 0},
+      seed);
+  const auto flank = length / 8;
+  auto pairs = std::vector<std::pair<istring, istring>>{};
+  for (const auto &read : reads) {
+    // Reads are named <chrom>_<start>_<strand>_<number>.
+    const auto start = std::stoul(read.name.substr(read.name.find('_') + 1));
+    const auto begin = start < flank ? 0 : start - flank;
+    pairs.emplace_back(read.seq,
+                       genome[0].seq.substr(begin, length + 2 * flank));
+  }
+  return pairs;
+}
+
+auto bench_mode(bench::State &state, PairwiseAligner aligner) {
+  const auto pairs = read_pairs(state.arg(), 150, state.seed());
+  auto cells = std::size_t{};
+  for (const auto &[query, ref] : pairs)
+    cells += query.size() * ref.size();
+  // Items are cells of the dynamic programming matrix.
+  state.items(cells);
+  state.run([&] {
+    auto total = 0l;
+    for (const auto &[query, ref] : pairs)
+      total += aligner(query, ref).score;
+    bench::keep(total);
+  });
+}
+
+} // namespace
+
+BENCHMARK("pairwise_aligner/local/150", 1 << 10) {
+  bench_mode(state, {.mode = AlignMode::LOCAL});
+}
+
+BENCHMARK("pairwise_aligner/global/150", 1 << 10) {
+  bench_mode(state, {.mode = AlignMode::GLOBAL});
+}
+
+BENCHMARK("pairwise_aligner/global_band16/150", 1 << 10) {
+  bench_mode(state, {.mode = AlignMode::GLOBAL, .band = 16});
+}
+
+BENCHMARK("pairwise_aligner/local_cigar/150", 1 << 10) {
+  bench_mode(state, {.mode = AlignMode::LOCAL, .cigar = true});
+}
@@ -0,0 +1,51 @@
+#include "bench.hpp"
+#include <biovoltron/algo/index/suffix_array_index.hpp>
+#include <biovoltron/utility/simulator.hpp>
+
+using namespace biovoltron;
+
+namespace {
+
+// Simulated forward reads of a 1 Mbp genome, with sequencing errors.
+auto search_reads(bench::State &state, std::size_t length, std::size_t k,
+                  SearchMetric metric) {
+  const auto genome =
+      simulate_genome<true>({.length = std::size_t{1} << 20}, state.seed());
+  const auto reads = simulate_reads<true>(
+      genome, 0, state.arg(),
+      {.read_length = length, .substitution_rate = 0.005,
+       .insertion_rate = metric == SearchMetric::EDIT ? 0.001 : 0,
+       .deletion_rate = metric == SearchMetric::EDIT ? 0.001 : 0,
+       .reverse_rate = 0},
+      state.seed());
+  const auto index = SuffixArrayIndex{genome[0].seq};
+  auto patterns = std::vector<istring_view>{};
+  for (const auto &read : reads)
+    patterns.push_back(read.seq);
+  // Items are searched patterns.
+  state.items(patterns.size());
+  state.run([&] {
+    auto found = std::size_t{};
+    for (const auto &matches : index.search(patterns, k, metric))
+      found += !matches.empty();
+    bench::keep(found);
+  });
+}
+
+} // namespace
+
+BENCHMARK("suffix_array_index/hamming_k0/50", 1 << 14) {
+  search_reads(state, 50, 0, SearchMetric::HAMMING);
+}
+
+BENCHMARK("suffix_array_index/hamming_k2/50", 1 << 14) {
+  search_reads(state, 50, 2, SearchMetric::HAMMING);
+}
+
+BENCHMARK("suffix_array_index/hamming_k3/100", 1 << 14) {
+  search_reads(state, 100, 3, SearchMetric::HAMMING);
+}
+
+BENCHMARK("suffix_array_index/edit_k2/50", 1 << 14) {
+  search_reads(state, 50, 2, SearchMetric::EDIT);
+}
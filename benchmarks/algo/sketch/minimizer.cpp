@@ -0,0 +1,48 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <biovoltron/algo/sketch/minimizer.hpp>
+
+using namespace biovoltron;
+
+BENCHMARK("minimizer/istring/w10k15", 1 << 20, 1 << 24) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  const auto sketch = MinimizerSketch{10, 15};
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(sketch(seq).size()); });
+}
+
+BENCHMARK("minimizer/istring/w19k19/scalar", 1 << 20) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  const auto sketch = MinimizerSketch{19, 19};
+  const auto level = simd_level();
+  set_simd_level(SimdLevel::SCALAR);
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(sketch(seq).size()); });
+  set_simd_level(level);
+}
+
+BENCHMARK("minimizer/istring/w19k19", 1 << 20) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  const auto sketch = MinimizerSketch{19, 19};
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(sketch(seq).size()); });
+}
+
+BENCHMARK("minimizer/dibit_vector/w10k15", 1 << 20) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  const auto packed = DibitVector<>(seq.begin(), seq.end());
+  const auto sketch = MinimizerSketch{10, 15};
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(sketch(packed).size()); });
+}
+
+BENCHMARK("minimizer/batch/reads150", 10000) {
+  auto reads = std::vector<istring>{};
+  const auto seq = bench::random_istring(state.arg() * 150, state.seed());
+  for (auto i = std::size_t{}; i < seq.size(); i += 150)
+    reads.push_back(seq.substr(i, 150));
+  const auto sketch = MinimizerSketch{10, 15};
+  state.items(reads.size());
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(sketch.batch(reads).size()); });
+}
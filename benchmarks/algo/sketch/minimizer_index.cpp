@@ -0,0 +1,28 @@
+#include "bench.hpp"
+#include <biovoltron/algo/sketch/minimizer_index.hpp>
+#include <biovoltron/utility/simulator.hpp>
+
+using namespace biovoltron;
+
+BENCHMARK("minimizer_index/build/w10k15", 1 << 22, 1 << 24) {
+  const auto genome =
+      simulate_genome<true>({.length = state.arg()}, state.seed());
+  state.bytes(state.arg());
+  state.run([&] { bench::keep(MinimizerIndex{genome, 10, 15}.size()); });
+}
+
+BENCHMARK("minimizer_index/seeds/reads10k", 1 << 10) {
+  const auto genome =
+      simulate_genome<true>({.length = std::size_t{1} << 24}, state.seed());
+  const auto index = MinimizerIndex{genome, 10, 15};
+  const auto reads = simulate_reads<true>(
+      genome, 0, state.arg(), {.read_length = 10'000}, state.seed());
+  state.items(reads.size());
+  state.bytes(reads.size() * 10'000);
+  state.run([&] {
+    auto seeds = std::size_t{};
+    for (const auto &read : reads)
+      seeds += index.seeds(read.seq).size();
+    bench::keep(seeds);
+  });
+}
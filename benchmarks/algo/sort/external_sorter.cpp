@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include <biovoltron/algo/sort/external_sorter.hpp>
+#include <random>
+
+using namespace biovoltron;
+
+namespace {
+
+struct IntervalRecord : Record {
+  std::string chrom;
+  std::uint32_t start = 0;
+  std::uint32_t end = 0;
+};
+
+auto random_intervals(std::size_t n, std::uint64_t seed) {
+  auto gen = std::mt19937_64{seed};
+  auto records = std::vector<IntervalRecord>(n);
+  for (auto &record : records) {
+    record.chrom = "chr" + std::to_string(gen() % 22 + 1);
+    record.start = gen() % 250000000;
+    record.end = record.start + gen() % 1000;
+  }
+  return records;
+}
+
+const auto by_position = [](const IntervalRecord &r) {
+  return std::tie(r.chrom, r.start);
+};
+
+/**
+ * Sort state.arg() records, spilling runs of max_records records.
+ */
+auto sort_records(bench::State &state, std::size_t max_records) {
+  const auto records = random_intervals(state.arg(), state.seed());
+  state.items(records.size());
+  state.run([&] {
+    auto sorter = ExternalSorter<IntervalRecord, decltype(by_position)>{
+        by_position, max_records};
+    for (const auto &record : records)
+      sorter.push(record);
+    auto n = std::size_t{};
+    sorter.merge([&n](const auto &) { n++; });
+    bench::keep(n);
+  });
+}
+
+} // namespace
+
+BENCHMARK("sort/external_sorter/in_memory", 1 << 16, 1 << 20) {
+  sort_records(state, state.arg());
+}
+
+BENCHMARK("sort/external_sorter/spill_16_runs", 1 << 16, 1 << 20) {
+  sort_records(state, state.arg() / 16);
+}
@@ -0,0 +1,29 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <biovoltron/algo/suffix_sorter/stable_sorter.hpp>
+
+using namespace biovoltron;
+
+namespace {
+
+/**
+ * Suffix array construction of a random text of state.arg() bases, every
+ * SuffixSorter is registered with the same text sizes.
+ */
+template <SuffixSorter Sorter> auto sort_suffixes(bench::State &state) {
+  const auto ref = bench::random_istring(state.arg(), state.seed());
+  state.bytes(ref.size());
+  state.items(ref.size() + 1);
+  state.run([&] { bench::keep(Sorter::get_sa(ref).size()); });
+}
+
+} // namespace
+
+BENCHMARK("suffix_sorter/stable_sorter", 1 << 12, 1 << 16, 1 << 20) {
+  sort_suffixes<StableSorter<>>(state);
+}
+
+BENCHMARK("suffix_sorter/stable_sorter/sort_len_32", 1 << 12, 1 << 16,
+          1 << 20) {
+  sort_suffixes<StableSorter<std::uint32_t, 32>>(state);
+}
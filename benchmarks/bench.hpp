@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * A minimal benchmark harness for biovoltron.
+ *
+ * A benchmark case is a function taking a `bench::State &`, registered with
+ * `BENCHMARK(name, args...)` once for every argument, which is usually the
+ * input size. The case prepares its input, then passes the code to measure
+ * to `state.run()` and reports the bytes or items processed per iteration so
+ * that throughput is derived from the median iteration time.
+ *
+ * ```cpp
+ * BENCHMARK("codec/to_istring", 1 << 20, 1 << 24) {
+ *   const auto seq = bench::random_dna(state.arg(), state.seed());
+ *   state.bytes(seq.size());
+ *   state.run([&] { bench::keep(Codec::to_istring(seq)); });
+ * }
+ * ```
+ */
+namespace bench {
+
+/**
+ * @brief Prevent the compiler from optimizing value away.
+ */
+template <class T> inline auto keep(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Measurement settings shared by all cases.
+ */
+struct Options {
+  double min_time = 0.5;
+  std::size_t min_iterations = 3;
+  std::size_t max_iterations = 1000000;
+  std::uint64_t seed = 42;
+};
+
+/**
+ * @brief Result of one case with one argument.
+ */
+struct Result {
+  std::string name;
+  std::size_t arg = 0;
+  std::size_t iterations = 0;
+  double min_ns = 0;
+  double median_ns = 0;
+  double mean_ns = 0;
+  double bytes_per_second = 0;
+  double items_per_second = 0;
+};
+
+class State {
+  std::size_t arg_;
+  const Options &options_;
+  std::size_t bytes_ = 0;
+  std::size_t items_ = 0;
+  std::vector<double> samples_;
+
+public:
+  State(std::size_t arg, const Options &options)
+    : arg_(arg), options_(options) {}
+
+  /**
+   * @brief The argument the case was registered with.
+   */
+  auto arg() const noexcept { return arg_; }
+
+  /**
+   * @brief Seed for input generators, the same for every run.
+   */
+  auto seed() const noexcept { return options_.seed; }
+
+  /**
+   * @brief Bytes processed by one iteration.
+   */
+  auto bytes(std::size_t n) noexcept { bytes_ = n; }
+
+  /**
+   * @brief Items (reads, records, suffixes, ...) processed by one iteration.
+   */
+  auto items(std::size_t n) noexcept { items_ = n; }
+
+  /**
+   * @brief Time iterations of f, after one untimed warm-up, until both the
+   * minimum time and the minimum number of iterations are reached.
+   */
+  template <class F> auto run(F &&f) {
+    using clock = std::chrono::steady_clock;
+    f();
+    auto total = 0.0;
+    while (samples_.size() < options_.max_iterations &&
+           (total < options_.min_time * 1e9 ||
+            samples_.size() < options_.min_iterations)) {
+      const auto start = clock::now();
+      f();
+      const auto ns =
+          std::chrono::duration<double, std::nano>(clock::now() - start)
+              .count();
+      samples_.push_back(ns);
+      total += ns;
+    }
+  }
+
+  auto result(std::string name) const {
+    auto result = Result{std::move(name), arg_, samples_.size()};
+    if (samples_.empty())
+      return result;
+    auto sorted = samples_;
+    std::ranges::sort(sorted);
+    result.min_ns = sorted.front();
+    result.median_ns = sorted[sorted.size() / 2];
+    result.mean_ns =
+        std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    if (result.median_ns > 0) {
+      result.bytes_per_second = bytes_ * 1e9 / result.median_ns;
+      result.items_per_second = items_ * 1e9 / result.median_ns;
+    }
+    return result;
+  }
+};
+
+struct Case {
+  std::string name;
+  std::size_t arg;
+  std::function<void(State &)> fn;
+};
+
+inline auto &registry() {
+  static auto cases = std::vector<Case>{};
+  return cases;
+}
+
+struct Registrar {
+  Registrar(std::string_view name, std::vector<std::size_t> args,
+            void (*fn)(State &)) {
+    if (args.empty())
+      args.push_back(0);
+    for (const auto arg : args)
+      registry().push_back({std::string{name}, arg, fn});
+  }
+};
+
+/**
+ * @brief Write results as JSON, one object per case and argument.
+ */
+inline auto write_json(std::ostream &os, const std::vector<Result> &results,
+                       const Options &options) {
+  const auto precision = os.precision(12);
+  os << "{\n  \"context\": {\"seed\": " << options.seed
+     << ", \"min_time\": " << options.min_time << ", \"compiler\": \""
+#if defined(__clang__)
+     << "clang " << __clang_version__
+#elif defined(__GNUC__)
+     << "gcc " << __VERSION__
+#endif
+     << "\"},\n  \"benchmarks\": [";
+  for (auto i = std::size_t{}; i < results.size(); i++) {
+    const auto &r = results[i];
+    os << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name
+       << "\", \"arg\": " << r.arg << ", \"iterations\": " << r.iterations
+       << ", \"min_ns\": " << r.min_ns << ", \"median_ns\": " << r.median_ns
+       << ", \"mean_ns\": " << r.mean_ns
+       << ", \"bytes_per_second\": " << r.bytes_per_second
+       << ", \"items_per_second\": " << r.items_per_second << "}";
+  }
+  os << "\n  ]\n}\n";
+  os.precision(precision);
+}
+
+} // namespace bench
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+
+/**
+ * Register a benchmark case, once for every following argument, the body
+ * gets `bench::State &state`.
+ */
+#define BENCHMARK(name, ...)                                                   \
+  static void BENCH_CONCAT(bench_case_, __LINE__)(bench::State &);             \
+  static const auto BENCH_CONCAT(bench_registrar_, __LINE__) =                 \
+      bench::Registrar{name,                                                   \
+                       {__VA_ARGS__},                                          \
+                       BENCH_CONCAT(bench_case_, __LINE__)};                   \
+  static void BENCH_CONCAT(bench_case_, __LINE__)(bench::State & state)
@@ -0,0 +1,57 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <biovoltron/container/xbit_vector.hpp>
+#include <biovoltron/utility/istring.hpp>
+
+using namespace biovoltron;
+
+BENCHMARK("dibit_vector/push_back", 1 << 16, 1 << 20, 1 << 24) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  state.items(seq.size());
+  state.run([&] {
+    auto v = DibitVector<>{};
+    for (const auto c : seq)
+      v.push_back(c);
+    bench::keep(v.size());
+  });
+}
+
+BENCHMARK("dibit_vector/assign", 1 << 16, 1 << 20, 1 << 24) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  state.items(seq.size());
+  state.run([&] {
+    auto v = DibitVector<>(seq.begin(), seq.end());
+    bench::keep(v.size());
+  });
+}
+
+BENCHMARK("dibit_vector/iterate", 1 << 16, 1 << 20, 1 << 24) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  const auto v = DibitVector<>(seq.begin(), seq.end());
+  state.items(v.size());
+  state.run([&] {
+    auto sum = std::size_t{};
+    for (const auto c : v)
+      sum += c;
+    bench::keep(sum);
+  });
+}
+
+BENCHMARK("dibit_vector/flip", 1 << 16, 1 << 20, 1 << 24) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  auto v = DibitVector<>(seq.begin(), seq.end());
+  state.items(v.size());
+  state.run([&] {
+    v.flip();
+    bench::keep(v.size());
+  });
+}
+
+BENCHMARK("dibit_vector/resize", 1 << 16, 1 << 20, 1 << 24) {
+  state.items(state.arg());
+  state.run([&] {
+    auto v = DibitVector<>{};
+    v.resize(state.arg(), 2);
+    bench::keep(v.size());
+  });
+}
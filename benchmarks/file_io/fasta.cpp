@@ -0,0 +1,28 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <biovoltron/file_io/fasta.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+template <bool Encoded> auto parse_fasta(bench::State &state) {
+  const auto text = bench::random_fasta(state.arg(), state.seed());
+  state.bytes(text.size());
+  state.run([&] {
+    auto is = std::istringstream{text};
+    auto bases = std::size_t{};
+    for (auto record = FastaRecord<Encoded>{}; is >> record;)
+      bases += record.seq.size();
+    bench::keep(bases);
+  });
+}
+
+} // namespace
+
+BENCHMARK("fasta/parse", 1 << 20, 1 << 24) { parse_fasta<false>(state); }
+
+BENCHMARK("fasta/parse/encoded", 1 << 20, 1 << 24) {
+  parse_fasta<true>(state);
+}
@@ -0,0 +1,29 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <biovoltron/file_io/fastq.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+template <bool Encoded> auto parse_fastq(bench::State &state) {
+  const auto text = bench::random_fastq(state.arg(), state.seed());
+  state.bytes(text.size());
+  state.items(state.arg());
+  state.run([&] {
+    auto is = std::istringstream{text};
+    auto bases = std::size_t{};
+    for (auto record = FastqRecord<Encoded>{}; is >> record;)
+      bases += record.seq.size();
+    bench::keep(bases);
+  });
+}
+
+} // namespace
+
+BENCHMARK("fastq/parse", 1 << 12, 1 << 16) { parse_fastq<false>(state); }
+
+BENCHMARK("fastq/parse/encoded", 1 << 12, 1 << 16) {
+  parse_fastq<true>(state);
+}
@@ -0,0 +1,32 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <biovoltron/file_io/fastq_batch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+template <bool Encoded> auto parse_batches(bench::State &state) {
+  const auto text = bench::random_fastq(state.arg(), state.seed());
+  state.bytes(text.size());
+  state.items(state.arg());
+  auto batch = FastqBatch<Encoded>{};
+  state.run([&] {
+    auto is = std::istringstream{text};
+    auto bases = std::size_t{};
+    while (is >> batch)
+      bases += batch.seqs.size();
+    bench::keep(bases);
+  });
+}
+
+} // namespace
+
+BENCHMARK("fastq_batch/parse", 1 << 12, 1 << 16) {
+  parse_batches<false>(state);
+}
+
+BENCHMARK("fastq_batch/parse/encoded", 1 << 12, 1 << 16) {
+  parse_batches<true>(state);
+}
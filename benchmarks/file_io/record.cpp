@@ -0,0 +1,70 @@
+#include "bench.hpp"
+#include <biovoltron/file_io/core/parallel_reader.hpp>
+#include <biovoltron/file_io/core/record.hpp>
+#include <random>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct IntervalRecord : Record {
+  std::string chrom;
+  std::uint32_t start = 0;
+  std::uint32_t end = 0;
+  double score = 0;
+};
+
+auto random_intervals(std::size_t n, std::uint64_t seed) {
+  auto gen = std::mt19937_64{seed};
+  auto text = std::string{};
+  for (auto i = std::size_t{}; i < n; i++) {
+    const auto start = gen() % 250000000;
+    const auto end = start + gen() % 1000;
+    text += "chr" + std::to_string(gen() % 22 + 1) + "\t" +
+            std::to_string(start) + "\t" + std::to_string(end) + "\t" +
+            std::to_string(gen() % 1000 / 10.0) + "\n";
+  }
+  return text;
+}
+
+} // namespace
+
+BENCHMARK("record/parse", 1 << 12, 1 << 18) {
+  const auto text = random_intervals(state.arg(), state.seed());
+  state.bytes(text.size());
+  state.items(state.arg());
+  state.run([&] {
+    auto is = std::istringstream{text};
+    auto sum = std::size_t{};
+    for (auto record = IntervalRecord{}; is >> record;)
+      sum += record.end - record.start;
+    bench::keep(sum);
+  });
+}
+
+BENCHMARK("record/read_records", 1 << 12, 1 << 18) {
+  const auto text = random_intervals(state.arg(), state.seed());
+  state.bytes(text.size());
+  state.items(state.arg());
+  state.run([&] {
+    auto is = std::istringstream{text};
+    bench::keep(read_records<IntervalRecord>(is).size());
+  });
+}
+
+BENCHMARK("record/write_records", 1 << 12, 1 << 18) {
+  const auto text = random_intervals(state.arg(), state.seed());
+  auto records = std::vector<IntervalRecord>{};
+  {
+    auto is = std::istringstream{text};
+    records = read_records<IntervalRecord>(is);
+  }
+  state.bytes(text.size());
+  state.items(records.size());
+  state.run([&] {
+    auto os = std::ostringstream{};
+    write_records(os, records);
+    bench::keep(os.tellp());
+  });
+}
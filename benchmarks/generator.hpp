@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <biovoltron/utility/istring.hpp>
+#include <biovoltron/utility/simulator.hpp>
+#include <cstdint>
+#include <random>
+#include <string>
+
+/**
+ * Seeded synthetic inputs, so every run of a benchmark sees the same data.
+ * Genomes and reads come from the simulator of biovoltron.
+ */
+namespace bench {
+
+/**
+ * @brief Uniformly random ACGT sequence.
+ */
+inline auto random_dna(std::size_t size, std::uint64_t seed) {
+  auto gen = std::mt19937_64{seed};
+  auto seq = std::string(size, 'A');
+  for (auto i = std::size_t{}; i < size; i += 32) {
+    auto bits = gen();
+    for (auto j = i; j < std::min(i + 32, size); j++, bits >>= 2)
+      seq[j] = "ACGT"[bits & 3];
+  }
+  return seq;
+}
+
+/**
+ * @brief Uniformly random sequence of 0-3.
+ */
+inline auto random_istring(std::size_t size, std::uint64_t seed) {
+  return biovoltron::Codec::to_istring(random_dna(size, seed));
+}
+
+/**
+ * @brief Simulated reference genome of about size bases in FASTA format,
+ * split into records of record_size bases and lines of 60 bases.
+ */
+inline auto random_fasta(std::size_t size, std::uint64_t seed,
+                         std::size_t record_size = std::size_t{1} << 20) {
+  const auto genome = biovoltron::simulate_genome(
+      {.chromosomes = std::max<std::size_t>(size / record_size, 1),
+       .length = std::min(size, record_size)},
+      seed);
+  auto text = std::string{};
+  text.reserve(size + size / 60 + genome.size() * 16);
+  for (const auto &record : genome) {
+    text += ">" + record.name + "\n";
+    for (auto i = std::size_t{}; i < record.seq.size(); i += 60) {
+      text.append(record.seq, i, 60);
+      text += '\n';
+    }
+  }
+  return text;
+}
+
+/**
+ * @brief FASTQ text of `reads` simulated reads of read_size bases with the
+ * default error and quality profile.
+ */
+inline auto random_fastq(std::size_t reads, std::uint64_t seed,
+                         std::size_t read_size = 150) {
+  const auto genome = biovoltron::simulate_genome({}, seed);
+  auto text = std::string{};
+  text.reserve(reads * (2 * read_size + 32));
+  for (const auto &read : biovoltron::simulate_reads(
+           genome, 0, reads, {.read_length = read_size}, seed)) {
+    text += "@" + read.name + "\n" + read.seq + "\n+\n" + read.qual;
+    text += '\n';
+  }
+  return text;
+}
+
+} // namespace bench
@@ -0,0 +1,91 @@
+#include "bench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+auto usage() {
+  std::cerr << "usage: biovoltron-bench [--filter substring] [--json file]\n"
+               "                        [--min-time seconds] [--seed n] "
+               "[--quick] [--list]\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  auto options = bench::Options{};
+  auto filter = std::string{};
+  auto json = std::string{};
+  auto quick = false;
+  auto list = false;
+  for (auto i = 1; i < argc; i++) {
+    const auto arg = std::string_view{argv[i]};
+    const auto has_value = i + 1 < argc;
+    if (arg == "--filter" && has_value)
+      filter = argv[++i];
+    else if (arg == "--json" && has_value)
+      json = argv[++i];
+    else if (arg == "--min-time" && has_value)
+      options.min_time = std::stod(argv[++i]);
+    else if (arg == "--seed" && has_value)
+      options.seed = std::stoull(argv[++i]);
+    else if (arg == "--quick")
+      quick = true;
+    else if (arg == "--list")
+      list = true;
+    else {
+      usage();
+      return 1;
+    }
+  }
+
+  // --quick only runs the smallest argument of every case once, as a smoke
+  // test of the benchmarks themselves.
+  if (quick) {
+    options.min_time = 0;
+    options.min_iterations = 1;
+  }
+
+  // Cases of different files register in an unspecified order.
+  auto &cases = bench::registry();
+  std::ranges::stable_sort(cases, {}, &bench::Case::name);
+
+  auto results = std::vector<bench::Result>{};
+  auto done = std::vector<std::string>{};
+  for (const auto &c : cases) {
+    if (c.name.find(filter) == std::string::npos)
+      continue;
+    if (quick && std::ranges::find(done, c.name) != done.end())
+      continue;
+    done.push_back(c.name);
+    if (list) {
+      std::cout << c.name << "/" << c.arg << "\n";
+      continue;
+    }
+    auto state = bench::State{c.arg, options};
+    c.fn(state);
+    const auto &r = results.emplace_back(state.result(c.name));
+    std::fprintf(stderr, "%-40s %12zu %10zu it %14.0f ns", r.name.c_str(),
+                 r.arg, r.iterations, r.median_ns);
+    if (r.bytes_per_second > 0)
+      std::fprintf(stderr, " %10.1f MB/s", r.bytes_per_second / 1e6);
+    if (r.items_per_second > 0)
+      std::fprintf(stderr, " %12.0f items/s", r.items_per_second);
+    std::fprintf(stderr, "\n");
+  }
+  if (list)
+    return 0;
+
+  if (json.empty())
+    bench::write_json(std::cout, results, options);
+  else {
+    auto os = std::ofstream{json};
+    bench::write_json(os, results, options);
+    if (!os) {
+      std::cerr << "cannot write " << json << "\n";
+      return 1;
+    }
+  }
+}
@@ -0,0 +1,41 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <biovoltron/utility/istring.hpp>
+
+using namespace biovoltron;
+
+BENCHMARK("codec/to_istring", 1 << 16, 1 << 20, 1 << 24) {
+  const auto seq = bench::random_dna(state.arg(), state.seed());
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(Codec::to_istring(seq)); });
+}
+
+BENCHMARK("codec/to_string", 1 << 16, 1 << 20, 1 << 24) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(Codec::to_string(seq)); });
+}
+
+BENCHMARK("codec/rev_comp/istring", 1 << 16, 1 << 20, 1 << 24) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(Codec::rev_comp(istring_view{seq})); });
+}
+
+BENCHMARK("codec/rev_comp/string", 1 << 16, 1 << 20, 1 << 24) {
+  const auto seq = bench::random_dna(state.arg(), state.seed());
+  state.bytes(seq.size());
+  state.run([&] { bench::keep(Codec::rev_comp(std::string_view{seq})); });
+}
+
+BENCHMARK("codec/hash/k31", 1 << 16, 1 << 20) {
+  const auto seq = bench::random_istring(state.arg(), state.seed());
+  const auto view = istring_view{seq};
+  state.items(seq.size() - 30);
+  state.run([&] {
+    auto sum = 0ull;
+    for (auto i = std::size_t{}; i + 31 <= view.size(); i++)
+      sum += Codec::hash(view.substr(i, 31));
+    bench::keep(sum);
+  });
+}
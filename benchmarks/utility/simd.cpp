@@ -0,0 +1,62 @@
+#include "bench.hpp"
+#include "generator.hpp"
+#include <biovoltron/container/xbit_vector.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <biovoltron/utility/simd.hpp>
+
+using namespace biovoltron;
+
+// The argument is the SimdLevel: 0 scalar, 1 AVX2, 2 AVX-512. Levels the
+// CPU lacks are clamped to the best supported one.
+
+namespace {
+
+constexpr auto size = std::size_t{1} << 20;
+
+auto use_level(bench::State &state) {
+  set_simd_level(static_cast<SimdLevel>(state.arg()));
+}
+
+auto restore_level() { set_simd_level(SimdLevel::AVX512); }
+
+} // namespace
+
+BENCHMARK("simd/encode", 0, 1, 2) {
+  const auto seq = bench::random_dna(size, state.seed());
+  use_level(state);
+  state.bytes(size);
+  state.run([&] { bench::keep(Codec::to_istring(seq)); });
+  restore_level();
+}
+
+BENCHMARK("simd/decode", 0, 1, 2) {
+  const auto seq = bench::random_istring(size, state.seed());
+  use_level(state);
+  state.bytes(size);
+  state.run([&] { bench::keep(Codec::to_string(seq)); });
+  restore_level();
+}
+
+BENCHMARK("simd/rev_comp/istring", 0, 1, 2) {
+  const auto seq = bench::random_istring(size, state.seed());
+  use_level(state);
+  state.bytes(size);
+  state.run([&] { bench::keep(Codec::rev_comp(istring_view{seq})); });
+  restore_level();
+}
+
+BENCHMARK("simd/rev_comp/string", 0, 1, 2) {
+  const auto seq = bench::random_dna(size, state.seed());
+  use_level(state);
+  state.bytes(size);
+  state.run([&] { bench::keep(Codec::rev_comp(std::string_view{seq})); });
+  restore_level();
+}
+
+BENCHMARK("simd/dibit_pack", 0, 1, 2) {
+  const auto seq = bench::random_istring(size, state.seed());
+  use_level(state);
+  state.items(size);
+  state.run([&] { bench::keep(DibitVector<>(seq.begin(), seq.end()).size()); });
+  restore_level();
+}
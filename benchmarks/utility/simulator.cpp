@@ -0,0 +1,20 @@
+#include "bench.hpp"
+#include <biovoltron/utility/simulator.hpp>
+
+using namespace biovoltron;
+
+BENCHMARK("simulator/genome", 1 << 20, 1 << 24) {
+  state.bytes(state.arg());
+  state.run([&] {
+    bench::keep(simulate_genome({.length = state.arg()}, state.seed()));
+  });
+}
+
+BENCHMARK("simulator/reads", 1 << 12, 1 << 16) {
+  const auto genome = simulate_genome({}, state.seed());
+  state.items(state.arg());
+  state.bytes(state.arg() * ReadProfile{}.read_length);
+  state.run([&] {
+    bench::keep(simulate_reads(genome, 0, state.arg(), {}, state.seed()));
+  });
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+/**
+ * @defgroup align align
+ * @ingroup algo
+ * @brief The "align" module scores and aligns pairs of sequences.
+ *
+ * Affine gap alignments in global, local, semi-global and extension modes
+ * are computed by vectorized dynamic programming kernels, which agree with
+ * a scalar reference kernel on every score and every CIGAR. Edit
+ * distances, e.g. of barcodes and adapters, are computed 64 bases at a time
+ * by bit-parallel kernels.
+ */
+
+#include <biovoltron/algo/align/batch_aligner.hpp>
+#include <biovoltron/algo/align/edit_aligner.hpp>
+#include <biovoltron/algo/align/pairwise_aligner.hpp>
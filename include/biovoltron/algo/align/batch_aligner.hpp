@@ -0,0 +1,323 @@
+#pragma once
+
+#include <biovoltron/algo/align/pairwise_aligner.hpp>
+#include <biovoltron/file_io/fastq.hpp>
+#include <execution>
+#include <numeric>
+#include <span>
+#include <type_traits>
+
+namespace biovoltron {
+
+namespace detail::align {
+
+#ifdef BIOVOLTRON_X86_DISPATCH
+
+/**
+ * @brief Gotoh's algorithm for up to LANES pairs at once, pair k in lane k.
+ *
+ * The matrices are computed column by column over the longest query and
+ * reference of the pairs. Cells past the end of a pair only depend on
+ * cells before them, so they never change its result and are only masked
+ * out of its best cell. Rows of best cells are kept in score lanes, so
+ * queries may have at most 2^bits of a score bases.
+ */
+template <class Ops>
+[[gnu::target("avx2")]] inline auto
+batch_avx2(std::span<const istring_view> queries,
+           std::span<const istring_view> refs, Start start, End end,
+           const AlignScoring &scoring) {
+  using L = Limits<Ops>;
+  using T = typename Ops::value_type;
+  using U = std::make_unsigned_t<T>;
+  constexpr auto LANES = Ops::LANES;
+  const auto lanes = static_cast<int>(queries.size());
+  auto n = std::array<long, LANES>{}, m = std::array<long, LANES>{};
+  for (auto k = 0; k < lanes; k++) {
+    n[k] = queries[k].size();
+    m[k] = refs[k].size();
+  }
+  const auto rows = *std::ranges::max_element(n);
+  const auto cols = *std::ranges::max_element(m);
+  const auto bias = start == Start::LOCAL ? L::MIN : 0;
+  const auto stored = [&](long x) { return L::saturate(x + bias); };
+
+  // Bases of row i or column j of every lane, 4 past the ends, and masks
+  // of the lanes that still have the row or column.
+  thread_local auto buffers = std::array<std::vector<Block>, 6>{};
+  auto &[query, ref, row_valid, col_valid, h_col, e_col] = buffers;
+  query.resize(rows);
+  row_valid.resize(rows);
+  h_col.resize(rows);
+  e_col.resize(rows);
+  ref.resize(cols);
+  col_valid.resize(cols);
+  const auto lane = [](std::vector<Block> &v, long x, int k) -> T & {
+    return reinterpret_cast<T *>(v.data() + x)[k];
+  };
+  for (auto i = 0l; i < rows; i++)
+    for (auto k = 0; k < LANES; k++) {
+      lane(query, i, k) = i < n[k] ? queries[k][i] : 4;
+      lane(row_valid, i, k) = i < n[k] ? -1 : 0;
+      lane(h_col, i, k) = stored(left(start, scoring, i));
+      lane(e_col, i, k) = L::MIN;
+    }
+  for (auto j = 0l; j < cols; j++)
+    for (auto k = 0; k < LANES; k++) {
+      lane(ref, j, k) = j < m[k] ? refs[k][j] : 4;
+      lane(col_valid, j, k) = j < m[k] ? -1 : 0;
+    }
+
+  struct Best {
+    long stored, i, j;
+  };
+  auto best = std::array<Best, LANES>{};
+  auto best_lanes = std::array<T, LANES>{};
+  for (auto k = 0; k < lanes; k++) {
+    const auto [score, i, j] = initial_best(
+        {queries[k], refs[k], start, end, 1 - n[k], m[k] - 1}, scoring);
+    best[k] = {stored(score), i, j};
+    best_lanes[k] = best[k].stored;
+  }
+
+  const auto v_oe = Ops::set1(scoring.gap_open + scoring.gap_extend);
+  const auto v_ext = Ops::set1(scoring.gap_extend);
+  const auto v_match = Ops::set1(scoring.match);
+  const auto v_mismatch = Ops::set1(-scoring.mismatch);
+  const auto v_ambiguous = Ops::set1(-scoring.ambiguous);
+  const auto v_three = Ops::set1(3);
+  const auto v_min = Ops::set1(L::MIN);
+  const auto any = end == End::ANY;
+  auto v_best = load(best_lanes.data());
+  auto v_all = v_min;
+  auto *q = reinterpret_cast<const __m256i *>(query.data());
+  auto *valid = reinterpret_cast<const __m256i *>(row_valid.data());
+  auto *h_left = reinterpret_cast<__m256i *>(h_col.data());
+  auto *e_left = reinterpret_cast<__m256i *>(e_col.data());
+  for (auto j = 0l; j < cols; j++) {
+    const auto r = load(ref.data() + j);
+    auto diag = Ops::set1(stored(top(start, scoring, j - 1)));
+    auto up = Ops::set1(stored(top(start, scoring, j)));
+    auto f = v_min;
+    auto col_max = v_min;
+    auto col_row = _mm256_setzero_si256();
+    for (auto i = 0l; i < rows; i++) {
+      const auto s = _mm256_blendv_epi8(
+          _mm256_blendv_epi8(v_mismatch, v_match, Ops::eq(q[i], r)),
+          v_ambiguous, Ops::gt(Ops::max(q[i], r), v_three));
+      const auto h_prev = h_left[i];
+      const auto e = Ops::max(Ops::subs(h_prev, v_oe),
+                              Ops::subs(e_left[i], v_ext));
+      f = Ops::max(Ops::subs(up, v_oe), Ops::subs(f, v_ext));
+      const auto h = Ops::max(Ops::adds(diag, s), Ops::max(e, f));
+      e_left[i] = e;
+      h_left[i] = h;
+      diag = h_prev;
+      up = h;
+      v_all = Ops::max(v_all, h);
+      if (any) {
+        const auto better = _mm256_and_si256(Ops::gt(h, col_max), valid[i]);
+        col_max = _mm256_blendv_epi8(col_max, h, better);
+        col_row = _mm256_blendv_epi8(col_row, Ops::set1(i), better);
+      }
+    }
+
+    if (any) {
+      // Columns come in order and rows within them, so a strictly better
+      // cell is the one with the smallest (j, i).
+      const auto better = _mm256_and_si256(Ops::gt(col_max, v_best),
+                                           load(col_valid.data() + j));
+      const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(better));
+      if (mask) {
+        auto maxima = std::array<T, LANES>{}, rows_of = maxima;
+        store(maxima.data(), col_max);
+        store(rows_of.data(), col_row);
+        for (auto k = 0; k < lanes; k++)
+          if (mask >> k * sizeof(T) & 1)
+            best[k] = {maxima[k], static_cast<U>(rows_of[k]), j};
+        v_best = _mm256_blendv_epi8(v_best, col_max, better);
+      }
+    } else
+      for (auto k = 0; k < lanes; k++)
+        if (j < m[k]) {
+          const auto h = lane(h_col, n[k] - 1, k);
+          if (end == End::LAST_ROW ? h > best[k].stored : j == m[k] - 1)
+            best[k] = {h, n[k] - 1, j};
+        }
+  }
+
+  auto results = std::array<KernelResult, LANES>{};
+  auto maxima = std::array<T, LANES>{};
+  store(maxima.data(), v_all);
+  for (auto k = 0; k < lanes; k++) {
+    const auto score = best[k].stored - bias;
+    results[k] = {static_cast<int>(score),
+                  static_cast<std::uint32_t>(best[k].i + 1),
+                  static_cast<std::uint32_t>(best[k].j + 1),
+                  !exact<Ops>({queries[k], refs[k], start, end, 0, 0}, scoring,
+                              maxima[k], score, bias)};
+  }
+  return results;
+}
+
+/**
+ * @brief Align the pairs of order with the batch kernel of Ops, LANES
+ * pairs of similar lengths at a time.
+ *
+ * @return The pairs which were not aligned, because they are empty, too
+ * long, or their scores overflowed.
+ */
+template <class Ops>
+inline auto align_batches(std::span<const istring_view> queries,
+                          std::span<const istring_view> refs, AlignMode mode,
+                          const AlignScoring &scoring,
+                          std::vector<std::size_t> order,
+                          std::vector<Alignment> &alignments) {
+  constexpr auto LANES = Ops::LANES;
+  constexpr auto MAX_ROWS = std::size_t{1}
+                               << 8 * sizeof(typename Ops::value_type);
+  auto left = std::vector<std::size_t>{};
+  std::erase_if(order, [&](auto k) {
+    const auto skip = queries[k].empty() || refs[k].empty() ||
+                      queries[k].size() > MAX_ROWS;
+    if (skip)
+      left.push_back(k);
+    return skip;
+  });
+
+  auto batches = std::vector<std::size_t>((order.size() + LANES - 1) / LANES);
+  std::iota(batches.begin(), batches.end(), 0);
+  auto solved = std::vector<char>(order.size());
+  const auto align = [&](std::size_t b) {
+    const auto first = b * LANES;
+    const auto size = std::min<std::size_t>(LANES, order.size() - first);
+    auto batch_queries = std::array<istring_view, LANES>{};
+    auto batch_refs = std::array<istring_view, LANES>{};
+    for (auto k = std::size_t{}; k < size; k++) {
+      batch_queries[k] = queries[order[first + k]];
+      batch_refs[k] = refs[order[first + k]];
+    }
+    const auto results = batch_avx2<Ops>(
+        {batch_queries.data(), size}, {batch_refs.data(), size},
+        start_of(mode), end_of(mode), scoring);
+    for (auto k = std::size_t{}; k < size; k++) {
+      if (results[k].overflow)
+        continue;
+      auto &alignment = alignments[order[first + k]];
+      alignment = {.score = results[k].score,
+                   .query_end = results[k].query_end,
+                   .ref_end = results[k].ref_end};
+      solved[first + k] = true;
+    }
+  };
+  std::for_each(std::execution::par, batches.begin(), batches.end(), align);
+  for (auto k = std::size_t{}; k < order.size(); k++)
+    if (!solved[k])
+      left.push_back(order[k]);
+  return left;
+}
+
+#endif
+
+} // namespace detail::align
+
+/**
+ * @ingroup align
+ * @brief Aligner of many short pairs at once, one pair per SIMD lane.
+ *
+ * A single short alignment keeps few lanes of a striped or anti-diagonal
+ * kernel busy, so the pairs are instead sorted by length and aligned 32
+ * (8-bit local scores) or 16 (16-bit scores) at a time, each in its own
+ * lane of the same unbanded dynamic programming. Batches run in parallel.
+ * Pairs whose scores overflow, and all pairs where AVX2 is not available,
+ * are aligned one by one with PairwiseAligner, whose results are also the
+ * results of this aligner.
+ *
+ * Example
+ * ```cpp
+ * auto aligner = biovoltron::BatchAligner{
+ *   .mode = biovoltron::AlignMode::LOCAL, .cigar = true
+ * };
+ * // reads: std::vector<FastqRecord<true>>, windows: std::vector<istring_view>
+ * auto alignments = aligner(reads, windows);
+ * ```
+ */
+struct BatchAligner {
+  AlignScoring scoring{};
+  AlignMode mode = AlignMode::GLOBAL;
+
+  /**
+   * @brief Whether to compute the begin positions and the CIGAR.
+   */
+  bool cigar = false;
+
+  /**
+   * @brief Align queries[k] against refs[k] for every k.
+   *
+   * @throws std::invalid_argument if the numbers of queries and references
+   * differ, or the scoring is invalid.
+   */
+  auto operator()(std::span<const istring_view> queries,
+                  std::span<const istring_view> refs) const {
+    if (queries.size() != refs.size())
+      throw std::invalid_argument("BatchAligner: numbers of pairs differ");
+    scoring.validate();
+    const auto single = PairwiseAligner{
+        .scoring = scoring, .mode = mode, .cigar = cigar};
+    auto alignments = std::vector<Alignment>(queries.size());
+    auto left = std::vector<std::size_t>(queries.size());
+    std::iota(left.begin(), left.end(), 0);
+
+#ifdef BIOVOLTRON_X86_DISPATCH
+    if (simd_level() != SimdLevel::SCALAR && !left.empty()) {
+      using namespace detail::align;
+      std::ranges::stable_sort(left, {}, [&](auto k) {
+        return std::pair{queries[k].size(), refs[k].size()};
+      });
+      if (mode == AlignMode::LOCAL && fits_int8(scoring))
+        left = align_batches<I8x32>(queries, refs, mode, scoring,
+                                    std::move(left), alignments);
+      left = align_batches<I16x16>(queries, refs, mode, scoring,
+                                   std::move(left), alignments);
+      if (cigar) {
+        auto traced = std::vector<char>(queries.size(), true);
+        for (const auto k : left)
+          traced[k] = false;
+        auto aligned = std::vector<std::size_t>{};
+        for (auto k = std::size_t{}; k < queries.size(); k++)
+          if (traced[k])
+            aligned.push_back(k);
+        const auto trace = [&](std::size_t k) {
+          const auto n = static_cast<long>(queries[k].size());
+          const auto m = static_cast<long>(refs[k].size());
+          trace_alignment(queries[k], refs[k], mode, scoring, 1 - n, m - 1,
+                          alignments[k]);
+        };
+        std::for_each(std::execution::par, aligned.begin(), aligned.end(),
+                      trace);
+      }
+    }
+#endif
+
+    const auto align = [&](std::size_t k) {
+      alignments[k] = single(queries[k], refs[k]);
+    };
+    std::for_each(std::execution::par, left.begin(), left.end(), align);
+    return alignments;
+  }
+
+  /**
+   * @brief Align the sequence of every read against the reference of the
+   * same index.
+   */
+  auto operator()(const std::vector<FastqRecord<true>> &reads,
+                  std::span<const istring_view> refs) const {
+    auto queries = std::vector<istring_view>{};
+    queries.reserve(reads.size());
+    for (const auto &read : reads)
+      queries.emplace_back(read.seq);
+    return (*this)(queries, refs);
+  }
+};
+
+} // namespace biovoltron
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <biovoltron/utility/istring.hpp>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup align
+ * @brief The parts of the two sequences an alignment has to cover.
+ */
+enum class AlignMode {
+  /// Both sequences end to end (Needleman-Wunsch).
+  GLOBAL,
+  /// The best scoring pair of substrings (Smith-Waterman).
+  LOCAL,
+  /// The whole query against a substring of the reference.
+  SEMI_GLOBAL,
+  /// Prefixes of both sequences, to extend a seed to the right.
+  EXTEND
+};
+
+/**
+ * @ingroup align
+ * @brief Affine gap scoring, a gap of length l costs gap_open + l *
+ * gap_extend.
+ *
+ * Penalties are given as non-negative numbers, the defaults are those of
+ * BWA-MEM.
+ */
+struct AlignScoring {
+  int match = 1;
+  int mismatch = 4;
+  int gap_open = 6;
+  int gap_extend = 1;
+  /// Penalty of aligning an N, or any code above 3, to any base.
+  int ambiguous = 1;
+
+  constexpr auto score(ichar a, ichar b) const noexcept {
+    if (a > 3 || b > 3)
+      return -ambiguous;
+    return a == b ? match : -mismatch;
+  }
+
+  /**
+   * @throws std::invalid_argument if a score is negative or above 1000, or
+   * gaps cost nothing.
+   */
+  auto validate() const {
+    for (const auto value : {match, mismatch, gap_open, gap_extend, ambiguous})
+      if (value < 0 || value > 1000)
+        throw std::invalid_argument("AlignScoring: score out of range");
+    if (gap_open + gap_extend == 0)
+      throw std::invalid_argument("AlignScoring: gaps have to cost");
+  }
+};
+
+/**
+ * @ingroup align
+ * @brief A pairwise alignment of query[query_begin, query_end) and
+ * ref[ref_begin, ref_end).
+ *
+ * The begin positions and the CIGAR (M, I and D operations, I consuming
+ * the query) are only computed when requested, otherwise they are 0 and
+ * empty.
+ */
+struct Alignment {
+  int score = 0;
+  std::uint32_t query_begin = 0;
+  std::uint32_t query_end = 0;
+  std::uint32_t ref_begin = 0;
+  std::uint32_t ref_end = 0;
+  std::string cigar{};
+
+  auto operator==(const Alignment &) const -> bool = default;
+};
+
+namespace detail::align {
+
+/**
+ * @brief Values of the cells before the first row and column.
+ */
+enum class Start {
+  /// Gaps before the first base of either sequence are penalized.
+  ANCHORED,
+  /// The alignment may start at any reference position.
+  FREE_REF,
+  /// The alignment may start anywhere, scores are clamped at 0.
+  LOCAL
+};
+
+/**
+ * @brief Cells the alignment may end in.
+ */
+enum class End { CORNER, LAST_ROW, ANY };
+
+/**
+ * @brief One dynamic programming problem, cells (i, j) with i indexing the
+ * query and dlo <= j - i <= dhi are computed.
+ */
+struct Problem {
+  istring_view query;
+  istring_view ref;
+  Start start;
+  End end;
+  long dlo;
+  long dhi;
+
+  auto n() const noexcept { return static_cast<long>(query.size()); }
+  auto m() const noexcept { return static_cast<long>(ref.size()); }
+
+  auto full() const noexcept { return dlo <= 1 - n() && dhi >= m() - 1; }
+};
+
+/**
+ * @brief Score of the best cell and its exclusive end positions, overflow
+ * is set by kernels whose score type was too narrow.
+ */
+struct KernelResult {
+  int score = 0;
+  std::uint32_t query_end = 0;
+  std::uint32_t ref_end = 0;
+  bool overflow = false;
+};
+
+constexpr auto start_of(AlignMode mode) noexcept {
+  switch (mode) {
+  case AlignMode::LOCAL:
+    return Start::LOCAL;
+  case AlignMode::SEMI_GLOBAL:
+    return Start::FREE_REF;
+  default:
+    return Start::ANCHORED;
+  }
+}
+
+constexpr auto end_of(AlignMode mode) noexcept {
+  switch (mode) {
+  case AlignMode::GLOBAL:
+    return End::CORNER;
+  case AlignMode::SEMI_GLOBAL:
+    return End::LAST_ROW;
+  default:
+    return End::ANY;
+  }
+}
+
+/**
+ * @brief H(-1, j) for j >= -1.
+ */
+constexpr auto top(Start start, const AlignScoring &scoring, long j) noexcept {
+  if (start != Start::ANCHORED || j < 0)
+    return 0l;
+  return -(scoring.gap_open + scoring.gap_extend * (j + 1));
+}
+
+/**
+ * @brief H(i, -1) for i >= 0.
+ */
+constexpr auto left(Start start, const AlignScoring &scoring, long i) noexcept {
+  if (start == Start::LOCAL)
+    return 0l;
+  return -(scoring.gap_open + scoring.gap_extend * (i + 1));
+}
+
+/**
+ * @brief Whether a cell ending an alignment beats the best one so far: a
+ * higher score, or the same score with a smaller (j, i).
+ */
+constexpr auto better(long score, long i, long j, long best, long best_i,
+                      long best_j) noexcept {
+  if (score != best)
+    return score > best;
+  return j < best_j || (j == best_j && i < best_i);
+}
+
+/**
+ * @brief The best cell before any cell is computed, the empty alignment or
+ * the whole query inserted at the start of the reference.
+ */
+constexpr auto initial_best(const Problem &p,
+                            const AlignScoring &scoring) noexcept {
+  struct {
+    long score, i, j;
+  } best{0, -1, -1};
+  if (p.end == End::LAST_ROW)
+    best = {left(p.start, scoring, p.n() - 1), p.n() - 1, -1};
+  else if (p.end == End::CORNER)
+    best = {std::numeric_limits<long>::min(), -1, -1};
+  return best;
+}
+
+/**
+ * @brief Traceback directions of the cells of a band, by row or by
+ * anti-diagonal.
+ *
+ * Bits 0-1 of a direction tell where H comes from (0 diagonal, 1 E, 2 F),
+ * bit 2 and 3 whether E and F extend a gap rather than open one.
+ */
+struct Trace {
+  std::vector<std::uint8_t> dirs;
+  std::vector<std::size_t> offsets;
+  std::vector<long> firsts;
+  bool antidiagonal = false;
+
+  auto clear(bool by_antidiagonal) {
+    dirs.clear();
+    offsets.clear();
+    firsts.clear();
+    antidiagonal = by_antidiagonal;
+  }
+
+  auto at(long i, long j) const noexcept {
+    const auto key = antidiagonal ? i + j : i;
+    const auto pos = antidiagonal ? i : j;
+    return dirs[offsets[key] + (pos - firsts[key])];
+  }
+};
+
+/**
+ * @brief CIGAR of alignment operations listed from the last to the first.
+ */
+inline auto run_lengths(std::string_view reversed_ops) {
+  auto cigar = std::string{};
+  for (auto end = reversed_ops.rbegin(); end != reversed_ops.rend();) {
+    const auto run = std::find_if(end, reversed_ops.rend(),
+                                  [op = *end](auto c) { return c != op; });
+    cigar += std::to_string(run - end);
+    cigar += *end;
+    end = run;
+  }
+  return cigar;
+}
+
+/**
+ * @brief CIGAR of the alignment ending at (i, j) of an anchored problem.
+ */
+inline auto traceback(const Trace &trace, long i, long j) {
+  auto ops = std::string{};
+  auto state = 0;
+  while (i >= 0 && j >= 0) {
+    const auto dir = trace.at(i, j);
+    if (state == 0)
+      state = dir & 3;
+    if (state == 0) {
+      ops += 'M';
+      i--;
+      j--;
+    } else if (state == 1) {
+      ops += 'D';
+      state = dir & 4 ? 1 : 0;
+      j--;
+    } else {
+      ops += 'I';
+      state = dir & 8 ? 2 : 0;
+      i--;
+    }
+  }
+  ops.append(i + 1, 'I');
+  ops.append(j + 1, 'D');
+  return run_lengths(ops);
+}
+
+/**
+ * @brief Gotoh's algorithm with 32-bit scores, one row at a time.
+ *
+ * The reference every vectorized kernel has to agree with, and the fallback
+ * when their scores overflow or AVX2 is unavailable.
+ */
+inline auto align_scalar(const Problem &p, const AlignScoring &scoring,
+                         Trace *trace = nullptr) {
+  constexpr auto NEG = std::numeric_limits<int>::min() / 2;
+  const auto n = p.n(), m = p.m();
+  const auto oe = scoring.gap_open + scoring.gap_extend;
+  const auto ext = scoring.gap_extend;
+  const auto local = p.start == Start::LOCAL;
+
+  // Rows i - 1 and i of H and F, indexed by j + 1.
+  auto h = std::vector<long>(m + 1), hn = std::vector<long>(m + 1, NEG);
+  auto f = std::vector<long>(m + 1, NEG), fn = std::vector<long>(m + 1, NEG);
+  for (auto j = -1l; j < m; j++)
+    h[j + 1] = top(p.start, scoring, j);
+  if (trace)
+    trace->clear(false);
+
+  auto best = initial_best(p, scoring);
+  for (auto i = 0l; i < n; i++) {
+    const auto jlo = std::max(0l, i + p.dlo), jhi = std::min(m - 1, i + p.dhi);
+    if (jlo <= m)
+      hn[jlo] = jlo == 0 ? left(p.start, scoring, i) : NEG;
+    if (trace) {
+      trace->offsets.push_back(trace->dirs.size());
+      trace->firsts.push_back(jlo);
+    }
+    auto e = long{NEG};
+    for (auto j = jlo; j <= jhi; j++) {
+      const auto diag = h[j] + scoring.score(p.query[i], p.ref[j]);
+      const auto e_open = hn[j] - oe, e_ext = e - ext;
+      const auto f_open = h[j + 1] - oe, f_ext = f[j + 1] - ext;
+      e = std::max(e_open, e_ext);
+      const auto fv = std::max(f_open, f_ext);
+      auto hv = std::max({diag, e, fv});
+      if (local)
+        hv = std::max(hv, 0l);
+      hn[j + 1] = hv;
+      fn[j + 1] = fv;
+      if (trace)
+        trace->dirs.push_back((hv == diag ? 0 : hv == e ? 1 : 2) |
+                              (e_ext > e_open) << 2 | (f_ext > f_open) << 3);
+      if (p.end == End::ANY ||
+          (i == n - 1 && (p.end == End::LAST_ROW || j == m - 1)))
+        if (better(hv, i, j, best.score, best.i, best.j))
+          best = {hv, i, j};
+    }
+    if (jhi + 2 >= 1 && jhi + 2 <= m) {
+      hn[jhi + 2] = NEG;
+      fn[jhi + 2] = NEG;
+    }
+    std::swap(h, hn);
+    std::swap(f, fn);
+  }
+  return KernelResult{static_cast<int>(best.score),
+                      static_cast<std::uint32_t>(best.i + 1),
+                      static_cast<std::uint32_t>(best.j + 1)};
+}
+
+} // namespace detail::align
+
+} // namespace biovoltron
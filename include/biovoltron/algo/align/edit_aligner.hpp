@@ -0,0 +1,321 @@
+#pragma once
+
+#include <biovoltron/algo/align/core/alignment.hpp>
+#include <bit>
+
+namespace biovoltron {
+
+/**
+ * @ingroup align
+ * @brief The part of the text an edit distance alignment has to cover, the
+ * pattern is always aligned whole.
+ */
+enum class EditMode {
+  /// The whole text (Needleman-Wunsch).
+  GLOBAL,
+  /// A prefix of the text, e.g. to match a barcode at the start of a read.
+  PREFIX,
+  /// Any substring of the text, e.g. to find an adapter in a read.
+  INFIX
+};
+
+/**
+ * @ingroup align
+ * @brief An alignment of the pattern to text[text_begin, text_end) with the
+ * least edits.
+ *
+ * text_begin and the CIGAR (M, I and D operations, I consuming the
+ * pattern) are only computed when requested.
+ */
+struct EditAlignment {
+  /// The edit distance, -1 if it is above the maximum.
+  int distance = -1;
+  std::uint32_t text_begin = 0;
+  std::uint32_t text_end = 0;
+  std::string cigar;
+
+  auto operator==(const EditAlignment &) const -> bool = default;
+};
+
+namespace detail::edit {
+
+constexpr auto WORD = 64;
+
+/**
+ * @brief 64 rows of a column of the edit distance matrix, as bit vectors
+ * of the rows that are one above (pv) or one below (mv) the row before,
+ * and the value of the last row.
+ */
+struct Block {
+  std::uint64_t pv = ~std::uint64_t{};
+  std::uint64_t mv = 0;
+  long score = 0;
+
+  /**
+   * @brief Advance the block by one column (Myers, as blocks by Hyyro).
+   *
+   * @param eq Rows whose pattern base equals the text base.
+   * @param hin Difference of the row above the block to the column before.
+   * @return The same difference of the last row.
+   */
+  constexpr auto advance(std::uint64_t eq, int hin) noexcept {
+    const auto hin_neg = static_cast<std::uint64_t>(hin < 0);
+    const auto xv = eq | mv;
+    eq |= hin_neg;
+    const auto xh = (((eq & pv) + pv) ^ pv) | eq;
+    auto ph = mv | ~(xh | pv);
+    auto mh = pv & xh;
+    const auto hout =
+        static_cast<int>(ph >> (WORD - 1)) - static_cast<int>(mh >> (WORD - 1));
+    ph = ph << 1 | static_cast<std::uint64_t>(hin > 0);
+    mh = mh << 1 | hin_neg;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+    score += hout;
+    return hout;
+  }
+
+  /**
+   * @brief Value of row r < 64 of the block.
+   */
+  constexpr auto value(int r) const noexcept {
+    const auto below = r == WORD - 1 ? 0 : ~std::uint64_t{} << (r + 1);
+    return score - std::popcount(pv & below) + std::popcount(mv & below);
+  }
+};
+
+/**
+ * @brief The blocks computed in every column, for traceback.
+ */
+struct Columns {
+  std::vector<Block> blocks;
+  std::vector<std::size_t> offsets;
+  std::vector<long> firsts;
+  std::vector<long> lasts;
+
+  auto clear() {
+    blocks.clear();
+    offsets.clear();
+    firsts.clear();
+    lasts.clear();
+  }
+
+  /**
+   * @brief D(i, j) of a global problem for i, j >= 0, or a value above any
+   * distance if not computed.
+   */
+  auto at(long i, long j) const noexcept {
+    if (i == 0 || j == 0)
+      return i + j;
+    const auto b = (i - 1) / WORD;
+    if (b < firsts[j - 1] || b > lasts[j - 1])
+      return std::numeric_limits<long>::max() / 2;
+    return blocks[offsets[j - 1] + b - firsts[j - 1]].value((i - 1) % WORD);
+  }
+};
+
+struct Result {
+  long distance = -1;
+  long end = 0;
+};
+
+/**
+ * @brief Smallest edit distance up to k of the pattern and the smallest
+ * text end, both non-empty.
+ *
+ * Only blocks that may hold values up to k are computed (Ukkonen's
+ * cut-off), starting with ceil((k + 1) / 64) of them. Rows of the values
+ * up to k start at most one block below the last block of the previous
+ * column, and values never decrease along an optimal path, so they are
+ * exact although the blocks around them are not.
+ */
+inline auto search(istring_view pattern, istring_view text, EditMode mode,
+                   long k, Columns *columns = nullptr) {
+  const auto m = static_cast<long>(pattern.size());
+  const auto n = static_cast<long>(text.size());
+  const auto blocks = (m + WORD - 1) / WORD;
+  thread_local auto peq = std::vector<std::uint64_t>{};
+  peq.assign(5 * blocks, 0);
+  for (auto i = 0l; i < m; i++) {
+    const auto row = std::min<int>(pattern[i], 4) * blocks + i / WORD;
+    peq[row] |= std::uint64_t{1} << i % WORD;
+  }
+  thread_local auto column = std::vector<Block>{};
+  column.resize(blocks);
+  if (columns)
+    columns->clear();
+
+  auto best = Result{};
+  if (mode != EditMode::GLOBAL && m <= k) {
+    best = {m, 0};
+    k = m - 1;
+  }
+  const auto infix = mode == EditMode::INFIX;
+  auto first = 0l;
+  auto last = std::min((k + WORD) / WORD, blocks) - 1;
+  for (auto b = 0l; b <= last; b++)
+    column[b] = {.score = (b + 1) * WORD};
+  for (auto j = 0l; j < n && k >= 0 && first <= last; j++) {
+    const auto *eq = peq.data() + std::min<int>(text[j], 4) * blocks;
+    // Rows above the first block are above k and grow by one.
+    auto hout = infix && first == 0 ? 0 : 1;
+    for (auto b = first; b <= last; b++)
+      hout = column[b].advance(eq[b], hout);
+
+    if (last + 1 < blocks && column[last].score - hout <= k) {
+      const auto above = column[last].score - hout;
+      column[++last] = {.score = above + WORD};
+      column[last].advance(eq[last], hout);
+    } else
+      while (last >= first && (last > 0 || !infix) &&
+             column[last].score >= k + WORD)
+        last--;
+    if (!infix)
+      while (first <= last && column[first].score >= k + WORD)
+        first++;
+
+    if (columns) {
+      columns->offsets.push_back(columns->blocks.size());
+      columns->firsts.push_back(first);
+      columns->lasts.push_back(last);
+      columns->blocks.insert(columns->blocks.end(), column.begin() + first,
+                             column.begin() + last + 1);
+    }
+    if (last != blocks - 1 || (mode == EditMode::GLOBAL && j != n - 1))
+      continue;
+    if (const auto d = column[last].value((m - 1) % WORD); d <= k) {
+      best = {d, j + 1};
+      if (!columns)
+        k = d - 1;
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief CIGAR of the global alignment of a search with columns.
+ */
+inline auto traceback(const Columns &columns, istring_view pattern,
+                      istring_view text) {
+  auto i = static_cast<long>(pattern.size());
+  auto j = static_cast<long>(text.size());
+  auto ops = std::string{};
+  while (i > 0 && j > 0) {
+    const auto d = columns.at(i, j);
+    if (columns.at(i - 1, j - 1) + (pattern[i - 1] != text[j - 1]) == d) {
+      ops += 'M';
+      i--;
+      j--;
+    } else if (columns.at(i - 1, j) + 1 == d) {
+      ops += 'I';
+      i--;
+    } else {
+      ops += 'D';
+      j--;
+    }
+  }
+  ops.append(i, 'I');
+  ops.append(j, 'D');
+  return detail::align::run_lengths(ops);
+}
+
+} // namespace detail::edit
+
+/**
+ * @ingroup align
+ * @brief Edit distance alignment with Myers' bit-parallel algorithm.
+ *
+ * A column of the dynamic programming matrix is kept as bit vectors of the
+ * differences between adjacent rows, so one text base updates 64 pattern
+ * bases in a few word operations. Longer patterns are split into blocks of
+ * 64 rows and only the blocks that may hold distances up to max_distance
+ * are computed. Without a maximum, the search is repeated with maxima 64,
+ * 128, ... until it succeeds.
+ *
+ * Bases compare by their codes, so an N only matches an N. Of several best
+ * alignments the one with the smallest text end wins, and for infixes the
+ * one with the largest begin then.
+ *
+ * Example
+ * ```cpp
+ * auto aligner = biovoltron::EditAligner{
+ *   .mode = biovoltron::EditMode::INFIX, .max_distance = 2, .cigar = true
+ * };
+ * auto alignment = aligner(Codec::to_istring("AGATCGGAAG"), read.seq);
+ * if (alignment.distance >= 0)
+ *   read.seq.resize(alignment.text_begin);
+ * ```
+ */
+struct EditAligner {
+  EditMode mode = EditMode::GLOBAL;
+
+  /**
+   * @brief Largest edit distance of interest, smaller ones are faster.
+   */
+  std::size_t max_distance = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * @brief Whether to compute text_begin and the CIGAR.
+   */
+  bool cigar = false;
+
+  auto operator()(istring_view pattern, istring_view text) const {
+    using namespace detail::edit;
+    const auto m = static_cast<long>(pattern.size());
+    const auto n = static_cast<long>(text.size());
+    const auto bound = mode == EditMode::GLOBAL ? std::max(m, n) : m;
+    const auto k_max = static_cast<long>(
+        std::min<std::size_t>(max_distance, bound));
+
+    auto alignment = EditAlignment{};
+    if (m == 0 || n == 0) {
+      const auto d = mode == EditMode::GLOBAL ? m + n : m;
+      if (d <= k_max) {
+        alignment.distance = d;
+        alignment.text_end = mode == EditMode::GLOBAL ? n : 0;
+        if (cigar && d != 0)
+          alignment.cigar = std::to_string(d) + (m != 0 ? 'I' : 'D');
+      }
+      return alignment;
+    }
+    if (mode == EditMode::GLOBAL && std::abs(m - n) > k_max)
+      return alignment;
+
+    auto result = Result{};
+    for (auto k = std::min(k_max, long{WORD}); result.distance < 0; k *= 2) {
+      result = search(pattern, text, mode, std::min(k, k_max));
+      if (k >= k_max)
+        break;
+    }
+    if (result.distance < 0)
+      return alignment;
+    alignment.distance = result.distance;
+    alignment.text_end = result.end;
+    if (!cigar)
+      return alignment;
+
+    // The infix ends at text_end, its begin is the end of the shortest
+    // prefix of the reversed text before it that the reversed pattern
+    // matches as well.
+    auto begin = 0l;
+    if (mode == EditMode::INFIX && result.end != 0) {
+      const auto rpattern = istring(pattern.rbegin(), pattern.rend());
+      const auto rtext = istring(text.rend() - result.end, text.rend());
+      begin = result.end - search(rpattern, rtext, EditMode::PREFIX,
+                                  result.distance)
+                               .end;
+    }
+    alignment.text_begin = begin;
+    const auto part = text.substr(begin, result.end - begin);
+    if (part.empty()) {
+      alignment.cigar = std::to_string(m) + 'I';
+      return alignment;
+    }
+    auto columns = Columns{};
+    search(pattern, part, EditMode::GLOBAL, result.distance, &columns);
+    alignment.cigar = traceback(columns, pattern, part);
+    return alignment;
+  }
+};
+
+} // namespace biovoltron
@@ -0,0 +1,603 @@
+#pragma once
+
+#include <biovoltron/algo/align/core/alignment.hpp>
+#include <biovoltron/utility/simd.hpp>
+#include <bit>
+
+namespace biovoltron {
+
+namespace detail::align {
+
+#ifdef BIOVOLTRON_X86_DISPATCH
+
+/**
+ * @brief 32 signed 8-bit scores of an AVX2 register.
+ */
+struct I8x32 {
+  using value_type = std::int8_t;
+  constexpr static auto LANES = 32;
+
+  [[gnu::target("avx2"), gnu::always_inline]] static auto set1(int x) {
+    return _mm256_set1_epi8(static_cast<char>(x));
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto adds(__m256i a,
+                                                               __m256i b) {
+    return _mm256_adds_epi8(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto subs(__m256i a,
+                                                               __m256i b) {
+    return _mm256_subs_epi8(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto max(__m256i a,
+                                                              __m256i b) {
+    return _mm256_max_epi8(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto gt(__m256i a,
+                                                             __m256i b) {
+    return _mm256_cmpgt_epi8(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto eq(__m256i a,
+                                                             __m256i b) {
+    return _mm256_cmpeq_epi8(a, b);
+  }
+  /**
+   * @brief Move every lane one up, lane 0 becomes x.
+   */
+  [[gnu::target("avx2"), gnu::always_inline]] static auto shift_in(__m256i v,
+                                                                    int x) {
+    const auto carry = _mm256_permute2x128_si256(v, set1(x), 0x02);
+    return _mm256_alignr_epi8(v, carry, 15);
+  }
+};
+
+/**
+ * @brief 16 signed 16-bit scores of an AVX2 register.
+ */
+struct I16x16 {
+  using value_type = std::int16_t;
+  constexpr static auto LANES = 16;
+
+  [[gnu::target("avx2"), gnu::always_inline]] static auto set1(int x) {
+    return _mm256_set1_epi16(static_cast<short>(x));
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto adds(__m256i a,
+                                                               __m256i b) {
+    return _mm256_adds_epi16(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto subs(__m256i a,
+                                                               __m256i b) {
+    return _mm256_subs_epi16(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto max(__m256i a,
+                                                              __m256i b) {
+    return _mm256_max_epi16(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto gt(__m256i a,
+                                                             __m256i b) {
+    return _mm256_cmpgt_epi16(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto eq(__m256i a,
+                                                             __m256i b) {
+    return _mm256_cmpeq_epi16(a, b);
+  }
+  [[gnu::target("avx2"), gnu::always_inline]] static auto shift_in(__m256i v,
+                                                                    int x) {
+    const auto carry = _mm256_permute2x128_si256(v, set1(x), 0x02);
+    return _mm256_alignr_epi8(v, carry, 14);
+  }
+};
+
+[[gnu::target("avx2"), gnu::always_inline]] inline auto load(const void *p) {
+  return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+}
+
+[[gnu::target("avx2"), gnu::always_inline]] inline auto store(void *p,
+                                                              __m256i v) {
+  _mm256_storeu_si256(static_cast<__m256i *>(p), v);
+}
+
+/**
+ * @brief 16 bases widened to 16 bits.
+ */
+[[gnu::target("avx2"), gnu::always_inline]] inline auto
+load_bases(const ichar *p) {
+  return _mm256_cvtepi8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+
+/**
+ * @brief 32 bytes, the storage of one register in a std::vector.
+ */
+struct alignas(32) Block {
+  std::array<std::int8_t, 32> bytes;
+};
+
+template <class Ops> struct Limits {
+  using T = typename Ops::value_type;
+  constexpr static int MIN = std::numeric_limits<T>::min();
+  constexpr static int MAX = std::numeric_limits<T>::max();
+
+  constexpr static auto saturate(long x) noexcept {
+    return static_cast<int>(std::clamp<long>(x, MIN, MAX));
+  }
+};
+
+/**
+ * @brief Whether no real score of a kernel with Ops was saturated.
+ *
+ * The largest score is below MAX - match. Cells which saturated at MIN only
+ * lie on paths which score at most MIN + match * min(n, m), so a result
+ * above that is exact.
+ */
+template <class Ops>
+constexpr auto exact(const Problem &p, const AlignScoring &scoring, int max,
+                     long score, int bias) noexcept {
+  using L = Limits<Ops>;
+  const auto gain = static_cast<long>(scoring.match) * std::min(p.n(), p.m());
+  return max < L::MAX - scoring.match &&
+         (bias != 0 || score > L::MIN + gain + scoring.gap_open +
+                                   scoring.gap_extend + scoring.mismatch);
+}
+
+/**
+ * @brief Farrar's striped algorithm over whole columns of the matrix.
+ *
+ * Query position i is lane i / segments of segment i % segments, so the
+ * dependencies within a column only cross lanes in the lazy F loop. Local
+ * scores are stored with a bias of MIN, so saturation clamps them at 0.
+ */
+template <class Ops>
+[[gnu::target("avx2")]] inline auto striped_avx2(const Problem &p,
+                                                 const AlignScoring &scoring) {
+  using L = Limits<Ops>;
+  using T = typename Ops::value_type;
+  constexpr auto LANES = Ops::LANES;
+  const auto n = p.n(), m = p.m();
+  const auto segs = (n + LANES - 1) / LANES;
+  const auto bias = p.start == Start::LOCAL ? L::MIN : 0;
+  const auto stored = [&](long x) { return L::saturate(x + bias); };
+
+  thread_local auto buffers = std::array<std::vector<Block>, 4>{};
+  auto &[profile, h_load, h_store, e_store] = buffers;
+  profile.resize(5 * segs);
+  h_load.resize(segs);
+  h_store.resize(segs);
+  e_store.resize(segs);
+  const auto lane = [](std::vector<Block> &v, long i, long segs) -> T & {
+    return reinterpret_cast<T *>(v.data() + i % segs)[i / segs];
+  };
+  for (auto c = 0; c < 5; c++)
+    for (auto i = 0l; i < segs * LANES; i++)
+      reinterpret_cast<T *>(profile.data() + c * segs + i % segs)[i / segs] =
+          i < n ? scoring.score(p.query[i], c) : L::MIN;
+  const auto oe = scoring.gap_open + scoring.gap_extend;
+  for (auto i = 0l; i < segs * LANES; i++) {
+    const auto h = i < n ? left(p.start, scoring, i) : L::MIN - bias;
+    lane(h_load, i, segs) = stored(h);
+    lane(e_store, i, segs) = stored(h - oe);
+  }
+
+  const auto v_oe = Ops::set1(oe);
+  const auto v_ext = Ops::set1(scoring.gap_extend);
+  const auto v_min = Ops::set1(L::MIN);
+  auto v_all = v_min;
+  auto best = initial_best(p, scoring);
+  auto best_stored = static_cast<long>(stored(best.score));
+  auto *e = reinterpret_cast<__m256i *>(e_store.data());
+  for (auto j = 0l; j < m; j++) {
+    const auto *h_in = reinterpret_cast<const __m256i *>(h_load.data());
+    auto *h_out = reinterpret_cast<__m256i *>(h_store.data());
+    const auto *prof = reinterpret_cast<const __m256i *>(
+        profile.data() + std::min<int>(p.ref[j], 4) * segs);
+    auto v_f = v_min;
+    auto v_max = v_min;
+    auto v_h =
+        Ops::shift_in(h_in[segs - 1], stored(top(p.start, scoring, j - 1)));
+    for (auto s = 0l; s < segs; s++) {
+      v_h = Ops::adds(v_h, prof[s]);
+      const auto v_e = e[s];
+      v_h = Ops::max(v_h, Ops::max(v_e, v_f));
+      h_out[s] = v_h;
+      v_max = Ops::max(v_max, v_h);
+      const auto v_open = Ops::subs(v_h, v_oe);
+      e[s] = Ops::max(Ops::subs(v_e, v_ext), v_open);
+      v_f = Ops::max(Ops::subs(v_f, v_ext), v_open);
+      v_h = h_in[s];
+    }
+
+    // Lazy F loop: carry F from the last segment of each lane into the
+    // next lane until it cannot raise any H. Comparing with the H before
+    // the update keeps this exact even without a gap open penalty.
+    v_f = Ops::shift_in(v_f, stored(top(p.start, scoring, j) - oe));
+    for (auto k = 0; k < LANES; k++) {
+      auto s = 0l;
+      for (; s < segs; s++) {
+        const auto v_old = h_out[s];
+        const auto v_new = Ops::max(v_old, v_f);
+        h_out[s] = v_new;
+        v_max = Ops::max(v_max, v_new);
+        e[s] = Ops::max(e[s], Ops::subs(v_new, v_oe));
+        v_f = Ops::subs(v_f, v_ext);
+        if (!_mm256_movemask_epi8(Ops::gt(v_f, Ops::subs(v_old, v_oe))))
+          break;
+      }
+      if (s < segs)
+        break;
+      v_f = Ops::shift_in(v_f, L::MIN);
+    }
+    v_all = Ops::max(v_all, v_max);
+
+    if (p.end == End::ANY &&
+        _mm256_movemask_epi8(Ops::gt(v_max, Ops::set1(best_stored)))) {
+      // The first row holding the new maximum of the column, padding rows
+      // are always below it.
+      auto lanes = std::array<T, LANES>{};
+      store(lanes.data(), v_max);
+      best_stored = *std::ranges::max_element(lanes);
+      auto first = segs * LANES;
+      for (auto s = 0l; s < segs; s++) {
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            Ops::eq(h_out[s], Ops::set1(best_stored))));
+        if (mask) {
+          const auto k = std::countr_zero(mask) / static_cast<int>(sizeof(T));
+          first = std::min(first, k * segs + s);
+        }
+      }
+      best = {best_stored - bias, first, j};
+    } else if (p.end == End::LAST_ROW || j == m - 1) {
+      const auto h = lane(h_store, n - 1, segs);
+      if (h > best_stored || p.end == End::CORNER) {
+        best_stored = h;
+        best = {h - bias, n - 1, j};
+      }
+    }
+    std::swap(h_load, h_store);
+  }
+
+  auto lanes = std::array<T, LANES>{};
+  store(lanes.data(), v_all);
+  return KernelResult{
+      static_cast<int>(best.score), static_cast<std::uint32_t>(best.i + 1),
+      static_cast<std::uint32_t>(best.j + 1),
+      !exact<Ops>(p, scoring, *std::ranges::max_element(lanes), best.score,
+                  bias)};
+}
+
+/**
+ * @brief floor(x / 2) for negative x as well.
+ */
+constexpr auto half_floor(long x) noexcept {
+  return x >= 0 ? x / 2 : -((1 - x) / 2);
+}
+
+/**
+ * @brief The anti-diagonal algorithm with 16-bit scores, for bands and
+ * traceback.
+ *
+ * Cells (i, d - i) of anti-diagonal d only depend on anti-diagonals d - 1
+ * and d - 2, so they are computed 16 rows at a time. Rows are stored at
+ * i + 1 to keep H(-1, j) in front, and the reference is reversed so that
+ * the bases of an anti-diagonal are consecutive.
+ */
+[[gnu::target("avx2")]] inline auto banded_avx2(const Problem &p,
+                                                const AlignScoring &scoring,
+                                                Trace *trace = nullptr) {
+  using Ops = I16x16;
+  using L = Limits<Ops>;
+  constexpr auto LANES = Ops::LANES;
+  const auto n = p.n(), m = p.m();
+  const auto bias = p.start == Start::LOCAL ? L::MIN : 0;
+  const auto stored = [&](long x) {
+    return static_cast<std::int16_t>(L::saturate(x + bias));
+  };
+  const auto rows = [&](long d) {
+    return std::pair{std::max({0l, d - m + 1, -half_floor(p.dhi - d)}),
+                     std::min({n - 1, d, half_floor(d - p.dlo)})};
+  };
+
+  thread_local auto seqs = std::array<std::vector<ichar>, 2>{};
+  auto &[query, ref] = seqs;
+  query.assign(p.query.begin(), p.query.end());
+  query.resize(n + LANES, 4);
+  ref.assign(p.ref.rbegin(), p.ref.rend());
+  ref.resize(m + LANES, 4);
+  thread_local auto buffers = std::array<std::vector<std::int16_t>, 7>{};
+  for (auto &buffer : buffers)
+    buffer.assign(n + 2 + LANES, L::MIN);
+  auto *h2 = buffers[0].data(), *h1 = buffers[1].data();
+  auto *h0 = buffers[2].data();
+  auto *e1 = buffers[3].data(), *e0 = buffers[4].data();
+  auto *f1 = buffers[5].data(), *f0 = buffers[6].data();
+
+  // H(-1, d + 1) and H(d + 1, -1) follow anti-diagonal d.
+  const auto boundaries = [&](std::int16_t *h, std::int16_t *e,
+                              std::int16_t *f, long d) {
+    h[0] = stored(top(p.start, scoring, d + 1));
+    e[0] = f[0] = L::MIN;
+    if (d + 1 >= 0 && d + 1 < n) {
+      h[d + 2] = d + 1 + p.dlo <= 0 ? stored(left(p.start, scoring, d + 1))
+                                    : L::MIN;
+      e[d + 2] = f[d + 2] = L::MIN;
+    }
+  };
+  boundaries(h2, e0, f0, -2);
+  boundaries(h1, e1, f1, -1);
+  if (trace) {
+    trace->clear(true);
+    auto size = std::size_t{};
+    for (auto d = 0l; d <= n + m - 2; d++) {
+      const auto [ilo, ihi] = rows(d);
+      trace->offsets.push_back(size);
+      trace->firsts.push_back(ilo);
+      size += std::max(0l, ihi - ilo + 1);
+    }
+    trace->dirs.resize(size + LANES);
+  }
+
+  const auto v_oe = Ops::set1(scoring.gap_open + scoring.gap_extend);
+  const auto v_ext = Ops::set1(scoring.gap_extend);
+  const auto v_match = Ops::set1(scoring.match);
+  const auto v_mismatch = Ops::set1(-scoring.mismatch);
+  const auto v_ambiguous = Ops::set1(-scoring.ambiguous);
+  const auto v_min = Ops::set1(L::MIN);
+  const auto v_lane = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+                                        12, 13, 14, 15);
+  auto v_all = v_min;
+  auto best = initial_best(p, scoring);
+  auto best_stored = static_cast<long>(stored(best.score));
+  for (auto d = 0l; d <= n + m - 2; d++) {
+    const auto [ilo, ihi] = rows(d);
+    for (auto i = ilo; i <= ihi; i += LANES) {
+      const auto q = load_bases(query.data() + i);
+      const auto r = load_bases(ref.data() + m - 1 - d + i);
+      const auto s = _mm256_blendv_epi8(
+          _mm256_blendv_epi8(v_mismatch, v_match, _mm256_cmpeq_epi16(q, r)),
+          v_ambiguous, Ops::gt(Ops::max(q, r), Ops::set1(3)));
+      const auto e_open = Ops::subs(load(h1 + i + 1), v_oe);
+      const auto e_ext = Ops::subs(load(e1 + i + 1), v_ext);
+      const auto f_open = Ops::subs(load(h1 + i), v_oe);
+      const auto f_ext = Ops::subs(load(f1 + i), v_ext);
+      const auto e = Ops::max(e_open, e_ext);
+      const auto f = Ops::max(f_open, f_ext);
+      const auto diag = Ops::adds(load(h2 + i), s);
+      const auto h = Ops::max(diag, Ops::max(e, f));
+      store(h0 + i + 1, h);
+      store(e0 + i + 1, e);
+      store(f0 + i + 1, f);
+      const auto valid = _mm256_cmpgt_epi16(
+          Ops::set1(std::min<long>(ihi - i + 1, LANES)), v_lane);
+      const auto v_h = _mm256_blendv_epi8(v_min, h, valid);
+      v_all = Ops::max(v_all, v_h);
+
+      if (trace) {
+        auto dir = _mm256_andnot_si256(
+            _mm256_cmpeq_epi16(h, diag),
+            _mm256_blendv_epi8(Ops::set1(2), Ops::set1(1),
+                               _mm256_cmpeq_epi16(h, e)));
+        dir = _mm256_or_si256(
+            dir, _mm256_and_si256(Ops::gt(e_ext, e_open), Ops::set1(4)));
+        dir = _mm256_or_si256(
+            dir, _mm256_and_si256(Ops::gt(f_ext, f_open), Ops::set1(8)));
+        dir = _mm256_permute4x64_epi64(_mm256_packus_epi16(dir, dir), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(
+                             trace->dirs.data() + trace->offsets[d] + i - ilo),
+                         _mm256_castsi256_si128(dir));
+      }
+
+      // Ties go to the smallest (j, i), which is not the order of the cells.
+      const auto threshold = best.i < 0 ? best_stored : best_stored - 1;
+      if (p.end == End::ANY &&
+          _mm256_movemask_epi8(Ops::gt(v_h, Ops::set1(threshold))))
+        for (auto k = i; k <= std::min(ihi, i + LANES - 1); k++)
+          if (better(h0[k + 1], k, d - k, best_stored, best.i, best.j)) {
+            best_stored = h0[k + 1];
+            best = {best_stored - bias, k, d - k};
+          }
+    }
+
+    if (ilo <= n - 1 && n - 1 <= ihi &&
+        (p.end == End::LAST_ROW ? h0[n] > best_stored
+                                : p.end == End::CORNER && d == n + m - 2)) {
+      best_stored = h0[n];
+      best = {best_stored - bias, n - 1, d - n + 1};
+    }
+    if (ilo <= n + 1)
+      h0[ilo] = e0[ilo] = f0[ilo] = L::MIN;
+    if (ihi + 2 >= 0 && ihi + 2 <= n + 1)
+      h0[ihi + 2] = e0[ihi + 2] = f0[ihi + 2] = L::MIN;
+    boundaries(h0, e0, f0, d);
+    std::swap(h2, h1);
+    std::swap(h1, h0);
+    std::swap(e0, e1);
+    std::swap(f0, f1);
+  }
+
+  auto lanes = std::array<std::int16_t, LANES>{};
+  store(lanes.data(), v_all);
+  return KernelResult{
+      static_cast<int>(best.score), static_cast<std::uint32_t>(best.i + 1),
+      static_cast<std::uint32_t>(best.j + 1),
+      !exact<Ops>(p, scoring, *std::ranges::max_element(lanes), best.score,
+                  bias)};
+}
+
+#endif
+
+/**
+ * @brief Whether the scores of one cell fit into 8 bits.
+ */
+constexpr auto fits_int8(const AlignScoring &scoring) noexcept {
+  return std::max({scoring.match, scoring.mismatch, scoring.ambiguous,
+                   scoring.gap_open + scoring.gap_extend}) < 64;
+}
+
+/**
+ * @brief Solve a problem with the fastest kernel, falling back to wider
+ * scores when narrower ones overflow.
+ */
+inline auto kernel(const Problem &p, const AlignScoring &scoring,
+                   Trace *trace = nullptr) {
+#ifdef BIOVOLTRON_X86_DISPATCH
+  if (simd_level() != SimdLevel::SCALAR) {
+    auto result = KernelResult{.overflow = true};
+    if (p.full() && !trace) {
+      if (p.start == Start::LOCAL && fits_int8(scoring))
+        result = striped_avx2<I8x32>(p, scoring);
+      if (result.overflow)
+        result = striped_avx2<I16x16>(p, scoring);
+    } else
+      result = banded_avx2(p, scoring, trace);
+    if (!result.overflow)
+      return result;
+  }
+#endif
+  return align_scalar(p, scoring, trace);
+}
+
+/**
+ * @brief Fill in the begins and the CIGAR of an alignment whose score and
+ * ends were found in the band dlo <= j - i <= dhi.
+ *
+ * Local and semi-global alignments find their begins by aligning the
+ * reversed sequences from the ends, then the aligned parts are aligned
+ * globally in the narrowest band their score allows, recording directions.
+ */
+inline auto trace_alignment(istring_view query, istring_view ref,
+                            AlignMode mode, const AlignScoring &scoring,
+                            long dlo, long dhi, Alignment &alignment) {
+  const auto qe = static_cast<long>(alignment.query_end);
+  const auto re = static_cast<long>(alignment.ref_end);
+  auto qb = 0l, rb = 0l;
+  if ((mode == AlignMode::LOCAL && alignment.score > 0) ||
+      (mode == AlignMode::SEMI_GLOBAL && re != 0)) {
+    // The reversed sequences aligned from the ends, cell (i, j) of the
+    // problem is cell (qe - 1 - i, re - 1 - j) of the original one.
+    const auto local = mode == AlignMode::LOCAL;
+    const auto rquery = istring(query.rend() - qe, query.rend());
+    const auto rref = istring(ref.rend() - re, ref.rend());
+    const auto begin =
+        kernel({rquery, rref, Start::ANCHORED,
+                local ? End::ANY : End::LAST_ROW,
+                std::max(re - qe - dhi, 1 - qe),
+                std::min(re - qe - dlo, re - 1)},
+               scoring);
+    qb = qe - begin.query_end;
+    rb = re - begin.ref_end;
+  }
+  alignment.query_begin = qb;
+  alignment.ref_begin = rb;
+
+  const auto n = qe - qb, m = re - rb;
+  if (n == 0 || m == 0) {
+    alignment.cigar = n + m == 0 ? ""
+                                 : std::to_string(n + m) + (n ? 'I' : 'D');
+    return;
+  }
+  // A cell d diagonals off the main one costs a gap of at least d.
+  auto g = n + m;
+  if (scoring.gap_extend != 0)
+    g = std::max(0l, (scoring.match * std::min(n, m) - alignment.score -
+                      scoring.gap_open) /
+                         scoring.gap_extend);
+  const auto off = rb - qb;
+  const auto lo = std::max({-g, dlo - off, 1 - n});
+  const auto hi = std::min({g, dhi - off, m - 1});
+  auto trace = Trace{};
+  kernel({query.substr(qb, n), ref.substr(rb, m), Start::ANCHORED,
+          End::CORNER, std::min(lo, m - n), std::max(hi, m - n)},
+         scoring, &trace);
+  alignment.cigar = traceback(trace, n - 1, m - 1);
+}
+
+} // namespace detail::align
+
+/**
+ * @ingroup align
+ * @brief Affine gap alignment of two encoded sequences.
+ *
+ * Without a band the matrix is computed column by column with Farrar's
+ * striped algorithm, in 8-bit scores for local alignments and 16-bit
+ * scores otherwise; a band is computed by anti-diagonals. A kernel whose
+ * scores overflow is rerun with wider ones, and the scalar kernel is used
+ * where AVX2 is not, so the result never depends on the CPU. Of several
+ * best cells, the one with the smallest reference and then query end wins.
+ *
+ * The begins and the CIGAR are found in a second pass, which aligns the
+ * reversed sequences from the ends and traces back in a band only as wide
+ * as the score allows.
+ *
+ * Example
+ * ```cpp
+ * auto aligner = biovoltron::PairwiseAligner{
+ *   .mode = biovoltron::AlignMode::LOCAL, .cigar = true
+ * };
+ * auto alignment = aligner(Codec::to_istring("ACGTTA"),
+ *                          Codec::to_istring("GGACGTA"));
+ * // alignment.cigar == "4M"
+ * ```
+ */
+struct PairwiseAligner {
+  AlignScoring scoring{};
+  AlignMode mode = AlignMode::GLOBAL;
+
+  /**
+   * @brief Largest |j - i| of an aligned pair (i, j), widened to reach the
+   * last cell in global mode.
+   */
+  std::size_t band = std::numeric_limits<std::size_t>::max();
+
+  /**
+   * @brief Whether to compute the begin positions and the CIGAR.
+   */
+  bool cigar = false;
+
+  /**
+   * @throws std::invalid_argument if the scoring is invalid.
+   */
+  auto operator()(istring_view query, istring_view ref) const {
+    using namespace detail::align;
+    scoring.validate();
+    const auto n = static_cast<long>(query.size());
+    const auto m = static_cast<long>(ref.size());
+    if (n == 0 || m == 0)
+      return empty(n, m);
+
+    const auto w = static_cast<long>(std::min<std::size_t>(band, n + m));
+    auto dlo = std::max(-w, 1 - n), dhi = std::min(w, m - 1);
+    if (mode == AlignMode::GLOBAL) {
+      dlo = std::min(dlo, m - n);
+      dhi = std::max(dhi, m - n);
+    }
+    const auto best = kernel(
+        {query, ref, start_of(mode), end_of(mode), dlo, dhi}, scoring);
+    auto alignment = Alignment{.score = best.score,
+                               .query_end = best.query_end,
+                               .ref_end = best.ref_end};
+    if (cigar)
+      trace_alignment(query, ref, mode, scoring, dlo, dhi, alignment);
+    return alignment;
+  }
+
+ private:
+  auto gap(long size) const noexcept {
+    return size == 0 ? 0
+                     : -static_cast<int>(scoring.gap_open +
+                                         scoring.gap_extend * size);
+  }
+
+  auto empty(long n, long m) const -> Alignment {
+    auto alignment = Alignment{};
+    if (mode == AlignMode::GLOBAL ||
+        (mode == AlignMode::SEMI_GLOBAL && m == 0)) {
+      alignment.score = gap(n + m);
+      alignment.query_end = n;
+      alignment.ref_end = mode == AlignMode::GLOBAL ? m : 0;
+      if (cigar && n + m != 0)
+        alignment.cigar = std::to_string(n + alignment.ref_end) +
+                          (n != 0 ? 'I' : 'D');
+    }
+    return alignment;
+  }
+};
+
+} // namespace biovoltron
@@ -10,4 +10,10 @@
  * and more.
  */
 
+#include <biovoltron/algo/align/all.hpp>
+#include <biovoltron/algo/index/all.hpp>
+#include <biovoltron/algo/qc/all.hpp>
+#include <biovoltron/algo/sketch/all.hpp>
+#include <biovoltron/algo/sort/all.hpp>
 #include <biovoltron/algo/suffix_sorter/all.hpp>
+#include <biovoltron/algo/trimmer/all.hpp>
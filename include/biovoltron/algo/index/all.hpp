@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * @defgroup index index
+ * @ingroup algo
+ * @brief The "index" module finds patterns in indexed references.
+ *
+ * A suffix array, sorted by any SuffixSorter, finds every occurrence of a
+ * pattern in time logarithmic in the reference length. Occurrences with
+ * mismatches or edits are found by backtracking over it, which is how
+ * short reads with sequencing errors are placed on a reference.
+ */
+
+#include <biovoltron/algo/index/suffix_array_index.hpp>
@@ -0,0 +1,558 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <biovoltron/algo/suffix_sorter/stable_sorter.hpp>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup index
+ * @brief The suffix array entries [begin, end) of the suffixes starting
+ * with a string.
+ */
+struct SaInterval {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+
+  auto size() const noexcept { return end - begin; }
+  auto empty() const noexcept { return begin == end; }
+
+  auto operator==(const SaInterval &) const -> bool = default;
+};
+
+/**
+ * @ingroup index
+ * @brief The differences counted by an approximate search.
+ */
+enum class SearchMetric {
+  /// Substitutions only, matches are as long as the pattern.
+  HAMMING,
+  /// Substitutions, insertions and deletions (Levenshtein).
+  EDIT
+};
+
+/**
+ * @ingroup index
+ * @brief An occurrence of a pattern in the reference with at most k
+ * differences.
+ */
+struct ApproximateMatch {
+  /// Start of the match in the reference.
+  std::size_t position;
+  /// The least number of differences of a match starting there.
+  std::uint32_t distance;
+  /// Length of the shortest such match in the reference.
+  std::uint32_t length;
+
+  auto operator<=>(const ApproximateMatch &) const = default;
+};
+
+namespace detail::sa_index {
+
+/**
+ * @brief Symbols of suffixes: 0 past the end of the reference, then the
+ * base codes with N last.
+ */
+constexpr auto SYMBOLS = 6;
+
+/**
+ * @brief Deepest prefix table, 6^9 entries.
+ */
+constexpr auto MAX_TABLE_DEPTH = std::size_t{9};
+
+/**
+ * @brief The suffixes starting with a string of depth bases, and the key of
+ * that string in the prefix table while it is not deeper than the table.
+ */
+struct Node {
+  SaInterval interval;
+  std::size_t depth = 0;
+  std::size_t key = 0;
+};
+
+constexpr auto code(ichar c) noexcept { return std::min<int>(c, 4); }
+
+/**
+ * @brief Sort matches by position and keep the best match of every
+ * position.
+ */
+inline auto keep_best(std::vector<ApproximateMatch> &matches) {
+  std::ranges::sort(matches);
+  const auto same_position = [](const auto &a, const auto &b) {
+    return a.position == b.position;
+  };
+  matches.erase(std::unique(matches.begin(), matches.end(), same_position),
+                matches.end());
+}
+
+} // namespace detail::sa_index
+
+/**
+ * @ingroup index
+ * @brief Exact and approximate pattern search on the suffix array of a
+ * reference.
+ *
+ * The suffix array is built by any SuffixSorter. Patterns are matched base
+ * by base, every base narrowing the interval of suffixes that start with
+ * the pattern so far by binary search. The first levels touch the whole
+ * suffix array and miss the cache the most, so the intervals of all
+ * strings up to a few bases long are looked up in a table of the prefixes
+ * of the suffixes instead.
+ *
+ * Approximate search backtracks over the suffix array, trying every base
+ * where the reference may differ from the pattern. Before searching, the
+ * pattern is split greedily into pieces that do not occur in the
+ * reference. Every piece needs a difference of its own, so a branch is cut
+ * as soon as its differences plus the pieces left exceed k. Under the edit
+ * metric, every branch carries a column of the edit distances of the
+ * pattern prefixes to the reference string of the branch, banded to k.
+ *
+ * Branching at the first bases, where intervals are large, costs the most.
+ * A pattern with k differences split into k + 1 parts has a part without
+ * any (the pigeonhole principle), so every part in turn is matched
+ * exactly, the rest of the pattern after it by backtracking from there,
+ * and the bases before it are aligned directly against the reference.
+ * Patterns too short for parts that mostly occur once are searched whole.
+ *
+ * Bases compare by their codes, so an N only matches an N. A k-ordered
+ * SuffixSorter only orders suffixes by their first sort_len bases, so it
+ * supports patterns up to sort_len bases, less k under the edit metric.
+ *
+ * Example
+ * ```cpp
+ * #include <biovoltron/algo/index/suffix_array_index.hpp>
+ *
+ * auto index = biovoltron::SuffixArrayIndex{genome[0].seq};
+ * for (auto match : index.search(read.seq, 2))
+ *   std::cout << match.position << " " << match.distance << "\n";
+ * ```
+ */
+template <SuffixSorter Sorter = StableSorter<>> class SuffixArrayIndex {
+public:
+  using size_type = typename Sorter::size_type;
+
+private:
+  using Node = detail::sa_index::Node;
+
+  istring ref_;
+  std::vector<size_type> sa_;
+  std::size_t table_depth_ = 0;
+  std::array<std::size_t, detail::sa_index::MAX_TABLE_DEPTH + 1> powers_{};
+  // table_[key] is the number of suffixes whose first table_depth_ symbols
+  // have a smaller key.
+  std::vector<size_type> table_;
+
+  auto symbol(size_type suffix, std::size_t depth) const noexcept {
+    const auto i = suffix + depth;
+    return i >= ref_.size() ? 0 : detail::sa_index::code(ref_[i]) + 1;
+  }
+
+  auto build_table() {
+    using namespace detail::sa_index;
+    powers_[0] = 1;
+    for (auto d = std::size_t{1}; d < powers_.size(); d++)
+      powers_[d] = powers_[d - 1] * SYMBOLS;
+    const auto max_depth = std::min(MAX_TABLE_DEPTH, Sorter::sort_len);
+    while (table_depth_ < max_depth &&
+           powers_[table_depth_ + 1] <= sa_.size())
+      table_depth_++;
+
+    table_.assign(powers_[table_depth_] + 1, 0);
+    for (const auto suffix : sa_) {
+      auto key = std::size_t{};
+      for (auto d = std::size_t{}; d < table_depth_; d++)
+        key = key * SYMBOLS + symbol(suffix, d);
+      table_[key + 1]++;
+    }
+    std::partial_sum(table_.begin(), table_.end(), table_.begin());
+  }
+
+  auto root() const noexcept { return Node{{0, sa_.size()}}; }
+
+  /**
+   * @brief The suffixes of node followed by a base.
+   */
+  auto child(const Node &node, int code) const noexcept {
+    const auto s = code + 1;
+    if (node.depth < table_depth_) {
+      const auto width = powers_[table_depth_ - node.depth - 1];
+      const auto key = node.key + s * width;
+      return Node{{table_[key], table_[key + width]}, node.depth + 1, key};
+    }
+    const auto first = sa_.begin() + node.interval.begin;
+    const auto last = sa_.begin() + node.interval.end;
+    const auto below = [&](auto suffix) {
+      return symbol(suffix, node.depth) < s;
+    };
+    const auto at_most = [&](auto suffix) {
+      return symbol(suffix, node.depth) <= s;
+    };
+    const auto lo = std::partition_point(first, last, below);
+    const auto hi = std::partition_point(lo, last, at_most);
+    return Node{{static_cast<std::size_t>(lo - sa_.begin()),
+                 static_cast<std::size_t>(hi - sa_.begin())},
+                node.depth + 1};
+  }
+
+  /**
+   * @brief The suffixes of node followed by every base, splitting the
+   * interval once instead of narrowing it for every base.
+   */
+  auto children(const Node &node) const noexcept {
+    auto nodes = std::array<Node, 5>{};
+    if (node.depth < table_depth_) {
+      for (auto c = 0; c < 5; c++)
+        nodes[c] = child(node, c);
+      return nodes;
+    }
+    const auto first = sa_.begin() + node.interval.begin;
+    const auto last = sa_.begin() + node.interval.end;
+    // Only one suffix can end at this depth, and it sorts first.
+    auto lo = first + (first != last && symbol(*first, node.depth) == 0);
+    for (auto c = 0; c < 5; c++) {
+      const auto at_most = [&](auto suffix) {
+        return symbol(suffix, node.depth) <= c + 1;
+      };
+      const auto hi = std::partition_point(lo, last, at_most);
+      nodes[c] = Node{{static_cast<std::size_t>(lo - sa_.begin()),
+                       static_cast<std::size_t>(hi - sa_.begin())},
+                      node.depth + 1};
+      lo = hi;
+    }
+    return nodes;
+  }
+
+  /**
+   * @brief For every position of the pattern, a lower bound of the
+   * differences of the rest of it to any part of the reference.
+   *
+   * The pattern is cut once, from the left, into pieces ending at the
+   * first base where the piece no longer occurs in the reference, so the
+   * bound of a position is the number of pieces after it (as the D array
+   * of BWA).
+   */
+  auto lower_bounds(istring_view pattern) const {
+    const auto m = pattern.size();
+    auto bounds = std::vector<int>(m + 1);
+    auto node = root();
+    for (auto i = std::size_t{}, start = std::size_t{}; i < m; i++) {
+      node = child(node, detail::sa_index::code(pattern[i]));
+      if (node.interval.empty()) {
+        bounds[start]++;
+        start = i + 1;
+        node = root();
+      }
+    }
+    for (auto s = m; s-- > 0;)
+      bounds[s] += bounds[s + 1];
+    return bounds;
+  }
+
+  auto report(const Node &node, std::uint32_t distance,
+              std::vector<ApproximateMatch> &matches) const -> void {
+    for (auto i = node.interval.begin; i < node.interval.end; i++)
+      matches.push_back({sa_[i], distance,
+                         static_cast<std::uint32_t>(node.depth)});
+  }
+
+  /**
+   * @brief Backtracking with at most k mismatches, none in the first exact
+   * bases.
+   */
+  auto search_hamming(const Node &node, istring_view pattern,
+                      const std::vector<int> &bounds, std::size_t exact,
+                      int errors, int k,
+                      std::vector<ApproximateMatch> &matches) const -> void {
+    if (errors + bounds[node.depth] > k)
+      return;
+    if (node.depth == pattern.size()) {
+      report(node, errors, matches);
+      return;
+    }
+    const auto base = detail::sa_index::code(pattern[node.depth]);
+    if (errors == k || node.depth < exact) {
+      if (const auto next = child(node, base); !next.interval.empty())
+        search_hamming(next, pattern, bounds, exact, errors, k, matches);
+      return;
+    }
+    const auto nodes = children(node);
+    for (auto c = 0; c < 5; c++)
+      if (!nodes[c].interval.empty())
+        search_hamming(nodes[c], pattern, bounds, exact, errors + (c != base),
+                       k, matches);
+  }
+
+  /**
+   * @brief Backtracking with at most k edits, none in the first exact
+   * bases.
+   *
+   * columns[t][i] is the edit distance of the first i bases of the pattern
+   * to the t bases of the current branch, or k + 1 if above k or more than
+   * k rows off the diagonal.
+   */
+  auto search_edit(const Node &node, istring_view pattern,
+                   const std::vector<int> &bounds, std::size_t exact, int k,
+                   int reported, std::vector<std::vector<int>> &columns,
+                   std::vector<ApproximateMatch> &matches) const -> void {
+    const auto m = static_cast<int>(pattern.size());
+    const auto t = static_cast<int>(node.depth);
+    if (t == m + k)
+      return;
+    const auto &column = columns[t];
+    auto &next_column = columns[t + 1];
+    const auto lo = std::max(0, t + 1 - k);
+    const auto hi = std::min(m, t + 1 + k);
+    auto nodes = std::array<Node, 5>{};
+    if (node.depth < exact) {
+      const auto base = detail::sa_index::code(pattern[node.depth]);
+      nodes[base] = child(node, base);
+    } else
+      nodes = children(node);
+    for (auto c = 0; c < 5; c++) {
+      const auto &next = nodes[c];
+      if (next.interval.empty())
+        continue;
+      auto least = k + 1;
+      for (auto i = lo; i <= hi; i++) {
+        auto d = i == 0 ? t + 1 : column[i] + 1;
+        if (i > 0) {
+          const auto base = detail::sa_index::code(pattern[i - 1]);
+          d = std::min(
+              {d, column[i - 1] + (base != c), next_column[i - 1] + 1});
+        }
+        next_column[i] = std::min(d, k + 1);
+        least = std::min(least, next_column[i] + bounds[i]);
+      }
+      if (least > k)
+        continue;
+      auto best = reported;
+      if (next_column[m] < reported) {
+        best = next_column[m];
+        report(next, best, matches);
+      }
+      search_edit(next, pattern, bounds, exact, k, best, columns, matches);
+    }
+  }
+
+  /**
+   * @brief Matches of the pattern, with the first exact bases matching
+   * exactly.
+   */
+  auto search_right(istring_view pattern, std::size_t exact, int k,
+                    SearchMetric metric) const {
+    auto matches = std::vector<ApproximateMatch>{};
+    const auto bounds = lower_bounds(pattern);
+    if (metric == SearchMetric::HAMMING) {
+      search_hamming(root(), pattern, bounds, exact, 0, k, matches);
+      return matches;
+    }
+    const auto m = pattern.size();
+    thread_local auto columns = std::vector<std::vector<int>>{};
+    columns.resize(std::max(columns.size(), m + k + 1));
+    for (auto t = std::size_t{}; t <= m + k; t++)
+      columns[t].assign(m + 1, k + 1);
+    for (auto i = 0; i <= std::min<int>(k, m); i++)
+      columns[0][i] = i;
+    search_edit(root(), pattern, bounds, exact, k, k + 1, columns, matches);
+    detail::sa_index::keep_best(matches);
+    return matches;
+  }
+
+  /**
+   * @brief Extend matches of the rest of a pattern to matches of the whole
+   * pattern with at most k differences, by aligning the bases left of the
+   * rest to the reference before every match.
+   */
+  auto extend_left(istring_view left,
+                   const std::vector<ApproximateMatch> &rights, int k,
+                   SearchMetric metric,
+                   std::vector<ApproximateMatch> &matches) const {
+    const auto a = static_cast<int>(left.size());
+    thread_local auto column = std::vector<int>{};
+    thread_local auto next_column = std::vector<int>{};
+    for (const auto &right : rights) {
+      const auto budget = k - static_cast<int>(right.distance);
+      const auto q = right.position;
+      if (metric == SearchMetric::HAMMING) {
+        if (q < left.size())
+          continue;
+        auto errors = 0;
+        for (auto i = 0; i < a && errors <= budget; i++)
+          errors += left[i] != ref_[q - a + i];
+        if (errors <= budget)
+          matches.push_back(
+              {q - a, right.distance + errors, right.length + a});
+        continue;
+      }
+
+      // column[i] is the edit distance of the last i bases of left to the
+      // last l bases before q.
+      column.assign(a + 1, budget + 1);
+      next_column.assign(a + 1, budget + 1);
+      for (auto i = 0; i <= std::min(a, budget); i++)
+        column[i] = i;
+      const auto emit = [&](int l) {
+        if (column[a] <= budget)
+          matches.push_back({q - l, right.distance + column[a],
+                             right.length + l});
+      };
+      emit(0);
+      const auto max_l = static_cast<int>(
+          std::min<std::size_t>(q, a + budget));
+      for (auto l = 1; l <= max_l; l++) {
+        const auto c = detail::sa_index::code(ref_[q - l]);
+        const auto lo = std::max(0, l - budget);
+        const auto hi = std::min(a, l + budget);
+        if (lo > 0)
+          next_column[lo - 1] = budget + 1;
+        auto least = budget + 1;
+        for (auto i = lo; i <= hi; i++) {
+          auto d = i == 0 ? l : column[i] + 1;
+          if (i > 0) {
+            const auto base = detail::sa_index::code(left[a - i]);
+            d = std::min(
+                {d, column[i - 1] + (base != c), next_column[i - 1] + 1});
+          }
+          next_column[i] = std::min(d, budget + 1);
+          least = std::min(least, next_column[i]);
+        }
+        std::swap(column, next_column);
+        if (least > budget)
+          break;
+        if (hi == a)
+          emit(l);
+      }
+    }
+  }
+
+public:
+  /**
+   * @brief Sort the suffixes of a reference.
+   * @throws std::length_error if the reference has size_type::max() bases
+   * or more.
+   */
+  explicit SuffixArrayIndex(istring ref) : ref_(std::move(ref)) {
+    if (ref_.size() >= std::numeric_limits<size_type>::max())
+      throw std::length_error("SuffixArrayIndex: reference too long");
+    sa_ = Sorter::get_sa(ref_);
+    build_table();
+  }
+
+  /**
+   * @brief The indexed reference.
+   */
+  auto reference() const noexcept -> istring_view { return ref_; }
+
+  /**
+   * @brief The suffix array, with the empty suffix first.
+   */
+  auto suffix_array() const noexcept -> std::span<const size_type> {
+    return sa_;
+  }
+
+  /**
+   * @brief The suffixes starting with the pattern.
+   * @throws std::invalid_argument if the pattern is longer than sort_len.
+   */
+  auto find(istring_view pattern) const {
+    if (pattern.size() > Sorter::sort_len)
+      throw std::invalid_argument("SuffixArrayIndex: pattern too long");
+    auto node = root();
+    for (auto i = std::size_t{}; i < pattern.size() && !node.interval.empty();
+         i++)
+      node = child(node, detail::sa_index::code(pattern[i]));
+    return node.interval;
+  }
+
+  /**
+   * @brief The reference positions of the suffixes of an interval, in
+   * suffix order.
+   */
+  auto locate(SaInterval interval) const {
+    return std::vector<size_type>(sa_.begin() + interval.begin,
+                                  sa_.begin() + interval.end);
+  }
+
+  /**
+   * @brief All reference positions where the pattern matches with at most
+   * k differences, in order of position.
+   *
+   * Under the edit metric, the pattern is aligned whole to a reference
+   * string starting at the position, with the least distance and then the
+   * shortest length. An empty pattern matches nowhere, and a k not less
+   * than the pattern length everywhere.
+   *
+   * @throws std::invalid_argument if the pattern (plus k under the edit
+   * metric) is longer than sort_len.
+   */
+  auto search(istring_view pattern, std::size_t k,
+              SearchMetric metric = SearchMetric::HAMMING) const {
+    const auto m = pattern.size();
+    k = std::min(k, m);
+    const auto depth = metric == SearchMetric::EDIT ? m + k : m;
+    if (depth > Sorter::sort_len)
+      throw std::invalid_argument("SuffixArrayIndex: pattern too long");
+
+    auto matches = std::vector<ApproximateMatch>{};
+    if (m == 0)
+      return matches;
+    // Pieces shorter than log4 of the reference length occur too often to
+    // narrow the search.
+    const auto min_piece =
+        std::max<std::size_t>(std::bit_width(sa_.size()) / 2, 1);
+    const auto pieces = k > 0 && m / (k + 1) >= min_piece ? k + 1 : 1;
+    const auto errors = static_cast<int>(k);
+    for (auto j = std::size_t{}; j < pieces; j++) {
+      const auto begin = j * m / pieces;
+      const auto end = (j + 1) * m / pieces;
+      const auto exact = pieces == 1 ? 0 : end - begin;
+      const auto rights =
+          search_right(pattern.substr(begin), exact, errors, metric);
+      if (begin == 0)
+        matches.insert(matches.end(), rights.begin(), rights.end());
+      else
+        extend_left(pattern.substr(0, begin), rights, errors, metric,
+                    matches);
+    }
+    detail::sa_index::keep_best(matches);
+    return matches;
+  }
+
+  /**
+   * @brief search() of many patterns in parallel.
+   *
+   * Patterns are searched in lexicographic order, so the patterns a thread
+   * searches one after another share prefixes and revisit the parts of the
+   * suffix array and of the reference already in its cache.
+   */
+  auto search(std::span<const istring_view> patterns, std::size_t k,
+              SearchMetric metric = SearchMetric::HAMMING) const {
+    constexpr auto CHUNK = std::size_t{64};
+    auto order = std::vector<std::size_t>(patterns.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, {}, [&](auto i) { return patterns[i]; });
+
+    auto matches = std::vector<std::vector<ApproximateMatch>>(patterns.size());
+    auto chunks = std::vector<std::size_t>{};
+    for (auto begin = std::size_t{}; begin < order.size(); begin += CHUNK)
+      chunks.push_back(begin);
+    const auto search_chunk = [&](auto begin) {
+      const auto end = std::min(begin + CHUNK, order.size());
+      for (auto i = begin; i < end; i++)
+        matches[order[i]] = search(patterns[order[i]], k, metric);
+    };
+    std::for_each(std::execution::par, chunks.begin(), chunks.end(),
+                  search_chunk);
+    return matches;
+  }
+};
+
+} // namespace biovoltron
@@ -0,0 +1,15 @@
+#pragma once
+
+/**
+ * @defgroup qc qc
+ * @ingroup algo
+ * @brief The "qc" module collects quality control statistics of sequencing
+ *        reads.
+ *
+ * The statistics are accumulated in a single pass while the reads are
+ * ingested, so quality control does not require a separate read of the
+ * data. Batches of reads are processed in parallel and the per-thread
+ * statistics are merged at the end.
+ */
+
+#include <biovoltron/algo/qc/fastq_stats.hpp>
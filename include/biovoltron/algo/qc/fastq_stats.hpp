@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <biovoltron/file_io/fastq_batch.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <biovoltron/utility/simd.hpp>
+#include <cstdint>
+#include <numeric>
+#include <queue>
+#include <ranges>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup qc
+ * @brief Single-pass FASTQ quality control statistics.
+ *
+ * FastqStats accumulates FastQC-like statistics of reads as they are
+ * ingested, so no separate pass over the data is needed:
+ * - per-position quality distributions and mean qualities,
+ * - per-position base composition (A, C, G, T and N),
+ * - the distribution of per-read GC content,
+ * - the read length distribution,
+ * - an estimate of the duplication rate.
+ *
+ * Batches are processed in parallel with OpenMP, every thread accumulates
+ * into its own FastqStats which are merged at the end of the batch. A
+ * read is encoded once with the SIMD kernels of utility/simd.hpp, and the
+ * per-position base counts are kept as one array per base, so counting a
+ * read is a compare-and-add of codes over all positions for each base,
+ * which the compiler vectorizes.
+ *
+ * The duplication rate follows FastQC: the first `DUP_PREFIX` bases of each
+ * read are hashed and only reads with a tracked prefix contribute to the
+ * estimate. Instead of the first `DUP_TRACK_LIMIT` distinct prefixes, the
+ * ones with the smallest hashes are tracked, so the estimate does not
+ * depend on the order of the reads or on how batches are split among
+ * threads.
+ *
+ * Example
+ * ```cpp
+ * auto fq = std::ifstream{"reads.fq"};
+ * auto stats = biovoltron::FastqStats{};
+ * for (auto batch = biovoltron::FastqBatch<>{}; fq >> batch;) {
+ *   stats.add(batch);
+ *   // ... the batch is further processed here ...
+ * }
+ * std::cout << stats.gc_content() << "\n";
+ * ```
+ */
+struct FastqStats {
+  /**
+   * @brief Number of distinct Phred+33 quality values ('!' to '~').
+   */
+  constexpr static auto QUAL_LEVELS = std::size_t{94};
+
+  /**
+   * @brief Number of leading bases used to detect duplicated reads.
+   */
+  constexpr static auto DUP_PREFIX = std::size_t{50};
+
+  /**
+   * @brief Maximum number of distinct read prefixes tracked, those with the
+   * smallest hashes.
+   */
+  constexpr static auto DUP_TRACK_LIMIT = std::size_t{100000};
+
+  /**
+   * @brief Number of reads.
+   */
+  std::uint64_t reads{};
+
+  /**
+   * @brief Number of bases.
+   */
+  std::uint64_t bases{};
+
+  /**
+   * @brief base_counts[b][i] is the number of base b (0(A), 1(C), 2(G),
+   * 3(T), 4(N)) at position i.
+   */
+  std::array<std::vector<std::uint64_t>, 5> base_counts;
+
+  /**
+   * @brief qual_counts[i * QUAL_LEVELS + q] is the number of quality q at
+   * position i.
+   */
+  std::vector<std::uint64_t> qual_counts;
+
+  /**
+   * @brief qual_sums[i] is the sum of qualities at position i.
+   */
+  std::vector<std::uint64_t> qual_sums;
+
+  /**
+   * @brief length_counts[l] is the number of reads of length l.
+   */
+  std::vector<std::uint64_t> length_counts;
+
+  /**
+   * @brief gc_counts[p] is the number of reads with a GC content of p
+   * percent, N bases excluded.
+   */
+  std::array<std::uint64_t, 101> gc_counts{};
+
+  /**
+   * @brief Occurrences of every tracked read prefix, keyed by its hash.
+   */
+  std::unordered_map<std::uint64_t, std::uint64_t> prefix_counts;
+
+  /**
+   * @brief Add a single read.
+   * @param read A FastqRecord or a FastqView.
+   */
+  template <class Read> auto add(const Read &read) {
+    using char_type = std::ranges::range_value_t<decltype(read.seq)>;
+    const auto seq = std::basic_string_view<char_type>{read.seq};
+    const auto qual = std::string_view{read.qual};
+    const auto size = seq.size();
+    reserve(size);
+
+    reads++;
+    bases += size;
+    length_counts[size]++;
+
+    const auto *codes = encode(seq);
+    auto totals = std::array<std::uint64_t, 5>{};
+    for (auto b = std::int8_t{}; b < 5; b++) {
+      auto *counts = base_counts[b].data();
+      auto total = std::uint64_t{};
+      for (auto i = std::size_t{}; i < size; i++) {
+        const auto is_b = static_cast<std::uint64_t>(codes[i] == b);
+        counts[i] += is_b;
+        total += is_b;
+      }
+      totals[b] = total;
+    }
+    if (const auto acgt = size - totals[4]; acgt != 0)
+      gc_counts[(totals[1] + totals[2]) * 100 / acgt]++;
+
+    for (auto i = std::size_t{}; i < qual.size() && i < size; i++) {
+      const auto q = std::min<std::size_t>(
+          static_cast<std::uint8_t>(qual[i] - '!'), QUAL_LEVELS - 1);
+      qual_counts[i * QUAL_LEVELS + q]++;
+      qual_sums[i] += q;
+    }
+
+    const auto prefix = seq.substr(0, DUP_PREFIX);
+    const auto key = std::hash<std::string_view>{}(
+        {reinterpret_cast<const char *>(prefix.data()), prefix.size()});
+    track(key, 1);
+  }
+
+  /**
+   * @brief Add all reads of a batch in parallel.
+   */
+  template <bool Encoded> auto add(const FastqBatch<Encoded> &batch) {
+    const auto n = static_cast<std::int64_t>(batch.size());
+#pragma omp parallel
+    {
+      auto local = FastqStats{};
+#pragma omp for schedule(static) nowait
+      for (auto i = std::int64_t{}; i < n; i++)
+        local.add(batch[i]);
+#pragma omp critical
+      merge(local);
+    }
+  }
+
+  /**
+   * @brief Length of the longest read.
+   */
+  auto max_length() const noexcept {
+    return length_counts.empty() ? std::size_t{} : length_counts.size() - 1;
+  }
+
+  /**
+   * @brief Number of reads covering position i.
+   */
+  auto coverage(std::size_t i) const {
+    auto n = std::uint64_t{};
+    for (auto b = 0u; b < 5; b++)
+      n += i < base_counts[b].size() ? base_counts[b][i] : 0;
+    return n;
+  }
+
+  /**
+   * @brief Mean quality at position i.
+   */
+  auto mean_quality(std::size_t i) const {
+    const auto n = coverage(i);
+    return n == 0 ? 0.0 : static_cast<double>(qual_sums[i]) / n;
+  }
+
+  /**
+   * @brief Number of N bases.
+   */
+  auto n_count() const {
+    return std::reduce(base_counts[4].begin(), base_counts[4].end(),
+                       std::uint64_t{});
+  }
+
+  /**
+   * @brief Fraction of G and C among all A, C, G and T bases.
+   */
+  auto gc_content() const {
+    const auto sum = [this](auto b) {
+      return std::reduce(base_counts[b].begin(), base_counts[b].end(),
+                         std::uint64_t{});
+    };
+    const auto acgt = bases - n_count();
+    return acgt == 0 ? 0.0 : static_cast<double>(sum(1) + sum(2)) / acgt;
+  }
+
+  /**
+   * @brief Estimated fraction of reads which duplicate an earlier read.
+   */
+  auto duplicate_rate() const {
+    auto tracked = std::uint64_t{};
+    for (const auto &[key, count] : prefix_counts)
+      tracked += count;
+    return tracked == 0
+               ? 0.0
+               : 1.0 - static_cast<double>(prefix_counts.size()) / tracked;
+  }
+
+  /**
+   * @brief Merge the statistics of other into this.
+   */
+  auto merge(const FastqStats &other) {
+    if (!other.length_counts.empty())
+      reserve(other.max_length());
+    reads += other.reads;
+    bases += other.bases;
+    for (auto b = 0u; b < 5; b++)
+      add_to(base_counts[b], other.base_counts[b]);
+    add_to(qual_counts, other.qual_counts);
+    add_to(qual_sums, other.qual_sums);
+    add_to(length_counts, other.length_counts);
+    for (auto p = std::size_t{}; p < gc_counts.size(); p++)
+      gc_counts[p] += other.gc_counts[p];
+    for (const auto &[key, count] : other.prefix_counts)
+      track(key, count);
+  }
+
+private:
+  // The largest tracked hash is on top.
+  std::priority_queue<std::uint64_t> tracked_keys_;
+
+  // The threshold of the smallest hashes only falls, so a prefix that is
+  // turned away or evicted is never tracked again and the counts of the
+  // tracked prefixes are exact.
+  auto track(std::uint64_t key, std::uint64_t count) -> void {
+    const auto full = prefix_counts.size() >= DUP_TRACK_LIMIT;
+    if (full && key > tracked_keys_.top())
+      return;
+    if (auto it = prefix_counts.find(key); it != prefix_counts.end()) {
+      it->second += count;
+      return;
+    }
+    if (full) {
+      prefix_counts.erase(tracked_keys_.top());
+      tracked_keys_.pop();
+    }
+    prefix_counts.emplace(key, count);
+    tracked_keys_.push(key);
+  }
+
+  // Codes 0-4 of the bases of seq in a reused buffer, so the counting
+  // passes compare codes without a table lookup per base.
+  template <class Char>
+  static auto encode(std::basic_string_view<Char> seq) -> const std::int8_t * {
+    thread_local auto codes = std::vector<std::int8_t>{};
+    codes.resize(seq.size());
+    if constexpr (std::same_as<Char, char>)
+      detail::simd::encode(seq.data(), seq.size(), codes.data());
+    else
+      for (auto i = std::size_t{}; i < seq.size(); i++)
+        codes[i] = seq[i] > 4 || seq[i] < 0 ? 4 : seq[i];
+    return codes.data();
+  }
+
+  auto reserve(std::size_t size) -> void {
+    if (size < length_counts.size())
+      return;
+    length_counts.resize(size + 1);
+    for (auto &counts : base_counts)
+      counts.resize(size);
+    qual_counts.resize(size * QUAL_LEVELS);
+    qual_sums.resize(size);
+  }
+
+  static auto add_to(std::vector<std::uint64_t> &to,
+                     const std::vector<std::uint64_t> &from) -> void {
+    for (auto i = std::size_t{}; i < from.size(); i++)
+      to[i] += from[i];
+  }
+};
+
+} // namespace biovoltron
@@ -0,0 +1,16 @@
+#pragma once
+
+/**
+ * @defgroup sketch sketch
+ * @ingroup algo
+ * @brief The "sketch" module samples sequences for seeding and overlap
+ * detection.
+ *
+ * Minimizers select the k-mer with the smallest hash of every window of
+ * consecutive k-mers. Two sequences sharing a long enough substring share
+ * its minimizers, which makes them the seeds of long-read mapping and
+ * read-to-read overlapping.
+ */
+
+#include <biovoltron/algo/sketch/minimizer.hpp>
+#include <biovoltron/algo/sketch/minimizer_index.hpp>
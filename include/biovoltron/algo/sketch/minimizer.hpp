@@ -0,0 +1,402 @@
+#pragma once
+
+#include <algorithm>
+#include <biovoltron/container/xbit_vector.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <biovoltron/utility/simd.hpp>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup sketch
+ * @brief Invertible integer hash of the low 2k bits of key (Thomas Wang's
+ * 64-bit mix restricted to the bits of mask), as used by minimap2.
+ *
+ * Every step is a bijection on the masked bits, so k-mers with distinct keys
+ * get distinct hashes and the key is recovered by invertible_hash_inverse.
+ */
+constexpr auto invertible_hash(std::uint64_t key, std::uint64_t mask) noexcept {
+  key = (~key + (key << 21)) & mask;
+  key = key ^ key >> 24;
+  key = (key + (key << 3) + (key << 8)) & mask;
+  key = key ^ key >> 14;
+  key = (key + (key << 2) + (key << 4)) & mask;
+  key = key ^ key >> 28;
+  key = (key + (key << 31)) & mask;
+  return key;
+}
+
+namespace detail {
+
+/**
+ * @brief Multiplicative inverse of an odd number modulo 2^64.
+ */
+constexpr auto inverse_odd(std::uint64_t a) noexcept {
+  auto x = a;
+  for (auto i = 0; i < 5; i++)
+    x *= 2 - a * x;
+  return x;
+}
+
+/**
+ * @brief Inverse of y = x ^ x >> shift.
+ */
+constexpr auto unshift_xor(std::uint64_t y, int shift) noexcept {
+  auto x = y;
+  for (auto s = shift; s < 64; s += shift)
+    x ^= y >> s;
+  return x;
+}
+
+} // namespace detail
+
+/**
+ * @ingroup sketch
+ * @brief The key of hash = invertible_hash(key, mask).
+ */
+constexpr auto invertible_hash_inverse(std::uint64_t hash,
+                                       std::uint64_t mask) noexcept {
+  // The additive steps are multiplications by odd constants.
+  hash = hash * detail::inverse_odd((1ull << 31) + 1) & mask;
+  hash = detail::unshift_xor(hash, 28);
+  hash = hash * detail::inverse_odd(21) & mask;
+  hash = detail::unshift_xor(hash, 14);
+  hash = hash * detail::inverse_odd(265) & mask;
+  hash = detail::unshift_xor(hash, 24);
+  hash = (hash + 1) * detail::inverse_odd((1ull << 21) - 1) & mask;
+  return hash;
+}
+
+/**
+ * @ingroup sketch
+ * @brief A k-mer selected as minimizer.
+ */
+struct Minimizer {
+  /**
+   * @brief Invertible hash of the canonical k-mer, see
+   * MinimizerSketch::key.
+   */
+  std::uint64_t hash;
+
+  /**
+   * @brief Index of the sequence in a batch, or the id passed to the
+   * sketch.
+   */
+  std::uint32_t id;
+
+  /**
+   * @brief Start of the k-mer on the forward strand.
+   */
+  std::uint32_t position;
+
+  /**
+   * @brief Whether the canonical k-mer is the reverse complement of the
+   * forward one.
+   */
+  bool reverse;
+
+  auto operator<=>(const Minimizer &) const = default;
+};
+
+namespace detail {
+
+constexpr inline auto NO_KMER = std::numeric_limits<std::uint64_t>::max();
+
+inline auto hash_keys_scalar(std::uint64_t *keys, std::size_t n,
+                             std::uint64_t mask) {
+  for (auto i = std::size_t{}; i < n; i++)
+    if (keys[i] != NO_KMER)
+      keys[i] = invertible_hash(keys[i], mask);
+}
+
+#ifdef BIOVOLTRON_X86_DISPATCH
+
+[[gnu::target("avx2")]] inline auto
+hash_keys_avx2(std::uint64_t *keys, std::size_t n, std::uint64_t mask) {
+  const auto m = _mm256_set1_epi64x(mask);
+  const auto none = _mm256_set1_epi64x(-1);
+  auto i = std::size_t{};
+  for (; i + 4 <= n; i += 4) {
+    auto *p = reinterpret_cast<__m256i *>(keys + i);
+    const auto k = _mm256_loadu_si256(p);
+    const auto skip = _mm256_cmpeq_epi64(k, none);
+    auto h = _mm256_add_epi64(_mm256_xor_si256(k, none),
+                              _mm256_slli_epi64(k, 21));
+    h = _mm256_and_si256(h, m);
+    h = _mm256_xor_si256(h, _mm256_srli_epi64(h, 24));
+    h = _mm256_add_epi64(h, _mm256_add_epi64(_mm256_slli_epi64(h, 3),
+                                             _mm256_slli_epi64(h, 8)));
+    h = _mm256_and_si256(h, m);
+    h = _mm256_xor_si256(h, _mm256_srli_epi64(h, 14));
+    h = _mm256_add_epi64(h, _mm256_add_epi64(_mm256_slli_epi64(h, 2),
+                                             _mm256_slli_epi64(h, 4)));
+    h = _mm256_and_si256(h, m);
+    h = _mm256_xor_si256(h, _mm256_srli_epi64(h, 28));
+    h = _mm256_and_si256(_mm256_add_epi64(h, _mm256_slli_epi64(h, 31)), m);
+    _mm256_storeu_si256(p, _mm256_or_si256(h, skip));
+  }
+  hash_keys_scalar(keys + i, n - i, mask);
+}
+
+#endif
+
+/**
+ * @brief Replace the keys by their hashes, leaving NO_KMER as it is.
+ */
+inline auto hash_keys(std::uint64_t *keys, std::size_t n, std::uint64_t mask) {
+#ifdef BIOVOLTRON_X86_DISPATCH
+  if (simd_level() != SimdLevel::SCALAR)
+    return hash_keys_avx2(keys, n, mask);
+#endif
+  hash_keys_scalar(keys, n, mask);
+}
+
+/**
+ * @brief a if take else b, with masks since compilers tend to turn a
+ * conditional expression into a branch.
+ */
+template <std::unsigned_integral T>
+constexpr auto select(bool take, T a, T b) noexcept {
+  const auto mask = T{} - take;
+  return static_cast<T>((a & mask) | (b & ~mask));
+}
+
+/**
+ * @brief Index of the leftmost minimum of every window of w < 256 hashes,
+ * each below 2^54 or NO_KMER.
+ *
+ * The minima of the prefixes and suffixes of blocks of w hashes are combined
+ * as in the algorithm of van Herk, Gil and Werman. The scans take the minimum
+ * of the hash shifted left by 8 bits and or-ed with the offset in the block,
+ * so they keep the leftmost of equal hashes without branches. A window of
+ * NO_KMER only gets the index of one of them.
+ */
+inline auto window_argmin(const std::uint64_t *hashes, std::size_t size,
+                          std::size_t w, std::vector<std::uint64_t> &prefix,
+                          std::vector<std::uint64_t> &suffix,
+                          std::uint32_t *argmin) {
+  const auto key = [](std::uint64_t hash, std::uint64_t offset) {
+    return std::min(hash, std::uint64_t{1} << 55) << 8 | offset;
+  };
+  prefix.resize(size);
+  suffix.resize(size);
+  for (auto begin = std::size_t{}; begin < size; begin += w) {
+    const auto n = std::min(w, size - begin);
+    auto pmin = NO_KMER;
+    auto smin = NO_KMER;
+    for (auto t = std::size_t{}; t < n; t++) {
+      pmin = std::min(pmin, key(hashes[begin + t], t));
+      prefix[begin + t] = pmin;
+      const auto r = n - 1 - t;
+      smin = std::min(smin, key(hashes[begin + r], r));
+      suffix[begin + r] = smin;
+    }
+  }
+  // Window j is a suffix of its block and a prefix of the next one, ties go
+  // to the suffix.
+  for (auto begin = std::size_t{}; begin + w <= size; begin += w) {
+    const auto end = std::min(begin + w, size - w + 1);
+    for (auto j = begin; j < end; j++) {
+      const auto p = prefix[j + w - 1];
+      const auto s = suffix[j];
+      const auto next = j == begin ? begin : begin + w;
+      argmin[j] = select<std::uint32_t>((p >> 8) < (s >> 8), next + (p & 255),
+                                        begin + (s & 255));
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @ingroup sketch
+ * @brief Extracts (w, k)-minimizers of DNA sequences.
+ *
+ * The k-mer at every position is replaced by its canonical form, the
+ * smaller key of the k-mer and its reverse complement, and hashed with
+ * invertible_hash. K-mers containing an N and k-mers equal to their reverse
+ * complement have no hash. Of every window of w consecutive k-mers with at
+ * least one hash, the k-mer with the smallest hash is a minimizer, the
+ * leftmost one on ties. Each minimizer is reported once, in order of
+ * position, so a sequence of n random bases has about 2n / (w + 1) of them.
+ * Sequences with fewer than w k-mers have none.
+ *
+ * The k-mers are rolled and hashed in chunks, the hashing with AVX2 where
+ * available, and the window minima of a chunk are found without branches, so
+ * random sequences cost no branch mispredictions.
+ *
+ * Example
+ * ```cpp
+ * #include <biovoltron/algo/sketch/minimizer.hpp>
+ *
+ * auto sketch = biovoltron::MinimizerSketch{10, 15};
+ * for (auto m : sketch(biovoltron::Codec::to_istring(seq)))
+ *   std::cout << m.position << (m.reverse ? '-' : '+') << "\n";
+ * ```
+ */
+class MinimizerSketch {
+  std::size_t w_;
+  std::size_t k_;
+  std::uint64_t mask_;
+
+  struct Buffers {
+    std::vector<std::uint64_t> hashes;
+    std::vector<std::uint8_t> reverse;
+    std::vector<std::uint64_t> prefix;
+    std::vector<std::uint64_t> suffix;
+    std::vector<std::uint32_t> argmin;
+    std::vector<Minimizer> found;
+  };
+
+  template <class It>
+  auto sketch_bases(It it, std::size_t size, std::uint32_t id,
+                    std::vector<Minimizer> &out) const {
+    if (size < k_ || size - k_ + 1 < w_)
+      return;
+    if (size > std::numeric_limits<std::uint32_t>::max())
+      throw std::length_error("MinimizerSketch: sequence too long");
+    const auto kmers = size - k_ + 1;
+    out.reserve(out.size() + std::min(kmers, kmers * 9 / (4 * w_ + 4) + 16));
+
+    // Buffers hold the w - 1 k-mers before a chunk followed by the chunk.
+    const auto history = w_ - 1;
+    const auto chunk = std::max<std::size_t>(4096, w_);
+    thread_local auto buffers = Buffers{};
+    auto &hashes = buffers.hashes;
+    auto &reverse = buffers.reverse;
+    auto &argmin = buffers.argmin;
+    auto &found = buffers.found;
+    hashes.resize(history + chunk);
+    reverse.resize(history + chunk);
+    argmin.resize(chunk);
+    found.resize(chunk);
+
+    const auto shift = 2 * (k_ - 1);
+    auto fwd = 0ull;
+    auto rev = 0ull;
+    auto run = std::size_t{};
+    const auto push = [&](std::uint8_t c) {
+      if (c < 4) {
+        fwd = (fwd << 2 | c) & mask_;
+        rev = rev >> 2 | (3ull - c) << shift;
+        run++;
+      } else
+        run = 0;
+    };
+    for (auto i = std::size_t{1}; i < k_; i++)
+      push(*it++);
+
+    auto emitted = std::numeric_limits<std::size_t>::max();
+    for (auto first = std::size_t{}; first < kmers; first += chunk) {
+      const auto count = std::min(chunk, kmers - first);
+      for (auto j = history; j < history + count; j++) {
+        push(*it++);
+        const auto valid = run >= k_ && fwd != rev;
+        hashes[j] = valid ? std::min(fwd, rev) : detail::NO_KMER;
+        reverse[j] = rev < fwd;
+      }
+      detail::hash_keys(hashes.data() + history, count, mask_);
+
+      // The window ending at k-mer first + j starts at buffer index j, the
+      // buffer index of k-mer p is p - first + history.
+      detail::window_argmin(hashes.data(), history + count, w_, buffers.prefix,
+                            buffers.suffix, argmin.data());
+      const auto skip = first == 0 ? history : 0;
+      auto n = std::size_t{};
+      for (auto j = skip; j < count; j++) {
+        const auto q = argmin[j];
+        const auto pos = first + q - history;
+        const auto hash = hashes[q];
+        found[n] = {hash, id, static_cast<std::uint32_t>(pos),
+                    static_cast<bool>(reverse[q])};
+        const auto emit = hash != detail::NO_KMER && pos != emitted;
+        n += emit;
+        emitted = detail::select(emit, pos, emitted);
+      }
+      out.insert(out.end(), found.begin(), found.begin() + n);
+
+      if (count == chunk) {
+        std::copy_n(hashes.begin() + count, history, hashes.begin());
+        std::copy_n(reverse.begin() + count, history, reverse.begin());
+      }
+    }
+  }
+
+public:
+  /**
+   * @param w Number of consecutive k-mers in a window, from 1 to 255.
+   * @param k K-mer size, from 1 to 27.
+   */
+  MinimizerSketch(std::size_t w, std::size_t k) : w_(w), k_(k) {
+    if (w == 0 || w > 255 || k == 0 || k > 27)
+      throw std::invalid_argument("MinimizerSketch: invalid w or k");
+    mask_ = (1ull << 2 * k) - 1;
+  }
+
+  auto w() const noexcept { return w_; }
+
+  auto k() const noexcept { return k_; }
+
+  /**
+   * @brief The canonical k-mer key of a minimizer, in the format of
+   * Codec::hash.
+   */
+  auto key(const Minimizer &minimizer) const noexcept {
+    return invertible_hash_inverse(minimizer.hash, mask_);
+  }
+
+  /**
+   * @brief Append the minimizers of seq to out, tagged with id.
+   */
+  auto sketch(istring_view seq, std::uint32_t id,
+              std::vector<Minimizer> &out) const {
+    sketch_bases(seq.begin(), seq.size(), id, out);
+  }
+
+  template <std::unsigned_integral Block, class Allocator>
+  auto sketch(const DibitVector<Block, Allocator> &seq, std::uint32_t id,
+              std::vector<Minimizer> &out) const {
+    sketch_bases(seq.begin(), seq.size(), id, out);
+  }
+
+  /**
+   * @brief The minimizers of seq, an istring or a DibitVector.
+   */
+  auto operator()(const auto &seq, std::uint32_t id = 0) const {
+    auto out = std::vector<Minimizer>{};
+    sketch(seq, id, out);
+    return out;
+  }
+
+  /**
+   * @brief The minimizers of a batch of sequences sketched in parallel,
+   * tagged with the index of their sequence and ordered by it.
+   */
+  template <std::ranges::random_access_range Seqs>
+  auto batch(const Seqs &seqs) const {
+    const auto n = std::ranges::size(seqs);
+    auto parts = std::vector<std::vector<Minimizer>>(n);
+    auto ids = std::vector<std::uint32_t>(n);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::for_each(std::execution::par, ids.begin(), ids.end(), [&](auto i) {
+      sketch(std::ranges::begin(seqs)[i], i, parts[i]);
+    });
+    auto out = std::vector<Minimizer>{};
+    auto total = std::size_t{};
+    for (const auto &part : parts)
+      total += part.size();
+    out.reserve(total);
+    for (const auto &part : parts)
+      out.insert(out.end(), part.begin(), part.end());
+    return out;
+  }
+};
+
+} // namespace biovoltron
@@ -0,0 +1,435 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <biovoltron/algo/sketch/minimizer.hpp>
+#include <biovoltron/file_io/core/binary.hpp>
+#include <biovoltron/file_io/fasta.hpp>
+#include <bit>
+#include <execution>
+#include <fcntl.h>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup sketch
+ * @brief A reference occurrence of a minimizer in a MinimizerIndex.
+ */
+struct MinimizerHit {
+  /// Index of the reference sequence.
+  std::uint32_t id;
+  /// Position of the k-mer in the reference sequence.
+  std::uint32_t position : 31;
+  /// Whether the canonical k-mer is the reverse complement of the reference.
+  std::uint32_t reverse : 1;
+
+  friend bool operator==(const MinimizerHit &,
+                         const MinimizerHit &) noexcept = default;
+};
+
+/**
+ * @ingroup sketch
+ * @brief A minimizer shared by a query and a reference sequence, the anchor
+ * of a chain.
+ *
+ * Seeds are ordered by reference sequence, strand and reference position,
+ * the order in which they are chained.
+ */
+struct MinimizerSeed {
+  /// Index of the reference sequence.
+  std::uint32_t id;
+  /// Whether the query k-mer is the reverse complement of the reference one.
+  bool reverse;
+  /// Position of the k-mer in the reference sequence.
+  std::uint32_t position;
+  /// Position of the k-mer in the query, on its forward strand.
+  std::uint32_t query_position;
+
+  auto operator<=>(const MinimizerSeed &) const = default;
+};
+
+namespace detail::minimizer_index {
+
+constexpr auto MAGIC = std::string_view{"BVMMI\0\0\1", 8};
+
+/**
+ * @brief A hash with its hits at [offset, offset + count), count is 0 for
+ * an empty slot.
+ */
+struct Slot {
+  std::uint64_t hash;
+  std::uint32_t offset;
+  std::uint32_t count;
+};
+
+/**
+ * @brief The slots of one cache line, a lookup usually reads only the
+ * bucket its hash maps to.
+ */
+struct alignas(64) Bucket {
+  std::array<Slot, 4> slots;
+};
+
+static_assert(sizeof(Bucket) == 64);
+static_assert(sizeof(MinimizerHit) == 8);
+
+/**
+ * @brief Stable LSD radix sort of seeds by sequence, strand and position,
+ * 11 bits per pass and only over the bits in use.
+ *
+ * Seeds are generated in order of query position, so the result is in the
+ * order of MinimizerSeed::operator<=>.
+ */
+inline auto sort_seeds(std::vector<MinimizerSeed> &seeds) {
+  constexpr auto BITS = 11;
+  const auto key = [](const MinimizerSeed &seed) {
+    return std::uint64_t{seed.id} << 32 | std::uint64_t{seed.reverse} << 31 |
+           seed.position;
+  };
+  if (seeds.size() < 64) {
+    std::ranges::stable_sort(seeds, {}, key);
+    return;
+  }
+  auto used = std::uint64_t{};
+  for (const auto &seed : seeds)
+    used |= key(seed);
+  thread_local auto buffer = std::vector<MinimizerSeed>{};
+  buffer.resize(seeds.size());
+  const auto bits = static_cast<int>(std::bit_width(used));
+  for (auto shift = 0; shift < bits; shift += BITS) {
+    auto offsets = std::array<std::size_t, (1 << BITS) + 1>{};
+    const auto digit = [&](const MinimizerSeed &seed) {
+      return (key(seed) >> shift & ((1 << BITS) - 1)) + 1;
+    };
+    for (const auto &seed : seeds)
+      offsets[digit(seed)]++;
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for (const auto &seed : seeds)
+      buffer[offsets[digit(seed) - 1]++] = seed;
+    seeds.swap(buffer);
+  }
+}
+
+} // namespace detail::minimizer_index
+
+/**
+ * @ingroup sketch
+ * @brief Hash table from the minimizers of reference sequences to their
+ * occurrences, for minimap2-style seeding.
+ *
+ * The minimizers of all sequences are sorted by hash, so the hits of a hash
+ * are one contiguous run of the hit array, ordered by sequence and
+ * position. Every distinct hash has a slot in an open addressing table of
+ * cache line sized buckets, indexed by the low bits of the hash and probed
+ * linearly, which is filled to at most 75%.
+ *
+ * Minimizers of repeats occur so often that their seeds carry little
+ * information but cost most of the chaining time. The most frequent
+ * `filter_fraction` of the distinct minimizers determine max_occurrences(),
+ * minimizers with more hits than that are skipped by seeds().
+ *
+ * An index is written with save() and loaded with load(), which memory maps
+ * the file so the table is paged in on demand and shared between processes.
+ * The file is in native byte order.
+ *
+ * Example
+ * ```cpp
+ * #include <biovoltron/algo/sketch/minimizer_index.hpp>
+ *
+ * auto index = biovoltron::MinimizerIndex{genome, 10, 15};
+ * auto os = std::ofstream{"genome.mmi", std::ios::binary};
+ * index.save(os);
+ * os.close();
+ *
+ * const auto loaded = biovoltron::MinimizerIndex::load("genome.mmi");
+ * for (auto seed : loaded.seeds(biovoltron::Codec::to_istring(read.seq)))
+ *   std::cout << loaded.names()[seed.id] << ":" << seed.position << "\n";
+ * ```
+ */
+class MinimizerIndex {
+  using Slot = detail::minimizer_index::Slot;
+  using Bucket = detail::minimizer_index::Bucket;
+
+  MinimizerSketch sketch_;
+  std::uint32_t max_occurrences_ = std::numeric_limits<std::uint32_t>::max();
+  std::size_t distinct_ = 0;
+  std::vector<std::string> names_;
+  std::vector<std::uint32_t> lengths_;
+  std::vector<Bucket> owned_buckets_;
+  std::vector<MinimizerHit> owned_hits_;
+  std::shared_ptr<const void> map_;
+  std::span<const Bucket> buckets_;
+  std::span<const MinimizerHit> hits_;
+
+  explicit MinimizerIndex(MinimizerSketch sketch) : sketch_(sketch) {}
+
+  auto build(std::vector<Minimizer> &minimizers, double filter_fraction) {
+    if (minimizers.size() > std::numeric_limits<std::uint32_t>::max())
+      throw std::length_error("MinimizerIndex: too many minimizers");
+    std::sort(std::execution::par, minimizers.begin(), minimizers.end());
+
+    auto runs = std::vector<Slot>{};
+    owned_hits_.resize(minimizers.size());
+    for (auto i = std::size_t{}; i < minimizers.size(); i++) {
+      const auto &m = minimizers[i];
+      if (i == 0 || m.hash != minimizers[i - 1].hash)
+        runs.push_back({m.hash, static_cast<std::uint32_t>(i), 0});
+      runs.back().count++;
+      owned_hits_[i] = {m.id, m.position, m.reverse};
+    }
+    distinct_ = runs.size();
+
+    const auto buckets = runs.empty() ? 0 : std::bit_ceil(runs.size() / 3 + 1);
+    owned_buckets_.resize(buckets);
+    const auto mask = owned_buckets_.size() - 1;
+    for (const auto &run : runs)
+      for (auto b = run.hash & mask;; b = (b + 1) & mask) {
+        auto &slots = owned_buckets_[b].slots;
+        const auto empty = std::ranges::find(slots, 0u, &Slot::count);
+        if (empty != slots.end()) {
+          *empty = run;
+          break;
+        }
+      }
+    buckets_ = owned_buckets_;
+    hits_ = owned_hits_;
+
+    if (filter_fraction > 0 && !runs.empty()) {
+      const auto n = runs.size();
+      const auto nth = std::min(
+          n - 1, static_cast<std::size_t>(n * (1 - filter_fraction)));
+      auto counts = std::vector<std::uint32_t>(n);
+      std::ranges::transform(runs, counts.begin(), &Slot::count);
+      std::ranges::nth_element(counts, counts.begin() + nth);
+      max_occurrences_ = counts[nth];
+    }
+  }
+
+public:
+  /**
+   * @brief Index the minimizers of a reference.
+   * @param records Reference sequences, each shorter than 2^31 bases.
+   * @param w Number of consecutive k-mers in a window, from 1 to 255.
+   * @param k K-mer size, from 1 to 27.
+   * @param filter_fraction Fraction of the most frequent distinct
+   * minimizers skipped by seeds(), 0 keeps all.
+   * @throws std::invalid_argument if w or k is out of range.
+   * @throws std::length_error if a sequence or the index is too large.
+   */
+  template <bool Encoded>
+  explicit MinimizerIndex(const std::vector<FastaRecord<Encoded>> &records,
+                          std::size_t w = 10, std::size_t k = 15,
+                          double filter_fraction = 2e-4)
+      : sketch_(w, k) {
+    for (const auto &record : records) {
+      if (record.seq.size() >= std::size_t{1} << 31)
+        throw std::length_error("MinimizerIndex: sequence too long");
+      names_.push_back(record.name);
+      lengths_.push_back(record.seq.size());
+    }
+    const auto seqs =
+        records | std::views::transform([](const auto &record) {
+          if constexpr (Encoded)
+            return istring_view{record.seq};
+          else
+            return Codec::to_istring(record.seq);
+        });
+    auto minimizers = sketch_.batch(seqs);
+    build(minimizers, filter_fraction);
+  }
+
+  MinimizerIndex(const MinimizerIndex &) = delete;
+  MinimizerIndex &operator=(const MinimizerIndex &) = delete;
+  MinimizerIndex(MinimizerIndex &&) noexcept = default;
+  MinimizerIndex &operator=(MinimizerIndex &&) noexcept = default;
+
+  /**
+   * @brief The sketch which selects the minimizers of the index and of
+   * queries.
+   */
+  auto sketch() const noexcept -> const MinimizerSketch & { return sketch_; }
+
+  /**
+   * @brief Minimizers with more hits are skipped by seeds().
+   */
+  auto max_occurrences() const noexcept { return max_occurrences_; }
+
+  /**
+   * @brief Names of the reference sequences, indexed by id.
+   */
+  auto names() const noexcept -> const std::vector<std::string> & {
+    return names_;
+  }
+
+  /**
+   * @brief Lengths of the reference sequences, indexed by id.
+   */
+  auto lengths() const noexcept -> const std::vector<std::uint32_t> & {
+    return lengths_;
+  }
+
+  /**
+   * @brief Number of indexed minimizer occurrences.
+   */
+  auto size() const noexcept { return hits_.size(); }
+
+  /**
+   * @brief Number of distinct minimizer hashes.
+   */
+  auto distinct() const noexcept { return distinct_; }
+
+  /**
+   * @brief All reference occurrences of a minimizer hash, ordered by
+   * sequence and position.
+   *
+   * The slots of a loaded index are only checked when they are probed, so
+   * loading stays independent of the size of the table.
+   *
+   * @throw std::runtime_error if the slot of hash points outside the hits.
+   */
+  auto find(std::uint64_t hash) const -> std::span<const MinimizerHit> {
+    const auto mask = buckets_.size() - 1;
+    for (auto probes = std::size_t{}, b = hash & mask;
+         probes < buckets_.size(); probes++, b = (b + 1) & mask)
+      for (const auto &slot : buckets_[b].slots) {
+        if (slot.count == 0)
+          return {};
+        if (slot.hash != hash)
+          continue;
+        if (std::uint64_t{slot.offset} + slot.count > hits_.size())
+          throw std::runtime_error("MinimizerIndex: corrupt index");
+        return hits_.subspan(slot.offset, slot.count);
+      }
+    return {};
+  }
+
+  /**
+   * @brief Seeds of a query, from its minimizers with at most
+   * max_occurrences hits, in chaining order.
+   */
+  auto seeds(istring_view query, std::size_t max_occurrences) const {
+    auto seeds = std::vector<MinimizerSeed>{};
+    for (const auto &m : sketch_(query)) {
+      const auto hits = find(m.hash);
+      if (hits.size() > max_occurrences)
+        continue;
+      for (const auto hit : hits)
+        seeds.push_back({hit.id, static_cast<bool>(hit.reverse) != m.reverse,
+                         hit.position, m.position});
+    }
+    detail::minimizer_index::sort_seeds(seeds);
+    return seeds;
+  }
+
+  auto seeds(istring_view query) const {
+    return seeds(query, max_occurrences_);
+  }
+
+  /**
+   * @brief Write the index in the format read by load().
+   */
+  auto save(std::ostream &os) const {
+    auto header = std::string{detail::minimizer_index::MAGIC};
+    detail::put_raw(header, static_cast<std::uint64_t>(sketch_.w()));
+    detail::put_raw(header, static_cast<std::uint64_t>(sketch_.k()));
+    detail::put_raw(header, max_occurrences_);
+    detail::put_varint(header, distinct_);
+    detail::put_varint(header, buckets_.size());
+    detail::put_varint(header, hits_.size());
+    detail::put_varint(header, names_.size());
+    for (auto i = std::size_t{}; i < names_.size(); i++) {
+      detail::put_field(header, names_[i]);
+      detail::put_raw(header, lengths_[i]);
+    }
+    // The table starts at a multiple of the bucket size, so it is aligned
+    // in a mapped file.
+    header.resize((header.size() + sizeof(Bucket) - 1) / sizeof(Bucket) *
+                  sizeof(Bucket));
+    os.write(header.data(), header.size());
+    os.write(reinterpret_cast<const char *>(buckets_.data()),
+             buckets_.size_bytes());
+    os.write(reinterpret_cast<const char *>(hits_.data()), hits_.size_bytes());
+  }
+
+  /**
+   * @brief Memory map an index written by save().
+   * @throws std::runtime_error if the file cannot be mapped or is not an
+   * index.
+   */
+  static auto load(const std::filesystem::path &path) {
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("MinimizerIndex: cannot open " + path.string());
+    struct stat st {};
+    const auto size = ::fstat(fd, &st) == 0 ? std::size_t(st.st_size) : 0;
+    auto map = size == 0 ? MAP_FAILED
+                         : ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+      throw std::runtime_error("MinimizerIndex: cannot map " + path.string());
+    auto owner = std::shared_ptr<const void>(
+        map, [size](const void *p) { ::munmap(const_cast<void *>(p), size); });
+
+    const auto bad = [] {
+      return std::runtime_error("MinimizerIndex: not an index file");
+    };
+    const auto data = std::string_view{static_cast<const char *>(map), size};
+    if (!data.starts_with(detail::minimizer_index::MAGIC))
+      throw bad();
+    auto in = data.substr(detail::minimizer_index::MAGIC.size());
+    const auto w = detail::get_raw<std::uint64_t>(in);
+    const auto k = detail::get_raw<std::uint64_t>(in);
+    auto index = [&] {
+      try {
+        return MinimizerIndex{MinimizerSketch(w, k)};
+      } catch (const std::invalid_argument &) {
+        throw bad();
+      }
+    }();
+    index.max_occurrences_ = detail::get_raw<std::uint32_t>(in);
+    index.distinct_ = detail::get_varint(in);
+    const auto buckets = detail::get_varint(in);
+    const auto hits = detail::get_varint(in);
+    const auto sequences = detail::get_varint(in);
+    if (sequences > in.size())
+      throw bad();
+    index.names_.resize(sequences);
+    index.lengths_.resize(sequences);
+    for (auto i = std::size_t{}; i < sequences; i++) {
+      detail::get_field(in, index.names_[i]);
+      index.lengths_[i] = detail::get_raw<std::uint32_t>(in);
+    }
+
+    const auto offset = (size - in.size() + sizeof(Bucket) - 1) /
+                        sizeof(Bucket) * sizeof(Bucket);
+    if ((buckets != 0 && !std::has_single_bit(buckets)) || offset > size ||
+        buckets > (size - offset) / sizeof(Bucket))
+      throw bad();
+    if (const auto rest = size - offset - buckets * sizeof(Bucket);
+        hits != rest / sizeof(MinimizerHit) || rest % sizeof(MinimizerHit))
+      throw bad();
+    const auto table = data.data() + offset;
+    index.buckets_ = {reinterpret_cast<const Bucket *>(table), buckets};
+    index.hits_ = {reinterpret_cast<const MinimizerHit *>(
+                       table + buckets * sizeof(Bucket)),
+                   hits};
+    index.map_ = std::move(owner);
+    return index;
+  }
+};
+
+} // namespace biovoltron
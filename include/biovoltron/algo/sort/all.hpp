@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+ * @defgroup sort sort
+ * @ingroup algo
+ * @brief The "sort" module sorts record sets which exceed the main memory.
+ *
+ * Records are sorted in memory-sized runs in parallel, spilled to disk in a
+ * compact binary encoding and merged with a k-way loser tree, so the memory
+ * needed is bounded by the run size instead of the number of records.
+ */
+
+#include <biovoltron/algo/sort/external_sorter.hpp>
@@ -0,0 +1,383 @@
+#pragma once
+
+#include <algorithm>
+#include <biovoltron/file_io/core/binary.hpp>
+#include <biovoltron/file_io/core/record.hpp>
+#include <biovoltron/utility/instrumentation.hpp>
+#include <execution>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace biovoltron {
+
+namespace detail {
+
+/**
+ * @brief Append record to out as its varint size followed by the binary
+ * encoding of all fields.
+ */
+template <std::derived_from<Record> R>
+inline auto put_record(std::string &out, const R &record) {
+  thread_local auto payload = std::string{};
+  payload.clear();
+  std::apply([](const auto &...field) { (put_field(payload, field), ...); },
+             to_tuple(record));
+  put_varint(out, payload.size());
+  out += payload;
+}
+
+/**
+ * @brief Decode the fields of record from the payload written by
+ * put_record.
+ */
+template <std::derived_from<Record> R>
+inline auto get_record(std::string_view payload, R &record) {
+  std::apply([&payload](auto &...field) { (get_field(payload, field), ...); },
+             to_tuple(record));
+}
+
+/**
+ * @brief Sequentially reads the records of one sorted run.
+ */
+template <std::derived_from<Record> R> class RunReader {
+  std::ifstream file_;
+  std::string buffer_;
+  std::size_t pos_ = 0;
+  std::size_t block_size_;
+
+  // Make sure that at least n unread bytes are buffered, unless the file
+  // ends before.
+  auto fill(std::size_t n) {
+    if (buffer_.size() - pos_ >= n)
+      return;
+    buffer_.erase(0, pos_);
+    pos_ = 0;
+    const auto old_size = buffer_.size();
+    buffer_.resize(old_size + std::max(n, block_size_));
+    file_.read(buffer_.data() + old_size, buffer_.size() - old_size);
+    buffer_.resize(old_size + file_.gcount());
+  }
+
+public:
+  RunReader(const std::filesystem::path &path, std::size_t block_size)
+      : file_(path, std::ios::binary), block_size_(block_size) {
+    if (!file_)
+      throw std::runtime_error("ExternalSorter: cannot open " + path.string());
+  }
+
+  /**
+   * @return False if the run is exhausted.
+   */
+  auto next(R &record) {
+    fill(10);
+    if (pos_ == buffer_.size())
+      return false;
+    auto in = std::string_view{buffer_}.substr(pos_);
+    const auto size = get_varint(in);
+    pos_ = buffer_.size() - in.size();
+    fill(size);
+    if (buffer_.size() - pos_ < size)
+      throw std::runtime_error("ExternalSorter: truncated run");
+    get_record(std::string_view{buffer_}.substr(pos_, size), record);
+    pos_ += size;
+    return true;
+  }
+};
+
+/**
+ * @brief Tournament tree of losers over k sources.
+ *
+ * Leaves are the sources, every inner node keeps the loser of the match
+ * played there and `winner()` is the overall smallest source. After the
+ * winner advanced, `replay()` only replays the matches on its path to the
+ * root, which needs log(k) comparisons instead of the 2 log(k) of a binary
+ * heap.
+ *
+ * @tparam Less less(i, j) is whether the head of source i goes before the
+ * head of source j.
+ */
+template <class Less> class LoserTree {
+  std::vector<std::size_t> tree_;
+  Less less_;
+
+  auto build(std::size_t node) -> std::size_t {
+    const auto k = tree_.size();
+    if (node >= k)
+      return node - k;
+    const auto left = build(2 * node);
+    const auto right = build(2 * node + 1);
+    if (less_(right, left)) {
+      tree_[node] = left;
+      return right;
+    }
+    tree_[node] = right;
+    return left;
+  }
+
+public:
+  LoserTree(std::size_t k, Less less) : tree_(k), less_(std::move(less)) {
+    if (k != 0)
+      tree_[0] = build(1);
+  }
+
+  auto winner() const noexcept { return tree_[0]; }
+
+  /**
+   * @brief Restore the tree after the head of the winner changed.
+   */
+  auto replay() {
+    const auto k = tree_.size();
+    auto winner = tree_[0];
+    for (auto node = (winner + k) / 2; node > 0; node /= 2)
+      if (less_(tree_[node], winner))
+        std::swap(tree_[node], winner);
+    tree_[0] = winner;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup sort
+ * @brief External merge sort for Records which do not fit into memory.
+ *
+ * Records are pushed into an in-memory buffer of `max_records` records.
+ * Whenever the buffer is full it is sorted in parallel and written as a
+ * sorted run into a spill file, while the next buffer is already being
+ * filled. The spill files use a compact binary encoding of the fields
+ * derived from `to_tuple`. `merge()` finally merges all runs with a loser
+ * tree and hands out the records in order. If all records fit into a
+ * single buffer, nothing is written to disk.
+ *
+ * Records are ordered by `comp(key(a), key(b))`, and records with equal
+ * keys keep the order in which they were pushed.
+ *
+ * The header pointer of a HeaderableRecord is not spilled, every record
+ * handed out by `merge()` points to the header of the first pushed record.
+ *
+ * Example
+ * ```cpp
+ * const auto by_position = [](const BedRecord &r) {
+ *   return std::tie(r.chrom, r.start);
+ * };
+ * using Sorter = biovoltron::ExternalSorter<BedRecord, decltype(by_position)>;
+ * auto sorter = Sorter{by_position};
+ * for (auto record = BedRecord{}; bed >> record;)
+ *   sorter.push(record);
+ * sorter.merge([&](const auto &record) { os << record << "\n"; });
+ * ```
+ *
+ * @tparam R Record type, all fields have to be arithmetic, strings,
+ * istrings or std::vectors of those.
+ * @tparam Key Key extractor, key(record) gives the sort key.
+ * @tparam Compare Strict weak ordering of keys.
+ */
+template <std::derived_from<Record> R, class Key,
+          class Compare = std::ranges::less>
+class ExternalSorter {
+  using key_type = std::invoke_result_t<const Key &, const R &>;
+
+  Key key_;
+  Compare comp_;
+  std::size_t max_records_;
+  std::filesystem::path spill_dir_;
+  std::vector<R> buffer_;
+  std::vector<std::filesystem::path> runs_;
+  std::future<void> spilling_;
+  std::optional<R> prototype_;
+  std::string prefix_;
+
+  auto less(const R &a, const R &b) const {
+    return std::invoke(comp_, std::invoke(key_, a), std::invoke(key_, b));
+  }
+
+  auto sort_buffer(std::vector<R> &records) const {
+    std::stable_sort(
+        std::execution::par, records.begin(), records.end(),
+        [this](const auto &a, const auto &b) { return less(a, b); });
+  }
+
+  auto wait_spill() {
+    if (spilling_.valid())
+      spilling_.get();
+  }
+
+  auto spill() -> void {
+    wait_spill();
+    auto records = std::move(buffer_);
+    buffer_ = {};
+    buffer_.reserve(max_records_);
+    const auto &path = runs_.emplace_back(
+        spill_dir_ / (prefix_ + std::to_string(runs_.size()) + ".run"));
+    const auto write_run = [this, path](std::vector<R> records) {
+      BIOVOLTRON_TIMED_SCOPE(timer, "external_sorter/spill");
+      sort_buffer(records);
+      auto file = std::ofstream{path, std::ios::binary};
+      auto bytes = std::string{};
+      for (const auto &record : records) {
+        detail::put_record(bytes, record);
+        if (bytes.size() >= (1 << 20)) {
+          file.write(bytes.data(), bytes.size());
+          bytes.clear();
+        }
+      }
+      file.write(bytes.data(), bytes.size());
+      BIOVOLTRON_TIMER_ADD(timer, records.size(), file.tellp());
+      if (!file.flush())
+        throw std::runtime_error("ExternalSorter: cannot write " +
+                                 path.string());
+    };
+    spilling_ = std::async(std::launch::async, write_run, std::move(records));
+  }
+
+  auto remove_runs() noexcept {
+    auto ec = std::error_code{};
+    for (const auto &path : runs_)
+      std::filesystem::remove(path, ec);
+    runs_.clear();
+  }
+
+public:
+  /**
+   * @param key Key extractor.
+   * @param max_records Number of records sorted in memory at a time.
+   * @param spill_dir Directory of the spill files.
+   * @param comp Ordering of keys.
+   */
+  explicit ExternalSorter(
+      Key key, std::size_t max_records = std::size_t{1} << 22,
+      std::filesystem::path spill_dir = std::filesystem::temp_directory_path(),
+      Compare comp = {})
+      : key_(std::move(key)), comp_(std::move(comp)),
+        max_records_(std::max<std::size_t>(max_records, 1)),
+        spill_dir_(std::move(spill_dir)) {
+    auto rd = std::random_device{};
+    prefix_ = "biovoltron_sort_" + std::to_string(rd()) + "_" +
+              std::to_string(rd()) + "_";
+    buffer_.reserve(std::min<std::size_t>(max_records_, 1 << 20));
+  }
+
+  ExternalSorter(const ExternalSorter &) = delete;
+  ExternalSorter &operator=(const ExternalSorter &) = delete;
+
+  ~ExternalSorter() {
+    try {
+      wait_spill();
+    } catch (...) {
+    }
+    remove_runs();
+  }
+
+  /**
+   * @brief Number of spill files written so far.
+   */
+  auto runs() const noexcept { return runs_.size(); }
+
+  /**
+   * @brief Add a record.
+   */
+  auto push(R record) {
+    if (!prototype_)
+      prototype_ = record;
+    buffer_.push_back(std::move(record));
+    if (buffer_.size() == max_records_)
+      spill();
+  }
+
+  /**
+   * @brief Hand out all pushed records in sorted order.
+   *
+   * The sorter is empty afterwards and all spill files are removed.
+   *
+   * @param out Called with every record, `out(const R &)`.
+   */
+  template <class Out> auto merge(Out &&out) -> void {
+    BIOVOLTRON_TIMED_SCOPE(timer, "external_sorter/merge");
+    if (runs_.empty()) {
+      BIOVOLTRON_TIMER_ADD(timer, buffer_.size(), 0);
+      sort_buffer(buffer_);
+      for (const auto &record : buffer_)
+        std::invoke(out, record);
+      buffer_.clear();
+      prototype_.reset();
+      return;
+    }
+    if (!buffer_.empty())
+      spill();
+    wait_spill();
+
+    const auto k = runs_.size();
+    auto readers = std::vector<detail::RunReader<R>>{};
+    readers.reserve(k);
+    for (const auto &path : runs_)
+      readers.emplace_back(path, std::max<std::size_t>(
+                                     (std::size_t{64} << 20) / k, 1 << 16));
+    auto heads = std::vector<R>(k, *prototype_);
+    auto keys = std::vector<std::optional<key_type>>(k);
+    const auto advance = [&](std::size_t i) {
+      keys[i].reset();
+      if (readers[i].next(heads[i]))
+        keys[i].emplace(std::invoke(key_, std::as_const(heads[i])));
+    };
+    for (auto i = std::size_t{}; i < k; i++)
+      advance(i);
+
+    // Exhausted runs go last, equal keys are ordered by run, which keeps
+    // the sort stable since runs are in push order.
+    const auto run_less = [&](std::size_t i, std::size_t j) {
+      if (!keys[i] || !keys[j])
+        return keys[i] && !keys[j] ? true : !keys[i] && !keys[j] && i < j;
+      if (std::invoke(comp_, *keys[i], *keys[j]))
+        return true;
+      return !std::invoke(comp_, *keys[j], *keys[i]) && i < j;
+    };
+    auto tree = detail::LoserTree{k, run_less};
+    for (auto i = tree.winner(); keys[i]; i = tree.winner()) {
+      std::invoke(out, std::as_const(heads[i]));
+      BIOVOLTRON_TIMER_ADD(timer, 1, 0);
+      advance(i);
+      tree.replay();
+    }
+    remove_runs();
+    prototype_.reset();
+  }
+};
+
+/**
+ * @ingroup sort
+ * @brief Sort all Records of a tab-delimited stream into another one,
+ * one record per line, with bounded memory.
+ */
+template <std::derived_from<Record> R, class Key,
+          class Compare = std::ranges::less>
+inline auto sort_records(
+    std::istream &is, std::ostream &os, Key key,
+    std::size_t max_records = std::size_t{1} << 22,
+    std::filesystem::path spill_dir = std::filesystem::temp_directory_path(),
+    Compare comp = {}) {
+  auto sorter = ExternalSorter<R, Key, Compare>{
+      std::move(key), max_records, std::move(spill_dir), std::move(comp)};
+  for (auto record = R{}; is >> record;)
+    sorter.push(record);
+  auto buffer = std::string{};
+  sorter.merge([&os, &buffer](const auto &record) {
+    detail::format_record(buffer, record, os.precision());
+    buffer += '\n';
+    if (buffer.size() >= (1 << 20)) {
+      os.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  });
+  os.write(buffer.data(), buffer.size());
+}
+
+} // namespace biovoltron
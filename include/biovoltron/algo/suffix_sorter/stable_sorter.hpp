@@ -1,6 +1,7 @@
 #pragma once
 
 #include <biovoltron/algo/suffix_sorter/core/suffix_sorter.hpp>
+#include <biovoltron/utility/instrumentation.hpp>
 #include <biovoltron/utility/istring.hpp>
 #include <execution>
 
@@ -33,6 +34,8 @@ struct StableSorter {
    * @return The sorted suffix array.
    */
   static auto get_sa(istring_view ref) {
+    BIOVOLTRON_TIMED_SCOPE(timer, "stable_sorter/get_sa");
+    BIOVOLTRON_TIMER_ADD(timer, ref.size() + 1, ref.size());
     auto sa = std::vector<size_type>(ref.size() + 1);
     std::iota(sa.begin(), sa.end(), 0);
     std::stable_sort(std::execution::par_unseq, sa.begin(), sa.end(),
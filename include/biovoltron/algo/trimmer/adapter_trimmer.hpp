@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <biovoltron/algo/trimmer/core/trimmer.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace biovoltron {
+
+namespace detail {
+
+/**
+ * @brief A DNA sequence packed into three bit planes.
+ *
+ * Bit i of lo and hi hold the two bits of base i, bit i of n is set if base
+ * i is not one of A, C, G and T. Two sequences are compared 64 bases at a
+ * time by xoring their planes.
+ */
+struct BitPlanes {
+  std::vector<std::uint64_t> lo, hi, n;
+
+  static auto to_code(char c) noexcept {
+    return static_cast<std::uint8_t>(c) < 128 ? Codec::to_int(c) : ichar{4};
+  }
+
+  static auto to_code(ichar c) noexcept {
+    return c < 0 || c > 3 ? ichar{4} : c;
+  }
+
+  template <class Char> auto assign(std::basic_string_view<Char> seq) {
+    const auto words = seq.size() / 64 + 2;
+    lo.assign(words, 0);
+    hi.assign(words, 0);
+    n.assign(words, 0);
+    for (auto i = std::size_t{}; i < seq.size(); i++) {
+      const auto code = static_cast<std::uint64_t>(to_code(seq[i]));
+      const auto bit = i % 64;
+      lo[i / 64] |= (code & 1) << bit;
+      hi[i / 64] |= (code >> 1 & 1) << bit;
+      n[i / 64] |= std::uint64_t{code == 4} << bit;
+    }
+  }
+
+  /**
+   * @brief The 64 bits of plane starting at bit pos.
+   */
+  static auto window(const std::vector<std::uint64_t> &plane,
+                     std::size_t pos) noexcept {
+    const auto k = pos / 64, shift = pos % 64;
+    if (shift == 0)
+      return plane[k];
+    return plane[k] >> shift | plane[k + 1] << (64 - shift);
+  }
+};
+
+} // namespace detail
+
+/**
+ * @ingroup trimmer
+ * @brief Adapter trimmer based on bit-parallel mismatch counting.
+ *
+ * The read is cut at the leftmost position from which the read suffix
+ * matches a prefix of the adapter (or the whole adapter) with at most
+ * `max_error_rate` mismatches per overlapping base, provided the overlap
+ * is at least `min_overlap` bases long. N bases always count as
+ * mismatches.
+ *
+ * Read and adapter are packed into bit planes, so the mismatches of 64
+ * overlapping bases are counted with a few xors and one popcount, and the
+ * comparison of a candidate position stops as soon as the allowed number
+ * of mismatches is exceeded.
+ *
+ * Example
+ * ```cpp
+ * auto trimmer = biovoltron::AdapterTrimmer{"AGATCGGAAGAGC"};
+ * auto trimmed = trimmer(read);
+ * ```
+ */
+class AdapterTrimmer {
+  istring adapter_;
+  detail::BitPlanes planes_;
+
+public:
+  /**
+   * @brief Maximum fraction of mismatches within the overlap.
+   */
+  double max_error_rate;
+
+  /**
+   * @brief Minimum overlap between read and adapter.
+   */
+  std::size_t min_overlap;
+
+  explicit AdapterTrimmer(istring_view adapter, double max_error_rate = 0.1,
+                          std::size_t min_overlap = 3)
+      : adapter_(adapter), max_error_rate(max_error_rate),
+        min_overlap(std::max<std::size_t>(min_overlap, 1)) {
+    planes_.assign(istring_view{adapter_});
+  }
+
+  explicit AdapterTrimmer(std::string_view adapter,
+                          double max_error_rate = 0.1,
+                          std::size_t min_overlap = 3)
+      : AdapterTrimmer(Codec::to_istring(adapter), max_error_rate,
+                       min_overlap) {}
+
+  /**
+   * @brief The adapter sequence.
+   */
+  auto adapter() const noexcept { return istring_view{adapter_}; }
+
+  /**
+   * @brief Position where the adapter starts in seq, or seq.size() if seq
+   * does not contain the adapter.
+   */
+  template <class Char>
+  auto find(std::basic_string_view<Char> seq) const {
+    thread_local auto read = detail::BitPlanes{};
+    if (seq.size() < min_overlap)
+      return seq.size();
+    read.assign(seq);
+
+    for (auto i = std::size_t{}; i + min_overlap <= seq.size(); i++) {
+      const auto overlap = std::min(adapter_.size(), seq.size() - i);
+      const auto allowed = static_cast<int>(overlap * max_error_rate);
+      auto mismatches = 0;
+      for (auto k = std::size_t{}; k * 64 < overlap && mismatches <= allowed;
+           k++) {
+        const auto pos = i + k * 64;
+        const auto diff =
+            (read.window(read.lo, pos) ^ planes_.lo[k]) |
+            (read.window(read.hi, pos) ^ planes_.hi[k]) |
+            read.window(read.n, pos) | planes_.n[k];
+        const auto bits = std::min<std::size_t>(64, overlap - k * 64);
+        const auto mask = bits == 64 ? ~std::uint64_t{}
+                                     : (std::uint64_t{1} << bits) - 1;
+        mismatches += std::popcount(diff & mask);
+      }
+      if (mismatches <= allowed)
+        return i;
+    }
+    return seq.size();
+  }
+
+  /**
+   * @brief Trim the adapter and everything after it from a read.
+   */
+  template <bool Encoded> auto operator()(FastqView<Encoded> read) const {
+    const auto size = find(read.seq);
+    read.seq = read.seq.substr(0, size);
+    read.qual = read.qual.substr(0, size);
+    return read;
+  }
+};
+
+} // namespace biovoltron
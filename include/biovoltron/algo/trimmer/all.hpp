@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @defgroup trimmer trimmer
+ * @ingroup algo
+ * @brief The "trimmer" module removes adapters and low quality bases from
+ *        sequencing reads.
+ *
+ * Every trimmer is a function object taking a view of a read and returning
+ * the part to be kept as a view into the same storage, so no bases or
+ * qualities are copied. Trimmers can be chained and applied to a whole
+ * FastqBatch in parallel with biovoltron::trim:
+ * ```cpp
+ * auto adapter = biovoltron::AdapterTrimmer{"AGATCGGAAGAGC"};
+ * auto quality = biovoltron::QualityTrimmer{.window = 4, .min_quality = 20};
+ * for (auto batch = biovoltron::FastqBatch<>{}; fq >> batch;)
+ *   for (const auto read : biovoltron::trim(batch, adapter, quality))
+ *     std::cout << read.seq << "\n";
+ * ```
+ */
+
+#include <biovoltron/algo/trimmer/adapter_trimmer.hpp>
+#include <biovoltron/algo/trimmer/core/trimmer.hpp>
+#include <biovoltron/algo/trimmer/quality_trimmer.hpp>
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <biovoltron/file_io/fastq_batch.hpp>
+#include <concepts>
+#include <cstdint>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup trimmer
+ * @brief Concept for Trimmer.
+ *
+ * A Trimmer is a function object which takes a view of a read and returns
+ * the part of it to be kept, as a view into the same storage. Trimmers
+ * never copy bases or qualities.
+ *
+ * @tparam T The Trimmer type to be checked.
+ */
+template <typename T>
+concept Trimmer = requires(const T t, FastqView<false> read,
+                           FastqView<true> iread) {
+  { t(read) } -> std::same_as<FastqView<false>>;
+  { t(iread) } -> std::same_as<FastqView<true>>;
+};
+
+/**
+ * @ingroup trimmer
+ * @brief Trim all reads of a batch in parallel.
+ *
+ * The trimmers are applied to each read in the given order.
+ *
+ * @param batch The reads to trim.
+ * @param trimmers The trimmers to apply.
+ * @return Views of the trimmed reads, pointing into the storage of batch.
+ */
+template <bool Encoded, Trimmer... Ts>
+auto trim(const FastqBatch<Encoded> &batch, const Ts &...trimmers) {
+  auto reads = std::vector<FastqView<Encoded>>(batch.size());
+  const auto n = static_cast<std::int64_t>(batch.size());
+#pragma omp parallel for schedule(static)
+  for (auto i = std::int64_t{}; i < n; i++) {
+    auto read = batch[i];
+    ((read = trimmers(read)), ...);
+    reads[i] = read;
+  }
+  return reads;
+}
+
+} // namespace biovoltron
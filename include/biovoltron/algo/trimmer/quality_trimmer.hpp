@@ -0,0 +1,70 @@
+#pragma once
+
+#include <biovoltron/algo/trimmer/core/trimmer.hpp>
+
+namespace biovoltron {
+
+/**
+ * @ingroup trimmer
+ * @brief Sliding-window quality trimmer.
+ *
+ * The read is scanned from the 5' end with a window of `window` bases and
+ * cut at the start of the first window whose mean quality drops below
+ * `min_quality`, then the remaining bases below `min_quality` are removed
+ * from the 3' end. The window sum is updated incrementally, so trimming a
+ * read takes one pass over its qualities.
+ *
+ * Example
+ * ```cpp
+ * auto trimmer = biovoltron::QualityTrimmer{.window = 4, .min_quality = 20};
+ * auto trimmed = trimmer(read);
+ * ```
+ */
+struct QualityTrimmer {
+  /**
+   * @brief Number of bases in the sliding window.
+   */
+  std::size_t window = 4;
+
+  /**
+   * @brief Minimum mean Phred quality of a window.
+   */
+  int min_quality = 20;
+
+  /**
+   * @brief Length of the part of qual to be kept.
+   */
+  auto keep_size(std::string_view qual) const noexcept {
+    const auto w = std::min(window, qual.size());
+    if (w == 0)
+      return qual.size();
+
+    const auto min_char = min_quality + '!';
+    const auto min_sum = static_cast<int>(w) * min_char;
+    auto sum = 0;
+    for (auto i = std::size_t{}; i < w; i++)
+      sum += qual[i];
+    auto size = std::size_t{};
+    while (sum >= min_sum && size + w < qual.size()) {
+      sum += qual[size + w] - qual[size];
+      size++;
+    }
+    size = sum >= min_sum ? qual.size() : size;
+    while (size != 0 && qual[size - 1] < min_char)
+      size--;
+    return size;
+  }
+
+  /**
+   * @brief Trim the low quality 3' part of a read.
+   */
+  template <bool Encoded>
+  auto operator()(FastqView<Encoded> read) const noexcept {
+    const auto size = keep_size(read.qual);
+    read.seq = read.seq.substr(0, size);
+    read.qual = read.qual.substr(0, size);
+    return read;
+  }
+};
+
+} // namespace biovoltron
@@ -10,4 +10,5 @@
  * in bioinformatics applications.
  */
 
+#include <biovoltron/container/record_columns.hpp>
 #include <biovoltron/container/xbit_vector.hpp>
@@ -0,0 +1,327 @@
+#pragma once
+
+#include <algorithm>
+#include <biovoltron/file_io/core/record.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace biovoltron {
+
+namespace detail {
+
+/**
+ * @brief Strings of one column concatenated into a single arena.
+ *
+ * String i is `arena[offsets[i], offsets[i + 1])`, so a column of short
+ * strings costs one allocation instead of one per string.
+ */
+template <class Char> struct StringColumn {
+  using value_type = std::basic_string_view<Char>;
+
+  std::basic_string<Char> arena;
+  std::vector<std::size_t> offsets = {0};
+
+  auto size() const noexcept { return offsets.size() - 1; }
+
+  auto clear() noexcept {
+    arena.clear();
+    offsets.resize(1);
+  }
+
+  auto reserve(std::size_t n) { offsets.reserve(n + 1); }
+
+  auto push_back(value_type s) {
+    arena += s;
+    offsets.push_back(arena.size());
+  }
+
+  auto append(const StringColumn &other) {
+    const auto base = arena.size();
+    arena += other.arena;
+    for (auto offset : other.offsets | std::views::drop(1))
+      offsets.push_back(base + offset);
+  }
+
+  value_type operator[](std::size_t i) const noexcept {
+    return value_type{arena}.substr(offsets[i], offsets[i + 1] - offsets[i]);
+  }
+};
+
+template <class T> struct column_type {
+  using type = std::vector<T>;
+};
+
+template <> struct column_type<std::string> {
+  using type = StringColumn<char>;
+};
+
+template <> struct column_type<istring> {
+  using type = StringColumn<ichar>;
+};
+
+template <class T>
+inline auto append(std::vector<T> &to, const std::vector<T> &from) {
+  to.insert(to.end(), from.begin(), from.end());
+}
+
+template <class Char>
+inline auto append(StringColumn<Char> &to, const StringColumn<Char> &from) {
+  to.append(from);
+}
+
+template <class Column, class Indices>
+inline auto gather(const Column &column, const Indices &indices) {
+  auto result = Column{};
+  result.reserve(indices.size());
+  for (auto i : indices)
+    result.push_back(column[i]);
+  return result;
+}
+
+} // namespace detail
+
+/**
+ * @ingroup container
+ * @brief Columnar (struct-of-arrays) storage of Records.
+ *
+ * The fields of R are found with the same reflection as `operator>>` and
+ * `operator<<` of Record, and every field is stored in a contiguous column
+ * of its own:
+ * - std::string and istring fields are concatenated into one arena per
+ *   column and are accessed as string views,
+ * - all other fields are stored in a std::vector of the field type.
+ *
+ * Scanning a single column therefore touches only the memory of that
+ * column, e.g. all positions of 100M records are a single `std::vector`
+ * which the compiler can vectorize over. Filters and sorts evaluate one
+ * column and gather the selected rows of all columns afterwards.
+ *
+ * The header pointer of a HeaderableRecord is shared by all rows.
+ *
+ * Example
+ * ```cpp
+ * auto bed = std::ifstream{"peaks.bed"};
+ * auto peaks = biovoltron::RecordColumns<BedRecord>{};
+ * for (auto record = BedRecord{}; bed >> record;)
+ *   peaks.push_back(record);
+ *
+ * // Column 1 is the start position.
+ * const auto &starts = peaks.column<1>();
+ * const auto max_start = std::ranges::max(starts);
+ * const auto chr1 =
+ *     peaks.filter<0>([](auto chrom) { return chrom == "chr1"; });
+ * const auto sorted = chr1.sort_by<1>();
+ * ```
+ */
+template <std::derived_from<Record> R> class RecordColumns {
+  using fields_type = decltype(to_tuple(std::declval<R &>()));
+
+  template <std::size_t I>
+  using field_type =
+      std::remove_reference_t<std::tuple_element_t<I, fields_type>>;
+
+  template <class Is> struct columns_of;
+  template <std::size_t... Is> struct columns_of<std::index_sequence<Is...>> {
+    using type =
+        std::tuple<typename detail::column_type<field_type<Is>>::type...>;
+  };
+
+  constexpr static auto has_header = std::derived_from<R, HeaderableRecord>;
+
+  struct NoHeader {};
+  template <class T> struct header_of {
+    using type = NoHeader;
+  };
+  template <std::derived_from<HeaderableRecord> T> struct header_of<T> {
+    using type = decltype(T::header);
+  };
+  using header_type = typename header_of<R>::type;
+
+public:
+  using value_type = R;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Number of columns, the header pointer excluded.
+   */
+  constexpr static auto COLUMNS = std::tuple_size_v<fields_type>;
+
+  /**
+   * @brief Tuple of all columns.
+   */
+  using columns_type =
+      typename columns_of<std::make_index_sequence<COLUMNS>>::type;
+
+private:
+  columns_type columns_;
+  size_type size_{};
+  [[no_unique_address]] header_type header_{};
+
+  template <class F> auto for_each_column(F &&f) {
+    std::apply([&f](auto &...column) { (f(column), ...); }, columns_);
+  }
+
+  template <class F> static auto for_each_index(F &&f) {
+    [&f]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (f(std::integral_constant<std::size_t, Is>{}), ...);
+    }(std::make_index_sequence<COLUMNS>{});
+  }
+
+public:
+  RecordColumns() = default;
+
+  /**
+   * @brief Take over already filled columns.
+   * @throws std::length_error if the columns differ in length.
+   */
+  explicit RecordColumns(columns_type columns) : columns_(std::move(columns)) {
+    size_ = std::get<0>(columns_).size();
+    for_each_column([this](const auto &column) {
+      if (column.size() != size_)
+        throw std::length_error("RecordColumns: columns differ in length");
+    });
+  }
+
+  /**
+   * @brief Number of rows.
+   */
+  auto size() const noexcept { return size_; }
+
+  [[nodiscard]] auto empty() const noexcept { return size_ == 0; }
+
+  /**
+   * @brief Remove all rows while keeping the allocated storage.
+   */
+  auto clear() noexcept {
+    for_each_column([](auto &column) { column.clear(); });
+    size_ = 0;
+  }
+
+  /**
+   * @brief Reserve storage for n rows.
+   */
+  auto reserve(size_type n) {
+    for_each_column([n](auto &column) { column.reserve(n); });
+  }
+
+  /**
+   * @brief Append the fields of record as a new row.
+   */
+  auto push_back(const R &record) {
+    const auto fields = to_tuple(record);
+    for_each_index([this, &fields](auto I) {
+      std::get<I>(columns_).push_back(std::get<I>(fields));
+    });
+    if constexpr (has_header)
+      header_ = record.header;
+    size_++;
+  }
+
+  /**
+   * @brief Append all rows of other.
+   */
+  auto append(const RecordColumns &other) {
+    for_each_index([this, &other](auto I) {
+      detail::append(std::get<I>(columns_), std::get<I>(other.columns_));
+    });
+    size_ += other.size_;
+    if constexpr (has_header)
+      if (other.size_ != 0)
+        header_ = other.header_;
+  }
+
+  /**
+   * @brief The column of the I-th field.
+   *
+   * A std::vector of the field type, or for string fields a column of
+   * string views with `size()` and `operator[]`.
+   */
+  template <std::size_t I> const auto &column() const noexcept {
+    return std::get<I>(columns_);
+  }
+
+  /**
+   * @brief The I-th field of row i, string fields as a string view.
+   */
+  template <std::size_t I> decltype(auto) get(size_type i) const noexcept {
+    return std::get<I>(columns_)[i];
+  }
+
+  /**
+   * @brief Row i materialized into a Record.
+   */
+  auto operator[](size_type i) const {
+    auto record = R{};
+    auto fields = to_tuple(record);
+    for_each_index([this, &fields, i](auto I) {
+      std::get<I>(fields) = field_type<I>(get<I>(i));
+    });
+    if constexpr (has_header)
+      record.header = header_;
+    return record;
+  }
+
+  /**
+   * @brief Rows at the given indices, in the given order.
+   */
+  template <class Indices> auto select(const Indices &indices) const {
+    auto result = RecordColumns{};
+    for_each_index([this, &result, &indices](auto I) {
+      std::get<I>(result.columns_) =
+          detail::gather(std::get<I>(columns_), indices);
+    });
+    result.size_ = std::ranges::size(indices);
+    result.header_ = header_;
+    return result;
+  }
+
+  /**
+   * @brief Indices of the rows whose I-th field satisfies pred.
+   */
+  template <std::size_t I, class Pred> auto find_if(Pred pred) const {
+    const auto &col = column<I>();
+    auto indices = std::vector<size_type>{};
+    for (auto i = size_type{}; i < size_; i++)
+      if (std::invoke(pred, col[i]))
+        indices.push_back(i);
+    return indices;
+  }
+
+  /**
+   * @brief Rows whose I-th field satisfies pred.
+   */
+  template <std::size_t I, class Pred> auto filter(Pred pred) const {
+    return select(find_if<I>(std::move(pred)));
+  }
+
+  /**
+   * @brief Permutation which stably sorts the rows by their I-th field.
+   */
+  template <std::size_t I, class Compare = std::ranges::less>
+  auto order_by(Compare comp = {}) const {
+    const auto &col = column<I>();
+    auto order = std::vector<size_type>(size_);
+    std::iota(order.begin(), order.end(), size_type{});
+    std::ranges::stable_sort(order, [&col, &comp](auto i, auto j) {
+      return std::invoke(comp, col[i], col[j]);
+    });
+    return order;
+  }
+
+  /**
+   * @brief Rows stably sorted by their I-th field.
+   */
+  template <std::size_t I, class Compare = std::ranges::less>
+  auto sort_by(Compare comp = {}) const {
+    return select(order_by<I>(std::move(comp)));
+  }
+};
+
+} // namespace biovoltron
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <bit>
+#include <biovoltron/utility/simd.hpp>
 #include <cassert>
 #include <climits>
 #include <limits>
@@ -288,6 +290,16 @@ struct XbitConstIterator : public XbitIteratorBase<N, Block> {
   }
 };
 
+/**
+ * @brief Ranges of bytes which can be packed into an XbitVector by the SIMD
+ * kernels, e.g. the istring of a sequence.
+ */
+template <class It, std::size_t N>
+concept XbitPackable =
+    (N == 2 || N == 4) && std::endian::native == std::endian::little &&
+    std::contiguous_iterator<It> && std::integral<std::iter_value_t<It>> &&
+    sizeof(std::iter_value_t<It>) == 1;
+
 class XbitVectorBase {
 protected:
   constexpr XbitVectorBase() = default;
@@ -555,6 +567,10 @@ private:
   constexpr void construct_at_end(std::forward_iterator auto first,
                                   std::forward_iterator auto last);
 
+  constexpr void copy_blocks(const XbitVector &v);
+
+  constexpr void fill_at(size_type pos, size_type n, value_type x);
+
   constexpr iterator make_iter(size_type pos) noexcept {
     return iterator(begin_ + pos / xbits_per_block,
                     pos & (xbits_per_block - 1));
@@ -646,7 +662,7 @@ constexpr void XbitVector<N, Block, Allocator>::construct_at_end(size_type n,
                                                                  value_type x) {
   size_type old_size = this->size_;
   this->size_ += n;
-  std::fill_n(make_iter(old_size), n, x);
+  fill_at(old_size, n, x);
 }
 
 template <std::size_t N, std::unsigned_integral Block,
@@ -655,9 +671,53 @@ constexpr void XbitVector<N, Block, Allocator>::construct_at_end(
     std::forward_iterator auto first, std::forward_iterator auto last) {
   size_type old_size = this->size_;
   this->size_ += std::distance(first, last);
+  if constexpr (XbitPackable<decltype(first), N>) {
+    constexpr auto per_byte = CHAR_BIT / N;
+    if (!std::is_constant_evaluated() && old_size % per_byte == 0) {
+      const size_type bulk = (last - first) / per_byte * per_byte;
+      simd::pack<N>(
+          reinterpret_cast<const std::uint8_t *>(std::to_address(first)), bulk,
+          reinterpret_cast<std::uint8_t *>(begin_) + old_size / per_byte);
+      first += bulk;
+      old_size += bulk;
+    }
+  }
   std::copy(first, last, make_iter(old_size));
 }
 
+/**
+ * @brief Copy the blocks of v into this empty vector with enough capacity.
+ */
+template <std::size_t N, std::unsigned_integral Block,
+          std::copy_constructible Allocator>
+constexpr void
+XbitVector<N, Block, Allocator>::copy_blocks(const XbitVector &v) {
+  std::copy_n(v.begin_, v.num_blocks(), begin_);
+  this->size_ = v.size_;
+}
+
+/**
+ * @brief Assign x to n elements starting at pos, whole blocks at once.
+ */
+template <std::size_t N, std::unsigned_integral Block,
+          std::copy_constructible Allocator>
+constexpr void XbitVector<N, Block, Allocator>::fill_at(size_type pos,
+                                                        size_type n,
+                                                        value_type x) {
+  const size_type head =
+      std::min(n, (xbits_per_block - pos % xbits_per_block) % xbits_per_block);
+  std::fill_n(make_iter(pos), head, x);
+  pos += head;
+  n -= head;
+  auto pattern = block_type{};
+  for (auto i = size_type{}; i < xbits_per_block; i++)
+    pattern |= static_cast<block_type>(x & reference::mask) << i * N;
+  const size_type blocks = n / xbits_per_block;
+  std::fill_n(begin_ + pos / xbits_per_block, blocks, pattern);
+  pos += blocks * xbits_per_block;
+  std::fill_n(make_iter(pos), n - blocks * xbits_per_block, x);
+}
+
 template <std::size_t N, std::unsigned_integral Block,
           std::copy_constructible Allocator>
 constexpr XbitVector<N, Block, Allocator>::XbitVector() noexcept(
@@ -805,7 +865,7 @@ constexpr XbitVector<N, Block, Allocator>::XbitVector(const XbitVector &v)
                    v.alloc_)) {
   if (v.size() > 0) {
     vallocate(v.size());
-    construct_at_end(v.begin(), v.end());
+    copy_blocks(v);
   }
 }
 
@@ -816,7 +876,7 @@ constexpr XbitVector<N, Block, Allocator>::XbitVector(const XbitVector &v,
     : cap_(0), alloc_(a) {
   if (v.size() > 0) {
     vallocate(v.size());
-    construct_at_end(v.begin(), v.end());
+    copy_blocks(v);
   }
 }
 
@@ -860,7 +920,7 @@ constexpr XbitVector<N, Block, Allocator>::XbitVector(XbitVector &&v,
     v.cap_ = v.size_ = 0;
   } else if (v.size() > 0) {
     vallocate(v.size());
-    construct_at_end(v.begin(), v.end());
+    copy_blocks(v);
   }
 }
 
@@ -909,7 +969,7 @@ constexpr void XbitVector<N, Block, Allocator>::assign(size_type n,
       v.size_ = n;
       swap(v);
     }
-    std::fill_n(begin(), n, x);
+    fill_at(0, n, x);
   }
   invalidate_all_iterators();
 }
@@ -948,7 +1008,7 @@ constexpr void XbitVector<N, Block, Allocator>::reserve(size_type n) {
   if (n > capacity()) {
     XbitVector v(this->alloc_);
     v.vallocate(n);
-    v.construct_at_end(this->begin(), this->end());
+    v.copy_blocks(*this);
     swap(v);
     invalidate_all_iterators();
   }
@@ -1035,7 +1095,7 @@ XbitVector<N, Block, Allocator>::insert(const_iterator position, size_type n,
     std::copy_backward(position, cend(), v.end());
     swap(v);
   }
-  std::fill_n(r, n, x);
+  fill_at(r - begin(), n, x);
   return r;
 }
 
@@ -1137,20 +1197,18 @@ constexpr void XbitVector<N, Block, Allocator>::resize(size_type sz,
                                                        value_type x) {
   size_type cs = size();
   if (cs < sz) {
-    iterator r;
     size_type c = capacity();
     size_type n = sz - cs;
-    if (n <= c && cs <= c - n) {
-      r = end();
+    if (n <= c && cs <= c - n)
       size_ += n;
-    } else {
+    else {
       XbitVector v(alloc_);
       v.reserve(recommend(size_ + n));
+      v.copy_blocks(*this);
       v.size_ = size_ + n;
-      r = std::copy(cbegin(), cend(), v.begin());
       swap(v);
     }
-    std::fill_n(r, n, x);
+    fill_at(cs, n, x);
   } else
     size_ = sz;
 }
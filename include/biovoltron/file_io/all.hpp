@@ -6,5 +6,9 @@
  * manipulation for sequences, alignments, and variants.
  */
 
+#include <biovoltron/file_io/columnar.hpp>
 #include <biovoltron/file_io/fasta.hpp>
 #include <biovoltron/file_io/fastq.hpp>
+#include <biovoltron/file_io/fastq_batch.hpp>
+#include <biovoltron/file_io/paired_fastq.hpp>
+#include <biovoltron/file_io/prefetch.hpp>
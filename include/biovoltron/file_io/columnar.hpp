@@ -0,0 +1,632 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <biovoltron/container/record_columns.hpp>
+#include <biovoltron/file_io/core/binary.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+namespace biovoltron {
+
+/**
+ * @ingroup file_io
+ * @brief Encodings of a column chunk in a columnar file.
+ */
+enum class ColumnEncoding : std::uint8_t {
+  /// Native bytes of fixed size values, length-prefixed strings.
+  PLAIN,
+  /// Integers as (zigzag) varints.
+  VARINT,
+  /// Non-decreasing integers as varint differences to their predecessor.
+  DELTA,
+  /// Strings as a dictionary of distinct values and varint indices.
+  DICTIONARY
+};
+
+namespace detail::columnar {
+
+constexpr auto MAGIC = std::string_view{"BVCOL\0\0\1", 8};
+constexpr auto TAIL = std::string_view{"BVCOLEND", 8};
+
+/**
+ * @brief Type fingerprint of a column, checked when a file is opened.
+ */
+template <class T> inline auto type_tag() -> std::string {
+  if constexpr (std::same_as<T, std::string>)
+    return "s";
+  else if constexpr (std::same_as<T, istring>)
+    return "q";
+  else if constexpr (is_vector<T>::value)
+    return "v" + type_tag<typename T::value_type>();
+  else {
+    const auto kind = std::floating_point<T> ? 'f'
+                      : std::is_signed_v<T>  ? 'i'
+                                             : 'u';
+    return kind + std::to_string(sizeof(T));
+  }
+}
+
+template <class Column> inline auto column_tag() -> std::string {
+  if constexpr (std::same_as<Column, StringColumn<char>>)
+    return type_tag<std::string>();
+  else if constexpr (std::same_as<Column, StringColumn<ichar>>)
+    return type_tag<istring>();
+  else
+    return type_tag<typename Column::value_type>();
+}
+
+/**
+ * @brief Tags of all columns of R.
+ */
+template <std::derived_from<Record> R> inline auto column_tags() {
+  using columns_type = typename RecordColumns<R>::columns_type;
+  return []<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::vector<std::string>{
+        column_tag<std::tuple_element_t<Is, columns_type>>()...};
+  }(std::make_index_sequence<RecordColumns<R>::COLUMNS>{});
+}
+
+template <class T>
+concept StatsField = std::is_arithmetic_v<T> && sizeof(T) <= 8;
+
+template <std::integral T>
+inline auto to_code(T value) noexcept -> std::uint64_t {
+  if constexpr (std::is_signed_v<T>)
+    return zigzag_encode(value);
+  else
+    return value;
+}
+
+template <std::integral T> inline auto from_code(std::uint64_t code) noexcept {
+  if constexpr (std::is_signed_v<T>)
+    return static_cast<T>(zigzag_decode(code));
+  else
+    return static_cast<T>(code);
+}
+
+template <class T>
+inline auto encode(const std::vector<T> &column, std::string &out) {
+  if constexpr (std::integral<T> && sizeof(T) > 1) {
+    if (std::ranges::is_sorted(column)) {
+      auto prev = T{};
+      for (auto first = true; auto value : column) {
+        if (std::exchange(first, false))
+          put_varint(out, to_code(value));
+        else
+          put_varint(out, static_cast<std::uint64_t>(value) -
+                              static_cast<std::uint64_t>(prev));
+        prev = value;
+      }
+      return ColumnEncoding::DELTA;
+    }
+    for (auto value : column)
+      put_varint(out, to_code(value));
+    return ColumnEncoding::VARINT;
+  } else if constexpr (std::is_arithmetic_v<T> && !std::same_as<T, bool>) {
+    out.append(reinterpret_cast<const char *>(column.data()),
+               column.size() * sizeof(T));
+    return ColumnEncoding::PLAIN;
+  } else {
+    for (const auto &value : column)
+      put_field(out, static_cast<const T &>(value));
+    return ColumnEncoding::PLAIN;
+  }
+}
+
+template <class Char>
+inline auto encode(const StringColumn<Char> &column, std::string &out) {
+  using view = std::basic_string_view<Char>;
+  const auto put_string = [&out](view s) {
+    put_varint(out, s.size());
+    out.append(reinterpret_cast<const char *>(s.data()), s.size());
+  };
+
+  const auto bytes_of = [](view s) {
+    return std::string_view{reinterpret_cast<const char *>(s.data()),
+                            s.size()};
+  };
+
+  auto ids = std::unordered_map<std::string_view, std::uint64_t>{};
+  auto dictionary = std::vector<view>{};
+  for (auto i = std::size_t{}; i < column.size(); i++)
+    if (ids.try_emplace(bytes_of(column[i]), ids.size()).second) {
+      dictionary.push_back(column[i]);
+      if (dictionary.size() * 2 > column.size())
+        break;
+    }
+
+  if (dictionary.size() * 2 <= column.size()) {
+    put_varint(out, dictionary.size());
+    for (auto s : dictionary)
+      put_string(s);
+    for (auto i = std::size_t{}; i < column.size(); i++)
+      put_varint(out, ids[bytes_of(column[i])]);
+    return ColumnEncoding::DICTIONARY;
+  }
+  for (auto i = std::size_t{}; i < column.size(); i++)
+    put_varint(out, column.offsets[i + 1] - column.offsets[i]);
+  out.append(reinterpret_cast<const char *>(column.arena.data()),
+             column.arena.size());
+  return ColumnEncoding::PLAIN;
+}
+
+template <class T>
+inline auto decode(std::string_view in, ColumnEncoding encoding,
+                   std::size_t rows, std::vector<T> &column) {
+  column.resize(rows);
+  if constexpr (std::integral<T> && sizeof(T) > 1) {
+    if (encoding == ColumnEncoding::DELTA) {
+      auto value = T{};
+      for (auto i = std::size_t{}; i < rows; i++) {
+        value = i == 0 ? from_code<T>(get_varint(in))
+                       : static_cast<T>(static_cast<std::uint64_t>(value) +
+                                        get_varint(in));
+        column[i] = value;
+      }
+    } else
+      for (auto &value : column)
+        value = from_code<T>(get_varint(in));
+  } else if constexpr (std::is_arithmetic_v<T> && !std::same_as<T, bool>) {
+    const auto bytes = get_bytes(in, rows * sizeof(T));
+    std::memcpy(column.data(), bytes.data(), bytes.size());
+  } else
+    for (auto i = std::size_t{}; i < rows; i++) {
+      auto value = T{};
+      get_field(in, value);
+      column[i] = std::move(value);
+    }
+}
+
+template <class Char>
+inline auto decode(std::string_view in, ColumnEncoding encoding,
+                   std::size_t rows, StringColumn<Char> &column) {
+  using view = std::basic_string_view<Char>;
+  const auto get_string = [&in] {
+    const auto bytes = get_bytes(in, get_varint(in));
+    return view{reinterpret_cast<const Char *>(bytes.data()), bytes.size()};
+  };
+
+  column.clear();
+  column.reserve(rows);
+  if (encoding == ColumnEncoding::DICTIONARY) {
+    const auto entries = get_varint(in);
+    if (entries > in.size())
+      throw std::runtime_error("ColumnarReader: corrupted dictionary");
+    auto dictionary = std::vector<view>(entries);
+    for (auto &s : dictionary)
+      s = get_string();
+    for (auto i = std::size_t{}; i < rows; i++) {
+      const auto id = get_varint(in);
+      if (id >= dictionary.size())
+        throw std::runtime_error("ColumnarReader: corrupted dictionary");
+      column.push_back(dictionary[id]);
+    }
+  } else {
+    auto total = std::size_t{};
+    for (auto i = std::size_t{}; i < rows; i++)
+      column.offsets.push_back(total += get_varint(in));
+    const auto bytes = get_bytes(in, total);
+    column.arena.assign(reinterpret_cast<const Char *>(bytes.data()), total);
+  }
+}
+
+} // namespace detail::columnar
+
+/**
+ * @ingroup file_io
+ * @brief Writes Records into a binary columnar file.
+ *
+ * The file layout is derived from the fields of R, as reflected by
+ * `to_tuple`. Records are buffered into blocks of `rows_per_block` rows,
+ * and every column of a block is stored as one chunk:
+ * - non-decreasing integers are delta encoded, other integers are stored as
+ *   zigzag varints,
+ * - floating point values are stored as raw bytes,
+ * - string columns with few distinct values are dictionary encoded, others
+ *   are stored as lengths followed by the characters,
+ * - every chunk is deflate compressed if that makes it smaller.
+ *
+ * For arithmetic columns the minimum and maximum of every block are kept,
+ * so readers can skip blocks without decoding them. All block offsets and
+ * statistics are written into a footer at the end of the file, which is
+ * closed when `close()` is called or the writer is destroyed.
+ *
+ * The header pointer of a HeaderableRecord is not stored.
+ *
+ * Example
+ * ```cpp
+ * auto os = std::ofstream{"peaks.bvc", std::ios::binary};
+ * auto writer = biovoltron::ColumnarWriter<BedRecord>{os};
+ * for (const auto &record : records)
+ *   writer.write(record);
+ * writer.close();
+ * ```
+ */
+template <std::derived_from<Record> R> class ColumnarWriter {
+  std::ostream *os_;
+  std::size_t rows_per_block_;
+  int level_;
+  RecordColumns<R> block_;
+  std::string footer_;
+  std::string chunk_;
+  std::string compressed_;
+  std::uint64_t offset_ = 0;
+  std::uint64_t blocks_ = 0;
+  bool closed_ = false;
+
+  auto write_bytes(std::string_view bytes) {
+    os_->write(bytes.data(), bytes.size());
+    offset_ += bytes.size();
+  }
+
+  template <class Column> auto write_chunk(const Column &column) {
+    chunk_.clear();
+    const auto encoding = detail::columnar::encode(column, chunk_);
+
+    auto bytes = std::string_view{chunk_};
+    auto bound = compressBound(chunk_.size());
+    compressed_.resize(bound);
+    const auto deflated =
+        level_ != Z_NO_COMPRESSION &&
+        compress2(reinterpret_cast<Bytef *>(compressed_.data()), &bound,
+                  reinterpret_cast<const Bytef *>(chunk_.data()),
+                  chunk_.size(), level_) == Z_OK &&
+        bound < chunk_.size();
+    if (deflated)
+      bytes = std::string_view{compressed_}.substr(0, bound);
+
+    detail::put_raw(footer_, static_cast<std::uint8_t>(encoding));
+    detail::put_raw(footer_, static_cast<std::uint8_t>(deflated));
+    detail::put_varint(footer_, offset_);
+    detail::put_varint(footer_, bytes.size());
+    detail::put_varint(footer_, chunk_.size());
+    write_bytes(bytes);
+  }
+
+  template <class T> auto write_stats(const std::vector<T> &column) {
+    if constexpr (detail::columnar::StatsField<T>) {
+      const auto [min, max] = std::ranges::minmax(column);
+      detail::put_raw(footer_, min);
+      detail::put_raw(footer_, max);
+    }
+  }
+
+  template <class Char> auto write_stats(const detail::StringColumn<Char> &) {}
+
+public:
+  /**
+   * @param os Binary output stream.
+   * @param rows_per_block Number of records per block.
+   * @param compression_level zlib compression level, Z_NO_COMPRESSION
+   * disables compression.
+   */
+  explicit ColumnarWriter(std::ostream &os, std::size_t rows_per_block = 65536,
+                          int compression_level = Z_DEFAULT_COMPRESSION)
+      : os_(&os), rows_per_block_(std::max<std::size_t>(rows_per_block, 1)),
+        level_(compression_level) {
+    write_bytes(detail::columnar::MAGIC);
+    detail::put_varint(footer_, RecordColumns<R>::COLUMNS);
+    for (const auto &tag : detail::columnar::column_tags<R>())
+      detail::put_field(footer_, tag);
+  }
+
+  ColumnarWriter(const ColumnarWriter &) = delete;
+  ColumnarWriter &operator=(const ColumnarWriter &) = delete;
+
+  ~ColumnarWriter() {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  /**
+   * @brief Append a record, a full block is written out immediately.
+   */
+  auto write(const R &record) {
+    block_.push_back(record);
+    if (block_.size() == rows_per_block_)
+      flush_block();
+  }
+
+  /**
+   * @brief Write the buffered records as a block, even if it is not full.
+   */
+  auto flush_block() -> void {
+    if (block_.empty())
+      return;
+    detail::put_varint(footer_, block_.size());
+    [this]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((write_chunk(block_.template column<Is>()),
+        write_stats(block_.template column<Is>())),
+       ...);
+    }(std::make_index_sequence<RecordColumns<R>::COLUMNS>{});
+    blocks_++;
+    block_.clear();
+  }
+
+  /**
+   * @brief Write the last block and the footer, further writes are ignored.
+   */
+  auto close() -> void {
+    if (std::exchange(closed_, true))
+      return;
+    flush_block();
+    auto footer = std::string{};
+    detail::put_varint(footer, blocks_);
+    footer += footer_;
+    write_bytes(footer);
+    auto tail = std::string{};
+    detail::put_raw(tail, static_cast<std::uint64_t>(footer.size()));
+    write_bytes(tail);
+    write_bytes(detail::columnar::TAIL);
+    os_->flush();
+  }
+};
+
+/**
+ * @ingroup file_io
+ * @brief Reads a binary columnar file written by ColumnarWriter.
+ *
+ * A file is memory mapped and only the footer is parsed when it is opened,
+ * column chunks are decompressed and decoded on request. The minimum and
+ * maximum of arithmetic columns allow to select the blocks which may hold
+ * matching records before any of them is decoded.
+ *
+ * Example
+ * ```cpp
+ * auto reader = biovoltron::ColumnarReader<BedRecord>{"peaks.bvc"};
+ * for (auto b : reader.blocks_overlapping<1>(1000000, 2000000)) {
+ *   const auto block = reader.read_block(b);
+ *   // ...
+ * }
+ * ```
+ */
+template <std::derived_from<Record> R> class ColumnarReader {
+public:
+  constexpr static auto COLUMNS = RecordColumns<R>::COLUMNS;
+  using columns_type = typename RecordColumns<R>::columns_type;
+
+private:
+  struct Chunk {
+    ColumnEncoding encoding;
+    bool deflated;
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint64_t raw_size;
+    std::array<char, 8> min{};
+    std::array<char, 8> max{};
+  };
+
+  struct InMemory {};
+
+  std::string_view data_;
+  void *map_ = nullptr;
+  std::vector<std::size_t> block_rows_;
+  std::vector<std::array<Chunk, COLUMNS>> chunks_;
+  std::size_t rows_{};
+
+  template <std::size_t I>
+  using column_type = std::tuple_element_t<I, columns_type>;
+
+  auto parse_footer() {
+    namespace columnar = detail::columnar;
+    const auto bad = [] {
+      return std::runtime_error("ColumnarReader: not a columnar file");
+    };
+    // [MAGIC][chunks...][footer][footer size: u64][TAIL]
+    const auto trailer_size = 8 + columnar::TAIL.size();
+    if (data_.size() < columnar::MAGIC.size() + trailer_size ||
+        !data_.starts_with(columnar::MAGIC) || !data_.ends_with(columnar::TAIL))
+      throw bad();
+    auto trailer = data_.substr(data_.size() - trailer_size);
+    const auto footer_size = detail::get_raw<std::uint64_t>(trailer);
+    if (footer_size > data_.size() - columnar::MAGIC.size() - trailer_size)
+      throw bad();
+    auto in =
+        data_.substr(data_.size() - trailer_size - footer_size, footer_size);
+
+    const auto blocks = detail::get_varint(in);
+    if (detail::get_varint(in) != COLUMNS)
+      throw std::runtime_error("ColumnarReader: column count differs");
+    for (auto tag = std::string{}; const auto &expected :
+                                   columnar::column_tags<R>())
+      if (detail::get_field(in, tag); tag != expected)
+        throw std::runtime_error("ColumnarReader: column types differ");
+
+    for (auto b = std::uint64_t{}; b < blocks; b++) {
+      rows_ += block_rows_.emplace_back(detail::get_varint(in));
+      auto &chunks = chunks_.emplace_back();
+      [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        ((read_chunk<Is>(in, chunks[Is])), ...);
+      }(std::make_index_sequence<COLUMNS>{});
+      // Every encoding takes at least one byte per row.
+      for (const auto &chunk : chunks)
+        if (block_rows_.back() > chunk.raw_size)
+          throw bad();
+    }
+  }
+
+  template <std::size_t I> auto read_chunk(std::string_view &in, Chunk &chunk) {
+    chunk.encoding = static_cast<ColumnEncoding>(
+        detail::get_raw<std::uint8_t>(in));
+    chunk.deflated = detail::get_raw<std::uint8_t>(in);
+    chunk.offset = detail::get_varint(in);
+    chunk.size = detail::get_varint(in);
+    chunk.raw_size = detail::get_varint(in);
+    if (chunk.offset > data_.size() || chunk.size > data_.size() - chunk.offset)
+      throw std::runtime_error("ColumnarReader: chunk out of range");
+    // Deflate expands at most 1032 times, so raw sizes of corrupted files
+    // are caught before they are allocated.
+    if (chunk.deflated ? chunk.raw_size / 1032 > chunk.size
+                       : chunk.raw_size != chunk.size)
+      throw std::runtime_error("ColumnarReader: chunk out of range");
+    using T = typename column_type<I>::value_type;
+    if constexpr (is_stats_column<I>) {
+      std::ranges::copy(detail::get_bytes(in, sizeof(T)), chunk.min.begin());
+      std::ranges::copy(detail::get_bytes(in, sizeof(T)), chunk.max.begin());
+    }
+  }
+
+  template <std::size_t I>
+  constexpr static auto is_stats_column =
+      !std::same_as<column_type<I>, detail::StringColumn<char>> &&
+      !std::same_as<column_type<I>, detail::StringColumn<ichar>> &&
+      detail::columnar::StatsField<typename column_type<I>::value_type>;
+
+  ColumnarReader(std::string_view data, InMemory) : data_(data) {
+    parse_footer();
+  }
+
+public:
+  /**
+   * @brief Open a columnar file by memory mapping it.
+   * @throws std::runtime_error if the file cannot be mapped or is not a
+   * columnar file of R.
+   */
+  explicit ColumnarReader(const std::filesystem::path &path) {
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("ColumnarReader: cannot open " + path.string());
+    struct stat st {};
+    const auto size = ::fstat(fd, &st) == 0 ? std::size_t(st.st_size) : 0;
+    if (size != 0)
+      map_ = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map_ == MAP_FAILED || map_ == nullptr) {
+      map_ = nullptr;
+      throw std::runtime_error("ColumnarReader: cannot map " + path.string());
+    }
+    data_ = {static_cast<const char *>(map_), size};
+    try {
+      parse_footer();
+    } catch (...) {
+      ::munmap(map_, data_.size());
+      throw;
+    }
+  }
+
+  /**
+   * @brief Read a columnar file held in memory, data has to outlive the
+   * reader.
+   * @throws std::runtime_error if data is not a columnar file of R.
+   */
+  static auto from_memory(std::string_view data) {
+    return ColumnarReader{data, InMemory{}};
+  }
+
+  ColumnarReader(const ColumnarReader &) = delete;
+  ColumnarReader &operator=(const ColumnarReader &) = delete;
+
+  ~ColumnarReader() {
+    if (map_ != nullptr)
+      ::munmap(map_, data_.size());
+  }
+
+  /**
+   * @brief Number of records in the file.
+   */
+  auto size() const noexcept { return rows_; }
+
+  /**
+   * @brief Number of blocks in the file.
+   */
+  auto blocks() const noexcept { return block_rows_.size(); }
+
+  /**
+   * @brief Number of records in block b.
+   */
+  auto block_size(std::size_t b) const { return block_rows_.at(b); }
+
+  /**
+   * @brief Encoding of the I-th column of block b.
+   */
+  template <std::size_t I> auto encoding(std::size_t b) const {
+    return chunks_.at(b)[I].encoding;
+  }
+
+  /**
+   * @brief Minimum and maximum of the I-th column in block b.
+   */
+  template <std::size_t I>
+    requires is_stats_column<I>
+  auto stats(std::size_t b) const {
+    using T = typename column_type<I>::value_type;
+    const auto &chunk = chunks_.at(b)[I];
+    auto min = T{}, max = T{};
+    std::memcpy(&min, chunk.min.data(), sizeof(T));
+    std::memcpy(&max, chunk.max.data(), sizeof(T));
+    return std::pair{min, max};
+  }
+
+  /**
+   * @brief Blocks whose I-th column may hold values in [lo, hi].
+   */
+  template <std::size_t I>
+    requires is_stats_column<I>
+  auto blocks_overlapping(typename column_type<I>::value_type lo,
+                          typename column_type<I>::value_type hi) const {
+    auto result = std::vector<std::size_t>{};
+    for (auto b = std::size_t{}; b < blocks(); b++)
+      if (const auto [min, max] = stats<I>(b); !(max < lo || hi < min))
+        result.push_back(b);
+    return result;
+  }
+
+  /**
+   * @brief Decode the I-th column of block b.
+   */
+  template <std::size_t I> auto read_column(std::size_t b) const {
+    const auto &chunk = chunks_.at(b)[I];
+    auto bytes = data_.substr(chunk.offset, chunk.size);
+    thread_local auto inflated = std::string{};
+    if (chunk.deflated) {
+      inflated.resize(chunk.raw_size);
+      auto size = static_cast<uLongf>(chunk.raw_size);
+      if (uncompress(reinterpret_cast<Bytef *>(inflated.data()), &size,
+                     reinterpret_cast<const Bytef *>(bytes.data()),
+                     bytes.size()) != Z_OK ||
+          size != chunk.raw_size)
+        throw std::runtime_error("ColumnarReader: corrupted chunk");
+      bytes = inflated;
+    }
+    auto column = column_type<I>{};
+    detail::columnar::decode(bytes, chunk.encoding, block_rows_[b], column);
+    return column;
+  }
+
+  /**
+   * @brief Decode all columns of block b.
+   */
+  auto read_block(std::size_t b) const {
+    return [this, b]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return RecordColumns<R>{columns_type{read_column<Is>(b)...}};
+    }(std::make_index_sequence<COLUMNS>{});
+  }
+
+  /**
+   * @brief Decode all blocks.
+   */
+  auto read_all() const {
+    auto result = RecordColumns<R>{};
+    result.reserve(rows_);
+    for (auto b = std::size_t{}; b < blocks(); b++)
+      result.append(read_block(b));
+    return result;
+  }
+};
+
+} // namespace biovoltron
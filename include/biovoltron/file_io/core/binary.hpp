@@ -0,0 +1,139 @@
+#pragma once
+
+#include <biovoltron/file_io/core/field.hpp>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace biovoltron::detail {
+
+/**
+ * @brief Map signed integers to unsigned ones so that values of small
+ * magnitude get small codes (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...).
+ */
+constexpr auto zigzag_encode(std::int64_t value) noexcept {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+constexpr auto zigzag_decode(std::uint64_t code) noexcept {
+  return static_cast<std::int64_t>(code >> 1) ^
+         -static_cast<std::int64_t>(code & 1);
+}
+
+/**
+ * @brief Append value as LEB128 varint, 7 bits per byte.
+ */
+inline auto put_varint(std::string &out, std::uint64_t value) {
+  for (; value >= 0x80; value >>= 7)
+    out += static_cast<char>(value | 0x80);
+  out += static_cast<char>(value);
+}
+
+/**
+ * @brief Consume a LEB128 varint from the front of in.
+ * @throws std::runtime_error if in ends in the middle of the varint.
+ */
+inline auto get_varint(std::string_view &in) {
+  auto value = std::uint64_t{};
+  for (auto shift = 0; shift < 64; shift += 7) {
+    if (in.empty())
+      break;
+    const auto byte = static_cast<std::uint8_t>(in.front());
+    in.remove_prefix(1);
+    value |= std::uint64_t{byte & 0x7fu} << shift;
+    if (byte < 0x80)
+      return value;
+  }
+  throw std::runtime_error("binary: truncated varint");
+}
+
+/**
+ * @brief Append the bytes of a trivially copyable value.
+ */
+template <class T>
+  requires std::is_trivially_copyable_v<T>
+inline auto put_raw(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * @brief Consume the bytes of a trivially copyable value from in.
+ * @throws std::runtime_error if in holds fewer than sizeof(T) bytes.
+ */
+template <class T>
+  requires std::is_trivially_copyable_v<T>
+inline auto get_raw(std::string_view &in) {
+  if (in.size() < sizeof(T))
+    throw std::runtime_error("binary: truncated value");
+  auto value = T{};
+  std::memcpy(&value, in.data(), sizeof(T));
+  in.remove_prefix(sizeof(T));
+  return value;
+}
+
+/**
+ * @brief Consume n bytes from in.
+ * @throws std::runtime_error if in holds fewer than n bytes.
+ */
+inline auto get_bytes(std::string_view &in, std::size_t n) {
+  if (in.size() < n)
+    throw std::runtime_error("binary: truncated bytes");
+  const auto bytes = in.substr(0, n);
+  in.remove_prefix(n);
+  return bytes;
+}
+
+template <class T>
+concept BinaryField =
+    std::is_arithmetic_v<T> || std::same_as<T, std::string> ||
+    std::same_as<T, istring> ||
+    (is_vector<T>::value && !std::same_as<T, std::vector<bool>>);
+
+/**
+ * @brief Append the binary encoding of one field.
+ *
+ * Arithmetic values are stored as their native bytes, strings as their
+ * varint length followed by their characters and vectors as their varint
+ * size followed by their elements.
+ */
+template <BinaryField T>
+inline auto put_field(std::string &out, const T &field) {
+  if constexpr (std::is_arithmetic_v<T>)
+    put_raw(out, field);
+  else if constexpr (std::same_as<T, std::string> || std::same_as<T, istring>) {
+    put_varint(out, field.size());
+    out.append(reinterpret_cast<const char *>(field.data()), field.size());
+  } else {
+    put_varint(out, field.size());
+    for (const auto &element : field)
+      put_field(out, element);
+  }
+}
+
+/**
+ * @brief Consume the binary encoding of one field written by put_field.
+ */
+template <BinaryField T> inline auto get_field(std::string_view &in, T &field) {
+  if constexpr (std::is_arithmetic_v<T>)
+    field = get_raw<T>(in);
+  else if constexpr (std::same_as<T, std::string> || std::same_as<T, istring>) {
+    const auto bytes = get_bytes(in, get_varint(in));
+    field.assign(reinterpret_cast<const typename T::value_type *>(bytes.data()),
+                 bytes.size());
+  } else {
+    // Every element takes at least one byte.
+    const auto size = get_varint(in);
+    if (size > in.size())
+      throw std::runtime_error("binary: truncated field");
+    field.resize(size);
+    for (auto &element : field)
+      get_field(in, element);
+  }
+}
+
+} // namespace biovoltron::detail
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <biovoltron/utility/istring.hpp>
+#include <charconv>
+#include <concepts>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace biovoltron::detail {
+
+template <class T> struct is_vector : std::false_type {};
+
+template <class T, class A>
+struct is_vector<std::vector<T, A>> : std::true_type {};
+
+template <class T>
+concept CharField = std::same_as<T, char> || std::same_as<T, signed char> ||
+                    std::same_as<T, unsigned char>;
+
+/**
+ * @brief Splits a line into tab-delimited fields without copying.
+ *
+ * The delimiter search goes through `std::string_view::find`, which is
+ * implemented with the vectorized `memchr` of the C library.
+ */
+struct FieldSplitter {
+  std::string_view line;
+  std::size_t pos = 0;
+
+  /**
+   * @brief Whether all fields have been consumed.
+   */
+  auto empty() const noexcept { return pos > line.size(); }
+
+  /**
+   * @brief The next field, or an empty field if all have been consumed.
+   */
+  auto next() noexcept {
+    if (empty())
+      return std::string_view{};
+    auto end = line.find('\t', pos);
+    if (end == std::string_view::npos)
+      end = line.size();
+    const auto field = line.substr(pos, end - pos);
+    pos = end + 1;
+    return field;
+  }
+};
+
+/**
+ * @brief Convert the text of one field into field.
+ *
+ * Arithmetic types are converted with `std::from_chars` and strings reuse
+ * their storage, so no allocation takes place for them. Other types fall
+ * back to their `operator>>`.
+ */
+template <class T>
+inline auto parse_field(std::string_view text, T &field) -> void {
+  if constexpr (std::same_as<T, std::string>)
+    field.assign(text);
+  else if constexpr (std::same_as<T, istring>) {
+    field.resize(text.size());
+    std::ranges::transform(text, field.begin(), Codec::to_int);
+  } else if constexpr (CharField<T>)
+    field = text.empty() ? T{} : static_cast<T>(text.front());
+  else if constexpr (std::same_as<T, bool>) {
+    auto value = 0;
+    std::from_chars(text.data(), text.data() + text.size(), value);
+    field = value != 0;
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    if (text.starts_with('+'))
+      text.remove_prefix(1);
+    field = T{};
+    std::from_chars(text.data(), text.data() + text.size(), field);
+  } else {
+    thread_local auto iss = std::istringstream{};
+    iss.clear();
+    iss.str(std::string{text});
+    field = T{};
+    iss >> field;
+  }
+}
+
+/**
+ * @brief Convert the next field of fields into field.
+ *
+ * A std::vector consumes all remaining fields, reusing its elements. A
+ * written record ends with a tab, so a single trailing empty field is not
+ * an element, and an empty remainder is an empty vector.
+ */
+template <class T>
+inline auto parse_next_field(FieldSplitter &fields, T &field) -> void {
+  if constexpr (is_vector<T>::value) {
+    if (fields.line.ends_with('\t'))
+      fields.line.remove_suffix(1);
+    if (fields.pos == fields.line.size())
+      fields.pos++;
+    auto size = std::size_t{};
+    for (; !fields.empty(); size++) {
+      if (size == field.size())
+        field.emplace_back();
+      parse_field(fields.next(), field[size]);
+    }
+    field.resize(size);
+  } else
+    parse_field(fields.next(), field);
+}
+
+/**
+ * @brief Append the text of field to out.
+ *
+ * Arithmetic types are formatted with `std::to_chars`, floating point
+ * values with the given precision in the same format as `std::ostream`
+ * uses by default. Other types fall back to their `operator<<`.
+ */
+template <class T>
+inline auto format_field(std::string &out, const T &field, int precision = 6)
+    -> void {
+  if constexpr (std::same_as<T, std::string> ||
+                std::same_as<T, std::string_view>)
+    out += field;
+  else if constexpr (std::same_as<T, istring> || std::same_as<T, istring_view>)
+    for (auto c : field)
+      out += Codec::to_char(c);
+  else if constexpr (CharField<T>)
+    out += static_cast<char>(field);
+  else if constexpr (std::same_as<T, bool>)
+    out += field ? '1' : '0';
+  else if constexpr (std::is_arithmetic_v<T>) {
+    auto buf = std::array<char, 64>{};
+    auto result = std::to_chars_result{};
+    if constexpr (std::is_floating_point_v<T>)
+      result = std::to_chars(buf.data(), buf.data() + buf.size(), field,
+                             std::chars_format::general, precision);
+    else
+      result = std::to_chars(buf.data(), buf.data() + buf.size(), field);
+    out.append(buf.data(), result.ptr);
+  } else if constexpr (is_vector<T>::value) {
+    for (auto first = true; const auto &element : field) {
+      if (!std::exchange(first, false))
+        out += '\t';
+      format_field(out, element, precision);
+    }
+  } else {
+    thread_local auto oss = std::ostringstream{};
+    oss.str({});
+    oss.precision(precision);
+    oss << field;
+    out += oss.view();
+  }
+}
+
+} // namespace biovoltron::detail
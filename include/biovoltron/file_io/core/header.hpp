@@ -1,9 +1,14 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <istream>
 #include <ostream>
 #include <ranges>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace biovoltron {
 
@@ -17,20 +22,101 @@ inline auto operator==(const H &lhs, const H &rhs) noexcept {
   return lhs.lines == rhs.lines;
 }
 
+namespace detail {
+
+/**
+ * @brief Gives access to the characters buffered by a streambuf.
+ */
+struct BufferedChars : std::streambuf {
+  /**
+   * @brief The characters which can be read from buf without consuming
+   * them, empty at the end of the stream.
+   *
+   * At least one character is returned unless the stream is at its end,
+   * the get area is filled first if it is empty.
+   */
+  static auto peek(std::streambuf &buf, char &single) {
+    const auto c = buf.sgetc();
+    if (c == traits_type::eof())
+      return std::string_view{};
+    constexpr auto gptr = &BufferedChars::gptr;
+    constexpr auto egptr = &BufferedChars::egptr;
+    if ((buf.*gptr)() == nullptr) {
+      single = traits_type::to_char_type(c);
+      return std::string_view{&single, 1};
+    }
+    return std::string_view{(buf.*gptr)(),
+                            static_cast<std::size_t>((buf.*egptr)() -
+                                                     (buf.*gptr)())};
+  }
+};
+
+enum class LineKind { HEADER, RECORD, UNKNOWN, END };
+
+/**
+ * @brief Classify the next line by the characters already buffered.
+ *
+ * UNKNOWN is returned if the buffer ends before it can be decided whether
+ * the line starts with one of the start symbols.
+ */
+template <std::derived_from<Header> H>
+inline auto peek_line_kind(std::istream &is) {
+  auto single = char{};
+  const auto buffered = BufferedChars::peek(*is.rdbuf(), single);
+  if (buffered.empty())
+    return LineKind::END;
+  auto kind = LineKind::RECORD;
+  for (const auto symbol : H::START_SYMBOLS) {
+    const auto prefix = std::string_view{symbol};
+    if (buffered.starts_with(prefix))
+      return LineKind::HEADER;
+    if (buffered.size() < prefix.size() && prefix.starts_with(buffered))
+      kind = LineKind::UNKNOWN;
+  }
+  return kind;
+}
+
+} // namespace detail
+
+/**
+ * @brief
+ * Read all leading lines which start with one of `H::START_SYMBOLS`.
+ *
+ * Whether a line belongs to the header is decided by looking at its first
+ * characters in the buffer of the stream, so the first record is left
+ * unread without seeking and headers can be read from pipes and
+ * decompressing streams. Only if the buffer ends within a start symbol the
+ * line is read and, if it is not a header line, the stream is seeked back.
+ * A non-seekable stream cannot give such a line back, so its failbit is
+ * set instead of losing the first record.
+ */
 template <std::derived_from<Header> H>
 inline auto &operator>>(std::istream &is, H &header) {
   header.lines.clear();
-  auto pos = is.tellg();
-  for (auto line = std::string{}; std::getline(is, line);) {
-    if (std::ranges::any_of(header.START_SYMBOLS, [&line](auto symbol) {
+  if (!is)
+    return is;
+  for (auto line = std::string{};;) {
+    const auto kind = detail::peek_line_kind<H>(is);
+    if (kind == detail::LineKind::END || kind == detail::LineKind::RECORD)
+      break;
+    const auto pos = kind == detail::LineKind::UNKNOWN
+                         ? is.tellg()
+                         : std::istream::pos_type(-1);
+    if (!std::getline(is, line))
+      break;
+    if (kind == detail::LineKind::UNKNOWN &&
+        std::ranges::none_of(header.START_SYMBOLS, [&line](auto symbol) {
           return line.starts_with(symbol);
         })) {
-      header.lines.push_back(std::move(line));
-      pos = is.tellg();
-    } else
+      if (pos != std::istream::pos_type(-1))
+        is.seekg(pos);
+      else
+        is.setstate(std::ios::failbit);
       break;
+    }
+    header.lines.push_back(std::move(line));
   }
-  return is.seekg(pos);
+  return is;
 }
 
 template <std::derived_from<Header> H>
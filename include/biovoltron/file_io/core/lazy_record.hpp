@@ -0,0 +1,160 @@
+#pragma once
+
+#include <biovoltron/file_io/core/record.hpp>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup file_io
+ * @brief A tab-delimited line of R whose fields are converted on access.
+ *
+ * Reading a LazyRecord only copies the line and records where its fields
+ * start in a single scan for tabs. The I-th field is converted by `get<I>()`
+ * with the same conversion and the same field order as `operator>>` of R,
+ * so a pass which only looks at a few fields of every line skips the
+ * conversion of all others.
+ *
+ * Example
+ * ```cpp
+ * auto bed = std::ifstream{"peaks.bed"};
+ * auto peaks = std::vector<BedRecord>{};
+ * for (auto line = biovoltron::LazyRecord<BedRecord>{}; bed >> line;)
+ *   if (line.text<0>() == "chr1" && line.get<1>() > 1000000)
+ *     peaks.push_back(line.to_record());
+ * ```
+ */
+template <std::derived_from<Record> R> class LazyRecord {
+  using fields_type = decltype(to_tuple(std::declval<R &>()));
+
+  std::string line_;
+  std::vector<std::size_t> starts_ = {0};
+
+public:
+  /**
+   * @brief Number of fields of R, the header pointer excluded.
+   */
+  constexpr static auto FIELDS = std::tuple_size_v<fields_type>;
+
+  /**
+   * @brief Type of the I-th field of R.
+   */
+  template <std::size_t I>
+  using field_type =
+      std::remove_reference_t<std::tuple_element_t<I, fields_type>>;
+
+  LazyRecord() = default;
+
+  explicit LazyRecord(std::string_view line) { assign(line); }
+
+  /**
+   * @brief Replace the content with line and find its fields.
+   */
+  auto assign(std::string_view line) {
+    if (line.ends_with('\r'))
+      line.remove_suffix(1);
+    line_.assign(line);
+    index();
+  }
+
+  /**
+   * @brief The whole line, without the line break.
+   */
+  auto line() const noexcept { return std::string_view{line_}; }
+
+  /**
+   * @brief Number of tab-delimited fields in the line.
+   */
+  auto size() const noexcept { return starts_.size() - 1; }
+
+  /**
+   * @brief Text of the i-th tab-delimited field of the line, or an empty
+   * view if the line has fewer fields.
+   */
+  auto text(std::size_t i) const noexcept {
+    if (i >= size())
+      return std::string_view{};
+    return line().substr(starts_[i], starts_[i + 1] - starts_[i] - 1);
+  }
+
+  /**
+   * @brief Text of the I-th field of R, a std::vector field spans all
+   * remaining fields of the line.
+   */
+  template <std::size_t I> auto text() const noexcept {
+    if constexpr (detail::is_vector<field_type<I>>::value)
+      return I < size() ? line().substr(starts_[I]) : std::string_view{};
+    else
+      return text(I);
+  }
+
+  /**
+   * @brief Convert the I-th field of R into field, reusing its storage.
+   */
+  template <std::size_t I> auto get(field_type<I> &field) const {
+    if constexpr (detail::is_vector<field_type<I>>::value) {
+      auto fields = detail::FieldSplitter{text<I>()};
+      if (I >= size())
+        fields.pos = 1;
+      detail::parse_next_field(fields, field);
+    } else
+      detail::parse_field(text<I>(), field);
+  }
+
+  /**
+   * @brief The converted I-th field of R.
+   */
+  template <std::size_t I> auto get() const {
+    auto field = field_type<I>{};
+    get<I>(field);
+    return field;
+  }
+
+  /**
+   * @brief Convert all fields into record, like `operator>>` of R.
+   */
+  auto to_record(R &record) const { detail::parse_record(line(), record); }
+
+  /**
+   * @brief All fields converted into a new R.
+   */
+  auto to_record() const {
+    auto record = R{};
+    to_record(record);
+    return record;
+  }
+
+  /**
+   * @brief
+   * Read one tab-delimited line into a LazyRecord without converting fields.
+   */
+  friend auto &operator>>(std::istream &is, LazyRecord &record) {
+    if (std::getline(is, record.line_)) {
+      if (record.line_.ends_with('\r'))
+        record.line_.pop_back();
+      record.index();
+    }
+    return is;
+  }
+
+private:
+  // starts_[i] is the start of field i and starts_[size()] is the size of
+  // the line plus one, so every field ends one before the next start.
+  auto index() -> void {
+    starts_.resize(1);
+    const auto *first = line_.data();
+    const auto *last = first + line_.size();
+    for (auto *tab = first;
+         (tab = static_cast<const char *>(std::memchr(tab, '\t', last - tab)));
+         tab++)
+      starts_.push_back(tab - first + 1);
+    starts_.push_back(line_.size() + 1);
+  }
+};
+
+} // namespace biovoltron
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <biovoltron/file_io/core/header.hpp>
+#include <biovoltron/file_io/core/record.hpp>
+#include <biovoltron/utility/instrumentation.hpp>
+#include <deque>
+#include <future>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace biovoltron {
+
+namespace detail {
+
+/**
+ * @brief Parse every line of chunk into a copy of prototype.
+ */
+template <std::derived_from<Record> R>
+inline auto parse_records(std::string_view chunk, const R &prototype) {
+  auto records = std::vector<R>{};
+  records.reserve(std::ranges::count(chunk, '\n') + 1);
+  while (!chunk.empty()) {
+    auto end = chunk.find('\n');
+    if (end == std::string_view::npos)
+      end = chunk.size();
+    parse_record(chunk.substr(0, end), records.emplace_back(prototype));
+    chunk.remove_prefix(std::min(end + 1, chunk.size()));
+  }
+  return records;
+}
+
+/**
+ * @brief Read the rest of is in chunks which are parsed concurrently.
+ */
+template <std::derived_from<Record> R>
+inline auto read_records(std::istream &is, const R &prototype,
+                         std::size_t threads, std::size_t chunk_size) {
+  BIOVOLTRON_TIMED_SCOPE(timer, "read_records");
+  threads = std::max<std::size_t>(threads, 1);
+  chunk_size = std::max<std::size_t>(chunk_size, 1);
+
+  auto records = std::vector<R>{};
+  auto pending = std::deque<std::future<std::vector<R>>>{};
+  const auto collect = [&records, &pending] {
+    auto chunk_records = pending.front().get();
+    pending.pop_front();
+    records.insert(records.end(),
+                   std::make_move_iterator(chunk_records.begin()),
+                   std::make_move_iterator(chunk_records.end()));
+  };
+
+  auto carry = std::string{};
+  while (is) {
+    auto chunk = std::move(carry);
+    const auto old_size = chunk.size();
+    chunk.resize(old_size + chunk_size);
+    is.read(chunk.data() + old_size, chunk_size);
+    chunk.resize(old_size + is.gcount());
+
+    // Cut the chunk after its last complete line, the partial line is
+    // carried over into the next chunk.
+    carry.clear();
+    if (is) {
+      const auto last = chunk.rfind('\n');
+      if (last == std::string::npos) {
+        carry = std::move(chunk);
+        continue;
+      }
+      carry.assign(chunk, last + 1);
+      chunk.resize(last + 1);
+    }
+    if (chunk.empty())
+      continue;
+
+    BIOVOLTRON_TIMER_ADD(timer, 0, chunk.size());
+    if (pending.size() == threads)
+      collect();
+    pending.push_back(std::async(
+        std::launch::async, [chunk = std::move(chunk), &prototype] {
+          return parse_records<R>(chunk, prototype);
+        }));
+  }
+  while (!pending.empty())
+    collect();
+  BIOVOLTRON_TIMER_ADD(timer, records.size(), 0);
+
+  is.clear(is.rdstate() & ~std::ios::failbit);
+  return records;
+}
+
+} // namespace detail
+
+/**
+ * @ingroup file_io
+ * @brief
+ * Read all remaining lines of a tab-delimited file concurrently.
+ *
+ * The stream is read in chunks of `chunk_size` bytes which are cut at line
+ * boundaries. While the next chunk is read, up to `threads` chunks are
+ * parsed in the background with the same field conversion as `operator>>`.
+ * The records are returned in file order, so the result equals reading the
+ * stream record by record.
+ *
+ * Example
+ * ```cpp
+ * auto bed = std::ifstream{"peaks.bed"};
+ * auto peaks = biovoltron::read_records<BedRecord>(bed);
+ * ```
+ */
+template <std::derived_from<Record> R>
+  requires(!std::derived_from<R, HeaderableRecord>)
+inline auto read_records(
+    std::istream &is,
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency()),
+    std::size_t chunk_size = std::size_t{1} << 22) {
+  return detail::read_records(is, R{}, threads, chunk_size);
+}
+
+/**
+ * @ingroup file_io
+ * @brief
+ * Read the header and all records of a tab-delimited file concurrently.
+ *
+ * The header lines are consumed by the `operator>>` of H, which stops at
+ * the first line not starting with one of `H::START_SYMBOLS`. The remaining
+ * lines are parsed like `read_records(is)` and every record points to
+ * header, which therefore has to outlive the returned records.
+ *
+ * Example
+ * ```cpp
+ * auto vcf = std::ifstream{"calls.vcf"};
+ * auto header = biovoltron::VcfHeader{};
+ * auto calls = biovoltron::read_records<VcfRecord>(vcf, header);
+ * ```
+ */
+template <std::derived_from<HeaderableRecord> R, std::derived_from<Header> H>
+inline auto read_records(
+    std::istream &is, H &header,
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency()),
+    std::size_t chunk_size = std::size_t{1} << 22) {
+  is >> header;
+  auto prototype = R{};
+  prototype.header = &header;
+  return detail::read_records(is, prototype, threads, chunk_size);
+}
+
+} // namespace biovoltron
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <biovoltron/file_io/core/field.hpp>
 #include <biovoltron/file_io/core/tuple.hpp>
 #include <biovoltron/utility/istring.hpp>
+#include <locale>
 #include <ranges>
 #include <sstream>
 
@@ -26,11 +28,85 @@ inline auto &operator<<(std::ostream &os, const std::vector<T> &fields) {
   return os;
 }
 
+namespace detail {
+
+/**
+ * @brief Append the fields of record to out, each followed by a tab.
+ */
+template <std::derived_from<Record> R>
+inline auto format_record(std::string &out, const R &record,
+                          int precision = 6) {
+  std::apply(
+      [&out, precision](const auto &...field) {
+        ((format_field(out, field, precision), out += '\t'), ...);
+      },
+      to_tuple(record));
+}
+
+/**
+ * @brief Whether os formats fields like a new stream apart from its
+ * precision, which format_field can do with `std::to_chars`.
+ */
+inline auto plain_format(const std::ostream &os) {
+  const auto ignored = std::ios::skipws | std::ios::unitbuf |
+                       std::ios::adjustfield;
+  return (os.flags() & ~ignored) == std::ios::dec && os.width() == 0 &&
+         os.getloc() == std::locale::classic();
+}
+
+} // namespace detail
+
+/**
+ * @brief
+ * Output the fields of a Record, each followed by a tab.
+ *
+ * The record is formatted into a reused buffer with `std::to_chars` and
+ * written with a single `write`. Streams with other flags than the
+ * precision, a width or a locale set format every field with its
+ * `operator<<` instead.
+ */
 template <std::derived_from<Record> R>
 inline auto &operator<<(std::ostream &os, const R &record) {
-  std::apply([&os](const auto &...field) { ((os << field << "\t"), ...); },
-             to_tuple(record));
-  return os;
+  if (!detail::plain_format(os)) {
+    std::apply([&os](const auto &...field) { ((os << field << "\t"), ...); },
+               to_tuple(record));
+    return os;
+  }
+  thread_local auto buf = std::string{};
+  buf.clear();
+  detail::format_record(buf, record, os.precision());
+  return os.write(buf.data(), buf.size());
+}
+
+/**
+ * @brief
+ * Output a range of Records, one record per line.
+ *
+ * Records are formatted into one large buffer which is written whenever it
+ * exceeds `buffer_size` bytes, so the stream is hit once per buffer instead
+ * of once per field. Streams which `operator<<` formats field by field are
+ * written record by record.
+ */
+template <std::ranges::input_range Rng>
+  requires std::derived_from<std::ranges::range_value_t<Rng>, Record>
+inline auto &write_records(std::ostream &os, Rng &&records,
+                           std::size_t buffer_size = 1 << 20) {
+  if (!detail::plain_format(os)) {
+    for (const auto &record : records)
+      os << record << '\n';
+    return os;
+  }
+  auto buf = std::string{};
+  buf.reserve(buffer_size + 4096);
+  for (const auto &record : records) {
+    detail::format_record(buf, record, os.precision());
+    buf += '\n';
+    if (buf.size() >= buffer_size) {
+      os.write(buf.data(), buf.size());
+      buf.clear();
+    }
+  }
+  return os.write(buf.data(), buf.size());
 }
 
 template <class T>
@@ -40,12 +116,40 @@ inline auto &operator>>(std::istream &is, std::vector<T> &fields) {
   return is;
 }
 
+namespace detail {
+
+/**
+ * @brief Parse one tab-delimited line into the fields of record.
+ *
+ * Fields missing from the line are reset to their default value, the
+ * storage of string and vector fields is reused.
+ */
+template <std::derived_from<Record> R>
+inline auto parse_record(std::string_view line, R &record) {
+  if (line.ends_with('\r'))
+    line.remove_suffix(1);
+  auto fields = FieldSplitter{line};
+  std::apply(
+      [&fields](auto &...field) { (parse_next_field(fields, field), ...); },
+      to_tuple(record));
+}
+
+} // namespace detail
+
+/**
+ * @brief
+ * Read one tab-delimited line into a Record.
+ *
+ * The line is read into a reused buffer, split at tabs and every field is
+ * converted in place, so parsing a record into the same object again does
+ * not allocate for arithmetic and string fields. A std::vector field takes
+ * all remaining fields of the line.
+ */
 template <std::derived_from<Record> R>
 inline auto &operator>>(std::istream &is, R &record) {
-  if (auto line = std::string{}; std::getline(is, line))
-    std::apply([iss = std::istringstream{line}](
-                   auto &...field) mutable { ((iss >> field), ...); },
-               to_tuple(record = {}));
+  thread_local auto line = std::string{};
+  if (std::getline(is, line))
+    detail::parse_record(line, record);
   return is;
 }
 
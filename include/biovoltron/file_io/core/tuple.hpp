@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <concepts>
 #include <tuple>
+#include <utility>
 
 namespace biovoltron {
 
@@ -11,185 +14,500 @@ template <auto I> struct AnyField {
   template <typename T> operator T() noexcept;
 };
 
+/**
+ * @brief Maximum number of fields of a Record supported by to_tuple.
+ */
+constexpr auto MAX_FIELDS_COUNT = std::size_t{64};
+
 template <std::derived_from<Record> R, auto... Is>
-constexpr auto detect_fields_count(std::index_sequence<Is...>) noexcept {
-  if constexpr (requires(Record r) { R{r, AnyField<Is>{}...}; })
-    return sizeof...(Is);
-  else
-    return detect_fields_count<R>(
-        std::make_index_sequence<sizeof...(Is) - 1>{});
+constexpr auto is_initializable(std::index_sequence<Is...>) noexcept {
+  return requires(Record r) { R{r, AnyField<Is>{}...}; };
+}
+
+/**
+ * @brief Largest N in [Lo, Hi] such that R can be aggregate initialized
+ * from N fields.
+ *
+ * Aggregate initialization succeeds for every N up to the number of fields
+ * and fails above, so the count is found with a binary search, which needs
+ * a logarithmic instead of a linear number of probes.
+ */
+template <std::derived_from<Record> R, std::size_t Lo, std::size_t Hi>
+constexpr auto detect_fields_count() noexcept {
+  if constexpr (Lo == Hi)
+    return Lo;
+  else {
+    constexpr auto mid = (Lo + Hi + 1) / 2;
+    if constexpr (is_initializable<R>(std::make_index_sequence<mid>{}))
+      return detect_fields_count<R, mid, Hi>();
+    else
+      return detect_fields_count<R, Lo, mid - 1>();
+  }
 }
 
 template <std::derived_from<Record> R> constexpr auto fields_count() noexcept {
-  return detect_fields_count<R>(std::make_index_sequence<sizeof(R)>{});
+  // Every field occupies at least one byte, so sizeof(R) bounds the count.
+  constexpr auto count = detect_fields_count<
+      R, 0, std::min(sizeof(R), MAX_FIELDS_COUNT + 1)>();
+  static_assert(count <= MAX_FIELDS_COUNT, "Record has too many fields");
+  return count;
 };
 
-template <std::derived_from<Record> R> constexpr auto to_tuple(R &r) noexcept {
-  constexpr auto count = fields_count<R>();
-  constexpr auto has_header = std::derived_from<R, HeaderableRecord>;
-  if constexpr (count == 21) {
+namespace detail {
+
+template <std::size_t N, class R> constexpr auto tie_fields(R &r) noexcept {
+  if constexpr (N == 64) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55, f56, f57,
+           f58, f59, f60, f61, f62, f63] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55, f56, f57, f58, f59, f60, f61,
+                    f62, f63);
+  } else if constexpr (N == 63) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55, f56, f57,
+           f58, f59, f60, f61, f62] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55, f56, f57, f58, f59, f60, f61,
+                    f62);
+  } else if constexpr (N == 62) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55, f56, f57,
+           f58, f59, f60, f61] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55, f56, f57, f58, f59, f60, f61);
+  } else if constexpr (N == 61) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55, f56, f57,
+           f58, f59, f60] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55, f56, f57, f58, f59, f60);
+  } else if constexpr (N == 60) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55, f56, f57,
+           f58, f59] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55, f56, f57, f58, f59);
+  } else if constexpr (N == 59) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55, f56, f57,
+           f58] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55, f56, f57, f58);
+  } else if constexpr (N == 58) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55, f56,
+           f57] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55, f56, f57);
+  } else if constexpr (N == 57) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55, f56] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55, f56);
+  } else if constexpr (N == 56) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54, f55] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54, f55);
+  } else if constexpr (N == 55) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53, f54] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53, f54);
+  } else if constexpr (N == 54) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52, f53] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52, f53);
+  } else if constexpr (N == 53) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51, f52] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51, f52);
+  } else if constexpr (N == 52) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50, f51] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50, f51);
+  } else if constexpr (N == 51) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49, f50] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49,
+                    f50);
+  } else if constexpr (N == 50) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48, f49] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48, f49);
+  } else if constexpr (N == 49) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47, f48] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47, f48);
+  } else if constexpr (N == 48) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46, f47] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46, f47);
+  } else if constexpr (N == 47) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45, f46] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45, f46);
+  } else if constexpr (N == 46) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44, f45] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44, f45);
+  } else if constexpr (N == 45) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42, f43,
+           f44] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43, f44);
+  } else if constexpr (N == 44) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42,
+           f43] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42, f43);
+  } else if constexpr (N == 43) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41, f42] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41, f42);
+  } else if constexpr (N == 42) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40, f41] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40, f41);
+  } else if constexpr (N == 41) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, f40] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39, f40);
+  } else if constexpr (N == 40) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38, f39] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38, f39);
+  } else if constexpr (N == 39) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37, f38] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37,
+                    f38);
+  } else if constexpr (N == 38) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36, f37] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37);
+  } else if constexpr (N == 37) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35, f36] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36);
+  } else if constexpr (N == 36) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34, f35] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34, f35);
+  } else if constexpr (N == 35) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33, f34] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33, f34);
+  } else if constexpr (N == 34) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32, f33] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32, f33);
+  } else if constexpr (N == 33) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31, f32] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31, f32);
+  } else if constexpr (N == 32) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30, f31] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30, f31);
+  } else if constexpr (N == 31) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29,
+           f30] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29, f30);
+  } else if constexpr (N == 30) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28,
+           f29] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28, f29);
+  } else if constexpr (N == 29) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27, f28);
+  } else if constexpr (N == 28) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26, f27);
+  } else if constexpr (N == 27) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25,
+                    f26);
+  } else if constexpr (N == 26) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24, f25] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25);
+  } else if constexpr (N == 25) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23, f24] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24);
+  } else if constexpr (N == 24) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22, f23] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22, f23);
+  } else if constexpr (N == 23) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21, f22] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21, f22);
+  } else if constexpr (N == 22) {
+    auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
+           f16, f17, f18, f19, f20, f21] = r;
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20, f21);
+  } else if constexpr (N == 21) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
            f16, f17, f18, f19, f20] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11,
-                                 f12, f13, f14, f15, f16, f17, f18, f19, f20);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 20) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19, f20);
+  } else if constexpr (N == 20) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
            f16, f17, f18, f19] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11,
-                                 f12, f13, f14, f15, f16, f17, f18, f19);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 19) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18, f19);
+  } else if constexpr (N == 19) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
            f16, f17, f18] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11,
-                                 f12, f13, f14, f15, f16, f17, f18);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 18) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17, f18);
+  } else if constexpr (N == 18) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
            f16, f17] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11,
-                                 f12, f13, f14, f15, f16, f17);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 17) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16, f17);
+  } else if constexpr (N == 17) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15,
            f16] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11,
-                                 f12, f13, f14, f15, f16);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 16) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15, f16);
+  } else if constexpr (N == 16) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14,
            f15] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11,
-                                 f12, f13, f14, f15);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 15) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14, f15);
+  } else if constexpr (N == 15) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = r;
-    auto record_tuple =
-        std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 14) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13,
+                    f14);
+  } else if constexpr (N == 14) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = r;
-    auto record_tuple =
-        std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 13) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+  } else if constexpr (N == 13) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = r;
-    auto record_tuple =
-        std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 12) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+  } else if constexpr (N == 12) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 11) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+  } else if constexpr (N == 11) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 10) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+  } else if constexpr (N == 10) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8, f9);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 9) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+  } else if constexpr (N == 9) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7, f8] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7, f8);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 8) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+  } else if constexpr (N == 8) {
     auto &[f0, f1, f2, f3, f4, f5, f6, f7] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6, f7);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 7) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+  } else if constexpr (N == 7) {
     auto &[f0, f1, f2, f3, f4, f5, f6] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5, f6);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 6) {
+    return std::tie(f0, f1, f2, f3, f4, f5, f6);
+  } else if constexpr (N == 6) {
     auto &[f0, f1, f2, f3, f4, f5] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4, f5);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 5) {
+    return std::tie(f0, f1, f2, f3, f4, f5);
+  } else if constexpr (N == 5) {
     auto &[f0, f1, f2, f3, f4] = r;
-    auto record_tuple = std::tie(f1, f2, f3, f4);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 4) {
+    return std::tie(f0, f1, f2, f3, f4);
+  } else if constexpr (N == 4) {
     auto &[f0, f1, f2, f3] = r;
-    auto record_tuple = std::tie(f1, f2, f3);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 3) {
+    return std::tie(f0, f1, f2, f3);
+  } else if constexpr (N == 3) {
     auto &[f0, f1, f2] = r;
-    auto record_tuple = std::tie(f1, f2);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 2) {
+    return std::tie(f0, f1, f2);
+  } else if constexpr (N == 2) {
     auto &[f0, f1] = r;
-    auto record_tuple = std::tie(f1);
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  } else if constexpr (count == 1) {
+    return std::tie(f0, f1);
+  } else if constexpr (N == 1) {
     auto &[f0] = r;
-    auto record_tuple = std::tie();
-    if constexpr (has_header)
-      return record_tuple;
-    else
-      return std::tuple_cat(std::tie(f0), record_tuple);
-  }
+    return std::tie(f0);
+  } else
+    return std::tie();
+}
+
+template <class Tuple, std::size_t... Is>
+constexpr auto drop_first(Tuple fields, std::index_sequence<Is...>) noexcept {
+  return std::tie(std::get<Is + 1>(fields)...);
+}
+
+} // namespace detail
+
+template <std::derived_from<Record> R> constexpr auto to_tuple(R &r) noexcept {
+  constexpr auto count = fields_count<R>();
+  auto fields = detail::tie_fields<count>(r);
+  if constexpr (std::derived_from<R, HeaderableRecord>)
+    return detail::drop_first(fields, std::make_index_sequence<count - 1>{});
+  else
+    return fields;
 }
 
 } // namespace biovoltron
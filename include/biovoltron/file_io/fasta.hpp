@@ -1,5 +1,6 @@
 #pragma once
 
+#include <biovoltron/utility/instrumentation.hpp>
 #include <biovoltron/utility/istring.hpp>
 
 namespace biovoltron {
@@ -64,6 +65,23 @@ template <bool Encoded = false> struct FastaRecord {
 
 template <bool> struct FastqRecord;
 
+namespace detail {
+
+/**
+ * @brief Count a parsed FASTA or FASTQ record in the instrumentation.
+ */
+template <class R>
+inline auto count_read([[maybe_unused]] const R &record) {
+  if constexpr (std::same_as<R, FastqRecord<R::encoded>>)
+    BIOVOLTRON_COUNT("fastq/read", 1,
+                     record.name.size() + record.seq.size() +
+                         record.qual.size());
+  else
+    BIOVOLTRON_COUNT("fasta/read", 1, record.name.size() + record.seq.size());
+}
+
+} // namespace detail
+
 /**
  * @brief
  * Read a FASTA or FASTQ file and record data into FastaRecord or FastqRecord.
@@ -95,19 +113,24 @@ inline auto &operator>>(std::istream &is, R &record) {
       if (is.peek() == record.DELIM)
         break;
     } else {
-      if (is.peek() == record.START_SYMBOL)
+      if (is.peek() == record.START_SYMBOL) {
+        detail::count_read(record);
         return is;
+      }
     }
   }
   if constexpr (std::same_as<R, FastqRecord<R::encoded>>) {
     getline(is, line);
     for (record.qual.clear(); getline(is, line);) {
       record.qual += line;
-      if (is.peek() == record.START_SYMBOL)
+      if (is.peek() == record.START_SYMBOL) {
+        detail::count_read(record);
         return is;
+      }
     }
   }
   is.clear();
+  detail::count_read(record);
   return is;
 }
 
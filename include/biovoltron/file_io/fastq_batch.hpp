@@ -0,0 +1,273 @@
+#pragma once
+
+#include <biovoltron/file_io/fastq.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup file_io
+ * @brief Non-owning view of one read stored in a FastqBatch.
+ *
+ * All members point into the arenas of the batch the view was taken from,
+ * so a view is invalidated as soon as the batch is cleared or refilled.
+ *
+ * @tparam Encoded seq type == istring_view if Encoded else string_view
+ */
+template <bool Encoded = false> struct FastqView {
+  constexpr static auto encoded = Encoded;
+
+  /**
+   * @brief Name of the read (without the leading '@').
+   */
+  std::string_view name;
+
+  /**
+   * @brief Sequence of the read.
+   */
+  std::conditional_t<Encoded, istring_view, std::string_view> seq;
+
+  /**
+   * @brief Quality of the read, the same length as seq.
+   */
+  std::string_view qual;
+
+  /**
+   * @brief Copy the viewed read into an owning FastqRecord.
+   */
+  operator FastqRecord<Encoded>() const {
+    using seq_type = std::conditional_t<Encoded, istring, std::string>;
+    return FastqRecord<Encoded>{{std::string{name}, seq_type{seq}},
+                                std::string{qual}};
+  }
+};
+
+/**
+ * @ingroup file_io
+ * @brief A batch of FASTQ reads stored as struct-of-arrays.
+ *
+ * Names, sequences and qualities of all reads are concatenated into three
+ * contiguous arenas and each read is addressed by offsets into them. Since
+ * `clear()` keeps the capacity of every arena, refilling the same batch
+ * with `operator>>` reaches a steady state where parsing a read performs no
+ * heap allocation at all, unlike `operator>>` on a single FastqRecord which
+ * creates a fresh name/seq/qual string for every read.
+ *
+ * Example
+ * ```cpp
+ * auto fq = std::ifstream{"reads.fq"};
+ * auto batch = biovoltron::FastqBatch<>{};
+ * while (fq >> batch)
+ *   for (const auto read : batch.views())
+ *     std::cout << read.name << "\n";
+ * ```
+ *
+ * @tparam Encoded seq type == istring if Encoded else string
+ */
+template <bool Encoded = false> struct FastqBatch {
+  constexpr static auto encoded = Encoded;
+
+  using seq_type = std::conditional_t<Encoded, istring, std::string>;
+  using value_type = FastqView<Encoded>;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Maximum number of reads `operator>>` puts into the batch.
+   */
+  size_type batch_size = 16384;
+
+  /**
+   * @brief Concatenated names of all reads.
+   */
+  std::string names{};
+
+  /**
+   * @brief Concatenated sequences of all reads.
+   */
+  seq_type seqs{};
+
+  /**
+   * @brief Concatenated qualities of all reads, aligned with seqs.
+   */
+  std::string quals{};
+
+  /**
+   * @brief Read i's name is names[name_offsets[i], name_offsets[i + 1]).
+   */
+  std::vector<size_type> name_offsets = {0};
+
+  /**
+   * @brief Read i's seq and qual are at [seq_offsets[i], seq_offsets[i + 1]).
+   */
+  std::vector<size_type> seq_offsets = {0};
+
+  /**
+   * @brief Number of reads in the batch.
+   */
+  auto size() const noexcept { return name_offsets.size() - 1; }
+
+  [[nodiscard]] auto empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Remove all reads while keeping the allocated storage.
+   */
+  auto clear() noexcept {
+    names.clear();
+    seqs.clear();
+    quals.clear();
+    name_offsets.resize(1);
+    seq_offsets.resize(1);
+  }
+
+  /**
+   * @brief Reserve storage for n reads with a total of bases bases.
+   */
+  auto reserve(size_type n, size_type bases) {
+    name_offsets.reserve(n + 1);
+    seq_offsets.reserve(n + 1);
+    seqs.reserve(bases);
+    quals.reserve(bases);
+  }
+
+  /**
+   * @brief View of the i-th read.
+   */
+  value_type operator[](size_type i) const noexcept {
+    using seq_view =
+        std::conditional_t<Encoded, istring_view, std::string_view>;
+    const auto seq_begin = seq_offsets[i];
+    const auto seq_size = seq_offsets[i + 1] - seq_begin;
+    return {std::string_view{names}.substr(
+                name_offsets[i], name_offsets[i + 1] - name_offsets[i]),
+            seq_view{seqs}.substr(seq_begin, seq_size),
+            std::string_view{quals}.substr(seq_begin, seq_size)};
+  }
+
+  /**
+   * @brief Append a copy of the given read.
+   */
+  auto push_back(const FastqRecord<Encoded> &record) {
+    names += record.name;
+    seqs += record.seq;
+    quals += record.qual;
+    name_offsets.push_back(names.size());
+    seq_offsets.push_back(seqs.size());
+  }
+
+  /**
+   * @brief Range of views of all reads in the batch.
+   */
+  auto views() const {
+    return std::views::iota(size_type{}, size()) |
+           std::views::transform([this](auto i) { return (*this)[i]; });
+  }
+};
+
+namespace detail {
+
+template <bool Encoded>
+inline auto append_bases(FastqBatch<Encoded> &batch, std::string_view line) {
+  if constexpr (Encoded) {
+    const auto old_size = batch.seqs.size();
+    batch.seqs.resize(old_size + line.size());
+    std::ranges::transform(line, batch.seqs.begin() + old_size, Codec::to_int);
+  } else
+    batch.seqs += line;
+}
+
+/**
+ * @brief Append the next read of the stream to the batch.
+ * @return False if the stream holds no further read.
+ */
+template <bool Encoded>
+inline auto read_fastq(std::istream &is, FastqBatch<Encoded> &batch) {
+  using Record = FastqRecord<Encoded>;
+  thread_local auto line = std::string{};
+
+  if (is >> std::ws; is.peek() != Record::START_SYMBOL)
+    return false;
+
+  std::getline(is, line);
+  const auto name = std::string_view{line}.substr(1);
+  batch.names += name.substr(0, name.find_first_of(" \t"));
+
+  auto seq_size = std::size_t{};
+  for (auto delim = false; !delim;) {
+    if (!std::getline(is, line))
+      throw std::runtime_error("FastqBatch: truncated read");
+    if (delim = line.starts_with(Record::DELIM); !delim) {
+      append_bases(batch, line);
+      seq_size += line.size();
+    }
+  }
+
+  for (auto qual_size = std::size_t{}; qual_size < seq_size;) {
+    if (!std::getline(is, line))
+      throw std::runtime_error("FastqBatch: truncated read");
+    batch.quals += line;
+    qual_size += line.size();
+  }
+  if (batch.quals.size() != batch.seqs.size())
+    throw std::runtime_error("FastqBatch: seq and qual lengths differ");
+
+  batch.name_offsets.push_back(batch.names.size());
+  batch.seq_offsets.push_back(batch.seqs.size());
+  return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief
+ * Read up to `batch.batch_size` FASTQ reads into a FastqBatch.
+ *
+ * - The batch is cleared first, the storage of the previous content is
+ * reused.
+ * - Sequences and qualities may span multiple lines, a quality is complete
+ * once it is as long as its sequence.
+ * - The failbit is set if no read could be read.
+ * - Throws std::runtime_error if the stream ends in the middle of a read.
+ */
+template <bool Encoded>
+inline auto &operator>>(std::istream &is, FastqBatch<Encoded> &batch) {
+  batch.clear();
+  while (batch.size() < batch.batch_size && detail::read_fastq(is, batch))
+    ;
+
+  if (batch.empty())
+    is.setstate(std::ios::failbit);
+  else
+    is.clear(is.rdstate() & ~std::ios::failbit);
+  BIOVOLTRON_COUNT("fastq_batch/read", batch.size(),
+                   batch.names.size() + batch.seqs.size() +
+                       batch.quals.size());
+  return is;
+}
+
+/**
+ * @brief
+ * Output all reads of a FastqBatch in FASTQ format, one read per 4 lines.
+ */
+template <bool Encoded>
+inline auto &operator<<(std::ostream &os, const FastqBatch<Encoded> &batch) {
+  using Record = FastqRecord<Encoded>;
+  for (auto i = std::size_t{}; i < batch.size(); i++) {
+    const auto read = batch[i];
+    if (i != 0)
+      os << "\n";
+    os << Record::START_SYMBOL << read.name << "\n";
+    if constexpr (Encoded)
+      for (auto c : read.seq)
+        os << Codec::to_char(c);
+    else
+      os << read.seq;
+    os << "\n" << Record::DELIM << "\n" << read.qual;
+  }
+  return os;
+}
+
+} // namespace biovoltron
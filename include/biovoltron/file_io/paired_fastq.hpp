@@ -0,0 +1,179 @@
+#pragma once
+
+#include <biovoltron/file_io/fastq_batch.hpp>
+#include <future>
+#include <stdexcept>
+#include <utility>
+
+namespace biovoltron {
+
+/**
+ * @ingroup file_io
+ * @brief A batch of mate pairs, `first[i]` and `second[i]` are mates.
+ *
+ * @tparam Encoded seq type == istring if Encoded else string
+ */
+template <bool Encoded = false> struct PairedFastqBatch {
+  constexpr static auto encoded = Encoded;
+
+  /**
+   * @brief Reads of R1, or the odd reads of an interleaved file.
+   */
+  FastqBatch<Encoded> first;
+
+  /**
+   * @brief Reads of R2, or the even reads of an interleaved file.
+   */
+  FastqBatch<Encoded> second;
+
+  /**
+   * @brief Number of mate pairs in the batch.
+   */
+  auto size() const noexcept { return first.size(); }
+
+  [[nodiscard]] auto empty() const noexcept { return first.empty(); }
+
+  /**
+   * @brief Views of the i-th mate pair.
+   */
+  auto operator[](std::size_t i) const noexcept {
+    return std::pair{first[i], second[i]};
+  }
+};
+
+/**
+ * @ingroup file_io
+ * @brief Reads paired-end FASTQ data as batches of validated mate pairs.
+ *
+ * The reader either consumes two streams (R1 and R2) or a single
+ * interleaved stream in which mates are adjacent. While the caller works on
+ * one batch, the next batch is already being parsed in the background, and
+ * for two streams R1 and R2 are parsed on separate threads.
+ *
+ * Every batch is validated before it is delivered:
+ * - Both mates of a pair must have the same name once a trailing "/1" or
+ *   "/2" is ignored.
+ * - Both streams must hold the same number of reads, so a truncated file is
+ *   reported instead of silently shifting all following pairs.
+ *
+ * Violations are reported by throwing std::runtime_error from `read()`.
+ *
+ * Example
+ * ```cpp
+ * auto fq1 = std::ifstream{"reads.1.fq"};
+ * auto fq2 = std::ifstream{"reads.2.fq"};
+ * auto reader = biovoltron::PairedFastqReader<>{fq1, fq2};
+ * for (auto batch = biovoltron::PairedFastqBatch<>{}; reader.read(batch);)
+ *   for (auto i = std::size_t{}; i < batch.size(); i++) {
+ *     const auto [read1, read2] = batch[i];
+ *     // ...
+ *   }
+ * ```
+ *
+ * @tparam Encoded seq type == istring if Encoded else string
+ */
+template <bool Encoded = false> class PairedFastqReader {
+  std::istream *is1_;
+  std::istream *is2_;
+  std::size_t batch_size_;
+  PairedFastqBatch<Encoded> next_;
+  std::future<void> pending_;
+
+public:
+  /**
+   * @brief Read mate pairs from the two streams r1 and r2.
+   */
+  PairedFastqReader(std::istream &r1, std::istream &r2,
+                    std::size_t batch_size = 16384)
+      : is1_(&r1), is2_(&r2), batch_size_(batch_size) {
+    prefetch();
+  }
+
+  /**
+   * @brief Read mate pairs from an interleaved stream.
+   */
+  explicit PairedFastqReader(std::istream &interleaved,
+                             std::size_t batch_size = 16384)
+      : is1_(&interleaved), is2_(nullptr), batch_size_(batch_size) {
+    prefetch();
+  }
+
+  PairedFastqReader(const PairedFastqReader &) = delete;
+  PairedFastqReader &operator=(const PairedFastqReader &) = delete;
+
+  ~PairedFastqReader() {
+    if (pending_.valid())
+      pending_.wait();
+  }
+
+  /**
+   * @brief Name of a read with a trailing "/1" or "/2" removed.
+   */
+  static auto mate_name(std::string_view name) noexcept {
+    if (name.size() >= 2 && name[name.size() - 2] == '/' &&
+        (name.back() == '1' || name.back() == '2'))
+      name.remove_suffix(2);
+    return name;
+  }
+
+  /**
+   * @brief Replace the content of batch with the next batch of mate pairs.
+   *
+   * The storage of the given batch is recycled for parsing later batches.
+   *
+   * @return False if there are no further mate pairs.
+   */
+  auto read(PairedFastqBatch<Encoded> &batch) {
+    if (!pending_.valid()) {
+      batch.first.clear();
+      batch.second.clear();
+      return false;
+    }
+    pending_.get();
+    std::swap(batch, next_);
+    if (!batch.empty())
+      prefetch();
+    return !batch.empty();
+  }
+
+private:
+  auto prefetch() -> void {
+    next_.first.batch_size = next_.second.batch_size = batch_size_;
+    pending_ = std::async(std::launch::async, [this] {
+      fill(next_);
+      validate(next_);
+    });
+  }
+
+  auto fill(PairedFastqBatch<Encoded> &batch) -> void {
+    if (is2_ == nullptr) {
+      batch.first.clear();
+      batch.second.clear();
+      while (batch.size() < batch_size_ &&
+             detail::read_fastq(*is1_, batch.first))
+        if (!detail::read_fastq(*is1_, batch.second))
+          throw std::runtime_error(
+              "PairedFastqReader: odd number of interleaved reads");
+    } else {
+      auto second = std::async(std::launch::async,
+                               [&] { *is2_ >> batch.second; });
+      *is1_ >> batch.first;
+      second.get();
+    }
+  }
+
+  static auto validate(const PairedFastqBatch<Encoded> &batch) -> void {
+    if (batch.first.size() != batch.second.size())
+      throw std::runtime_error(
+          "PairedFastqReader: R1 and R2 hold different numbers of reads");
+    for (auto i = std::size_t{}; i < batch.size(); i++) {
+      const auto [read1, read2] = batch[i];
+      if (mate_name(read1.name) != mate_name(read2.name))
+        throw std::runtime_error("PairedFastqReader: mate names differ: " +
+                                 std::string{read1.name} + " vs " +
+                                 std::string{read2.name});
+    }
+  }
+};
+
+} // namespace biovoltron
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <biovoltron/utility/instrumentation.hpp>
+#include <cerrno>
+#include <condition_variable>
+#include <exception>
+#include <fcntl.h>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup file_io
+ * @brief A read-only streambuf which reads ahead on a dedicated thread.
+ *
+ * The data is read in blocks of `block_size` bytes into a ring of `depth`
+ * buffers. A background thread keeps filling free buffers while the parser
+ * consumes the filled ones, so the latency of the disk or the network file
+ * system overlaps with parsing instead of adding to it. The source is
+ * either a file, which is read with `pread`, or any other streambuf, which
+ * is read with `sgetn` on the background thread.
+ *
+ * The streambuf is not seekable, all parsers of the file_io module read it
+ * sequentially.
+ */
+class PrefetchStreambuf : public std::streambuf {
+  std::vector<std::vector<char>> ring_;
+  std::vector<std::size_t> sizes_;
+  std::function<std::size_t(char *, std::size_t)> source_;
+
+  std::mutex mutex_;
+  std::condition_variable filled_;
+  std::condition_variable freed_;
+  std::size_t written_ = 0;
+  std::size_t consumed_ = 0;
+  std::size_t released_ = 0;
+  bool done_ = false;
+  bool stop_ = false;
+  std::exception_ptr error_;
+
+  int fd_ = -1;
+  std::thread thread_;
+
+  auto fill(char *data, std::size_t capacity) {
+    auto size = std::size_t{};
+    while (size < capacity) {
+      const auto n = source_(data + size, capacity - size);
+      if (n == 0)
+        break;
+      size += n;
+    }
+    return size;
+  }
+
+  auto produce() -> void {
+    try {
+      for (;;) {
+        auto lock = std::unique_lock{mutex_};
+        freed_.wait(lock, [this] {
+          return stop_ || written_ - released_ < ring_.size();
+        });
+        if (stop_)
+          return;
+        const auto slot = written_ % ring_.size();
+        lock.unlock();
+
+        // The slot is neither filled nor held by the consumer, so it is
+        // written without holding the lock.
+        const auto size = fill(ring_[slot].data(), ring_[slot].size());
+        BIOVOLTRON_COUNT("prefetch/read", 0, size);
+
+        lock.lock();
+        sizes_[slot] = size;
+        if (size == 0)
+          done_ = true;
+        else
+          written_++;
+        filled_.notify_one();
+        if (done_)
+          return;
+      }
+    } catch (...) {
+      const auto lock = std::lock_guard{mutex_};
+      error_ = std::current_exception();
+      done_ = true;
+      filled_.notify_one();
+    }
+  }
+
+  auto start(std::size_t depth, std::size_t block_size) {
+    depth = std::max<std::size_t>(depth, 1);
+    block_size = std::max<std::size_t>(block_size, 1);
+    ring_.assign(depth, std::vector<char>(block_size));
+    sizes_.assign(depth, 0);
+    thread_ = std::thread{[this] { produce(); }};
+  }
+
+protected:
+  int_type underflow() override {
+    auto lock = std::unique_lock{mutex_};
+    if (consumed_ != released_) {
+      released_++;
+      freed_.notify_one();
+    }
+    filled_.wait(lock, [this] { return consumed_ < written_ || done_; });
+    if (consumed_ == written_) {
+      setg(nullptr, nullptr, nullptr);
+      if (error_)
+        std::rethrow_exception(error_);
+      return traits_type::eof();
+    }
+    const auto slot = consumed_++ % ring_.size();
+    auto *data = ring_[slot].data();
+    setg(data, data, data + sizes_[slot]);
+    return traits_type::to_int_type(*data);
+  }
+
+  std::streamsize showmanyc() override {
+    const auto lock = std::lock_guard{mutex_};
+    return consumed_ < written_ ? sizes_[consumed_ % ring_.size()]
+           : done_              ? -1
+                                : 0;
+  }
+
+public:
+  /**
+   * @brief Prefetch the file at path, reading it with `pread`.
+   *
+   * If the file cannot be opened, `is_open()` is false and the stream is
+   * empty.
+   */
+  explicit PrefetchStreambuf(const std::filesystem::path &path,
+                             std::size_t depth = 4,
+                             std::size_t block_size = std::size_t{1} << 20) {
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      done_ = true;
+      ring_.resize(1);
+      return;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    source_ = [this, offset = off_t{}](char *data, std::size_t size) mutable {
+      for (;;) {
+        const auto n = ::pread(fd_, data, size, offset);
+        if (n >= 0) {
+          offset += n;
+          return static_cast<std::size_t>(n);
+        }
+        if (errno != EINTR)
+          throw std::ios_base::failure("PrefetchStreambuf: read failed");
+      }
+    };
+    start(depth, block_size);
+  }
+
+  /**
+   * @brief Prefetch from another streambuf, which must not be used
+   * elsewhere while this streambuf is alive.
+   */
+  explicit PrefetchStreambuf(std::streambuf &source, std::size_t depth = 4,
+                             std::size_t block_size = std::size_t{1} << 20) {
+    source_ = [&source](char *data, std::size_t size) {
+      return static_cast<std::size_t>(std::max<std::streamsize>(
+          source.sgetn(data, static_cast<std::streamsize>(size)), 0));
+    };
+    start(depth, block_size);
+  }
+
+  PrefetchStreambuf(const PrefetchStreambuf &) = delete;
+  PrefetchStreambuf &operator=(const PrefetchStreambuf &) = delete;
+
+  ~PrefetchStreambuf() override {
+    {
+      const auto lock = std::lock_guard{mutex_};
+      stop_ = true;
+    }
+    freed_.notify_one();
+    if (thread_.joinable())
+      thread_.join();
+    if (fd_ >= 0)
+      ::close(fd_);
+  }
+
+  /**
+   * @brief Whether the source could be opened.
+   */
+  auto is_open() const noexcept { return thread_.joinable(); }
+};
+
+/**
+ * @ingroup file_io
+ * @brief An input stream which reads ahead on a dedicated thread.
+ *
+ * PrefetchIstream can be used wherever the file_io readers take a
+ * std::istream, e.g. for FASTA, FASTQ, FastqBatch or Record parsing, and
+ * overlaps reading the input with parsing it.
+ *
+ * Example
+ * ```cpp
+ * auto fq = biovoltron::PrefetchIstream{"reads.fq"};
+ * for (auto batch = biovoltron::FastqBatch<>{}; fq >> batch;)
+ *   // ...
+ *
+ * // Prefetch from any other stream, e.g. a decompressing one.
+ * auto gz = boost::iostreams::filtering_istream{};
+ * // ...
+ * auto prefetched = biovoltron::PrefetchIstream{gz, 8};
+ * ```
+ */
+class PrefetchIstream : public std::istream {
+  PrefetchStreambuf buf_;
+
+public:
+  /**
+   * @brief Prefetch the file at path, the failbit is set if it cannot be
+   * opened.
+   *
+   * @param depth Number of blocks read ahead.
+   * @param block_size Size of each block in bytes.
+   */
+  explicit PrefetchIstream(const std::filesystem::path &path,
+                           std::size_t depth = 4,
+                           std::size_t block_size = std::size_t{1} << 20)
+      : std::istream(nullptr), buf_(path, depth, block_size) {
+    rdbuf(&buf_);
+    if (!buf_.is_open())
+      setstate(std::ios::failbit);
+  }
+
+  /**
+   * @brief Prefetch from the stream source, which must not be read
+   * elsewhere while this stream is alive.
+   */
+  explicit PrefetchIstream(std::istream &source, std::size_t depth = 4,
+                           std::size_t block_size = std::size_t{1} << 20)
+      : std::istream(nullptr), buf_(*source.rdbuf(), depth, block_size) {
+    rdbuf(&buf_);
+  }
+};
+
+} // namespace biovoltron
@@ -11,4 +11,8 @@
  * easier to work with DNA sequences and related data.
  */
 
+#include <biovoltron/utility/instrumentation.hpp>
 #include <biovoltron/utility/istring.hpp>
+#include <biovoltron/utility/quality.hpp>
+#include <biovoltron/utility/simd.hpp>
+#include <biovoltron/utility/simulator.hpp>
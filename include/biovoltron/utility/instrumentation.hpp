@@ -0,0 +1,375 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef BIOVOLTRON_INSTRUMENT
+#include <spdlog/spdlog.h>
+#endif
+
+namespace biovoltron {
+
+/**
+ * @ingroup utility
+ * @brief Snapshot of the counters of one instrumented stage.
+ */
+struct StageMetrics {
+  /**
+   * @brief Name of the stage, e.g. "fastq/read" or "stable_sorter/sort".
+   */
+  std::string name;
+
+  /**
+   * @brief Number of completed timed scopes of the stage.
+   */
+  std::uint64_t calls = 0;
+
+  std::uint64_t records = 0;
+  std::uint64_t bytes = 0;
+
+  /**
+   * @brief Wall time spent in timed scopes of the stage.
+   */
+  std::uint64_t nanoseconds = 0;
+
+  /**
+   * @brief Heap allocations made by the threads running timed scopes of the
+   * stage, only counted if BIOVOLTRON_COUNT_ALLOCATIONS is defined in one
+   * translation unit of the program.
+   */
+  std::uint64_t allocations = 0;
+
+  auto seconds() const noexcept { return nanoseconds / 1e9; }
+
+  auto records_per_second() const noexcept {
+    return nanoseconds ? records * 1e9 / nanoseconds : 0.0;
+  }
+
+  auto bytes_per_second() const noexcept {
+    return nanoseconds ? bytes * 1e9 / nanoseconds : 0.0;
+  }
+};
+
+namespace detail {
+
+struct StageCounters {
+  std::atomic<std::uint64_t> calls{};
+  std::atomic<std::uint64_t> records{};
+  std::atomic<std::uint64_t> bytes{};
+  std::atomic<std::uint64_t> nanoseconds{};
+  std::atomic<std::uint64_t> allocations{};
+
+  auto add(std::uint64_t new_records, std::uint64_t new_bytes) noexcept {
+    records.fetch_add(new_records, std::memory_order_relaxed);
+    bytes.fetch_add(new_bytes, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Number of heap allocations made by the calling thread.
+ */
+inline auto &thread_allocations() noexcept {
+  thread_local auto count = std::uint64_t{};
+  return count;
+}
+
+inline auto total_allocations = std::atomic<std::uint64_t>{};
+
+} // namespace detail
+
+/**
+ * @ingroup utility
+ * @brief Process-wide registry of per-stage counters and timings.
+ *
+ * The readers and sorters of biovoltron report into named stages through
+ * the `BIOVOLTRON_TIMED_SCOPE` and `BIOVOLTRON_COUNT` macros. Unless
+ * `BIOVOLTRON_INSTRUMENT` is defined when compiling, these macros expand to
+ * nothing and instrumentation has no cost at all. When it is defined, every
+ * hook is a handful of relaxed atomic additions on counters looked up once
+ * per call site.
+ *
+ * The hooks sit in inline functions and templates, so the switch holds for
+ * the whole program: define `BIOVOLTRON_INSTRUMENT` for every translation
+ * unit, e.g. with the CMake option of the same name or
+ * `-DBIOVOLTRON_INSTRUMENT`, never with a `#define` before an include.
+ * Translation units that disagree on it define the same inline functions
+ * differently, which violates the one definition rule.
+ *
+ * The counters are read with `snapshot()` at any time, also from another
+ * thread while a long job is running, and can be logged through spdlog with
+ * `log_metrics()` and `log_phases()`.
+ *
+ * Example
+ * ```cpp
+ * // Compiled with -DBIOVOLTRON_INSTRUMENT.
+ * biovoltron::log_phases();
+ * auto sa = biovoltron::StableSorter<>::get_sa(ref);
+ * for (const auto &stage : biovoltron::Instrumentation::instance().snapshot())
+ *   std::cout << stage.name << "\t" << stage.seconds() << "\n";
+ * ```
+ */
+class Instrumentation {
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<detail::StageCounters>, std::less<>>
+      stages_;
+  std::function<void(std::string_view, const StageMetrics &)> listener_;
+  std::atomic<bool> has_listener_ = false;
+
+  Instrumentation() = default;
+
+public:
+  Instrumentation(const Instrumentation &) = delete;
+  Instrumentation &operator=(const Instrumentation &) = delete;
+
+  static auto &instance() {
+    static auto instance = Instrumentation{};
+    return instance;
+  }
+
+  /**
+   * @brief Counters of the stage name, created on first use. The reference
+   * stays valid for the lifetime of the program.
+   */
+  auto &stage(std::string_view name) {
+    const auto lock = std::lock_guard{mutex_};
+    auto it = stages_.find(name);
+    if (it == stages_.end())
+      it = stages_
+               .emplace(std::string{name},
+                        std::make_unique<detail::StageCounters>())
+               .first;
+    return *it->second;
+  }
+
+  /**
+   * @brief Current values of all stages, ordered by name.
+   */
+  auto snapshot() const {
+    const auto lock = std::lock_guard{mutex_};
+    auto metrics = std::vector<StageMetrics>{};
+    metrics.reserve(stages_.size());
+    for (const auto &[name, counters] : stages_)
+      metrics.push_back({name, counters->calls.load(),
+                         counters->records.load(), counters->bytes.load(),
+                         counters->nanoseconds.load(),
+                         counters->allocations.load()});
+    return metrics;
+  }
+
+  /**
+   * @brief Set all counters to zero.
+   */
+  auto reset() {
+    const auto lock = std::lock_guard{mutex_};
+    for (const auto &[name, counters] : stages_) {
+      counters->calls = 0;
+      counters->records = 0;
+      counters->bytes = 0;
+      counters->nanoseconds = 0;
+      counters->allocations = 0;
+    }
+  }
+
+  /**
+   * @brief Heap allocations of all threads so far, only counted if
+   * BIOVOLTRON_COUNT_ALLOCATIONS is defined in one translation unit.
+   */
+  static auto allocations() noexcept {
+    return detail::total_allocations.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Call listener with the name and the metrics of every completed
+   * timed scope, e.g. to report the phases of a long index build. An empty
+   * listener removes it.
+   */
+  auto set_listener(
+      std::function<void(std::string_view, const StageMetrics &)> listener) {
+    const auto lock = std::lock_guard{mutex_};
+    has_listener_ = static_cast<bool>(listener);
+    listener_ = std::move(listener);
+  }
+
+  auto listening() const noexcept {
+    return has_listener_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Pass a completed timed scope to the listener.
+   */
+  auto notify(std::string_view name, const StageMetrics &phase) {
+    const auto lock = std::lock_guard{mutex_};
+    if (listener_)
+      listener_(name, phase);
+  }
+};
+
+/**
+ * @ingroup utility
+ * @brief Adds its lifetime, and the allocations of the current thread
+ * during it, to the counters of a stage.
+ */
+class ScopedTimer {
+  using clock = std::chrono::steady_clock;
+
+  std::string_view name_;
+  detail::StageCounters &stage_;
+  clock::time_point start_ = clock::now();
+  std::uint64_t allocations_ = detail::thread_allocations();
+  std::uint64_t records_ = 0;
+  std::uint64_t bytes_ = 0;
+
+public:
+  ScopedTimer(std::string_view name, detail::StageCounters &stage) noexcept
+      : name_(name), stage_(stage) {}
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+  /**
+   * @brief Add processed records and bytes to the stage.
+   */
+  auto add(std::uint64_t records, std::uint64_t bytes = 0) noexcept {
+    records_ += records;
+    bytes_ += bytes;
+    stage_.add(records, bytes);
+  }
+
+  ~ScopedTimer() {
+    const auto ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                             start_)
+            .count());
+    const auto allocations = detail::thread_allocations() - allocations_;
+    stage_.calls.fetch_add(1, std::memory_order_relaxed);
+    stage_.nanoseconds.fetch_add(ns, std::memory_order_relaxed);
+    stage_.allocations.fetch_add(allocations, std::memory_order_relaxed);
+    auto &instrumentation = Instrumentation::instance();
+    if (instrumentation.listening()) {
+      try {
+        instrumentation.notify(name_, {std::string{name_}, 1, records_,
+                                       bytes_, ns, allocations});
+      } catch (...) {
+      }
+    }
+  }
+};
+
+#ifdef BIOVOLTRON_INSTRUMENT
+
+/**
+ * @ingroup utility
+ * @brief Log every completed timed scope through spdlog.
+ */
+inline auto log_phases(spdlog::level::level_enum level = spdlog::level::info) {
+  Instrumentation::instance().set_listener(
+      [level](std::string_view name, const StageMetrics &phase) {
+        spdlog::log(level, "{}: {:.3f} s, {} records, {} bytes, {} allocations",
+                    name, phase.seconds(), phase.records, phase.bytes,
+                    phase.allocations);
+      });
+}
+
+/**
+ * @ingroup utility
+ * @brief Log the totals of all stages through spdlog.
+ */
+inline auto log_metrics(spdlog::level::level_enum level = spdlog::level::info) {
+  for (const auto &stage : Instrumentation::instance().snapshot())
+    spdlog::log(level,
+                "{}: {} calls, {:.3f} s, {} records ({:.0f}/s), {} bytes "
+                "({:.1f} MB/s), {} allocations",
+                stage.name, stage.calls, stage.seconds(), stage.records,
+                stage.records_per_second(), stage.bytes,
+                stage.bytes_per_second() / 1e6, stage.allocations);
+}
+
+#define BIOVOLTRON_INSTRUMENT_CONCAT_(a, b) a##b
+#define BIOVOLTRON_INSTRUMENT_CONCAT(a, b) BIOVOLTRON_INSTRUMENT_CONCAT_(a, b)
+
+/**
+ * Declare the timer variable which times the rest of the enclosing scope as
+ * the stage name, a string literal.
+ */
+#define BIOVOLTRON_TIMED_SCOPE(timer, name)                                    \
+  static auto &BIOVOLTRON_INSTRUMENT_CONCAT(biovoltron_stage_, __LINE__) =    \
+      ::biovoltron::Instrumentation::instance().stage(name);                   \
+  auto timer = ::biovoltron::ScopedTimer {                                     \
+    name, BIOVOLTRON_INSTRUMENT_CONCAT(biovoltron_stage_, __LINE__)            \
+  }
+
+/**
+ * Add records and bytes to a timer declared by BIOVOLTRON_TIMED_SCOPE.
+ */
+#define BIOVOLTRON_TIMER_ADD(timer, records, bytes) timer.add(records, bytes)
+
+/**
+ * Add records and bytes to the stage name, a string literal.
+ */
+#define BIOVOLTRON_COUNT(name, records, bytes)                                 \
+  do {                                                                         \
+    static auto &biovoltron_stage =                                            \
+        ::biovoltron::Instrumentation::instance().stage(name);                 \
+    biovoltron_stage.add(records, bytes);                                      \
+  } while (false)
+
+#else
+
+#define BIOVOLTRON_TIMED_SCOPE(timer, name) static_cast<void>(0)
+#define BIOVOLTRON_TIMER_ADD(timer, records, bytes) static_cast<void>(0)
+#define BIOVOLTRON_COUNT(name, records, bytes) static_cast<void>(0)
+
+#endif
+
+} // namespace biovoltron
+
+/**
+ * Defining BIOVOLTRON_COUNT_ALLOCATIONS in exactly one translation unit
+ * before including this header replaces the global operator new and delete
+ * by counting versions based on malloc and free.
+ */
+#if defined(BIOVOLTRON_COUNT_ALLOCATIONS) &&                                   \
+    !defined(BIOVOLTRON_ALLOCATIONS_COUNTED)
+#define BIOVOLTRON_ALLOCATIONS_COUNTED
+
+// GCC inlines these into new and delete expressions and then takes the
+// free of memory from operator new for a mismatch.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t size) {
+  biovoltron::detail::thread_allocations()++;
+  biovoltron::detail::total_allocations.fetch_add(1,
+                                                  std::memory_order_relaxed);
+  if (auto *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
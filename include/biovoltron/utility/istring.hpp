@@ -1,6 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
+#include <biovoltron/utility/simd.hpp>
+#include <cstring>
 #include <istream>
 #include <ostream>
 
@@ -75,8 +78,23 @@ struct Codec {
    */
   constexpr static auto hash(istring_view seq) noexcept {
     auto key = 0ull;
-    for (auto i = 0; i < seq.size(); i++)
-      key |= (seq[seq.size() - i - 1] & 3ull) << 2 * i;
+    auto i = std::size_t{};
+    if constexpr (std::endian::native == std::endian::little) {
+      // Gather the low dibits of 8 bases at a time, first base highest.
+      if (!std::is_constant_evaluated()) {
+        for (; i + 8 <= seq.size(); i += 8) {
+          auto x = 0ull;
+          std::memcpy(&x, seq.data() + i, 8);
+          x = __builtin_bswap64(x) & 0x0303030303030303ull;
+          x = (x | x >> 6) & 0x000f000f000f000full;
+          x = (x | x >> 12) & 0x000000ff000000ffull;
+          x = (x | x >> 24) & 0xffffull;
+          key = key << 16 | x;
+        }
+      }
+    }
+    for (; i < seq.size(); i++)
+      key = key << 2 | (seq[i] & 3ull);
     return key;
   };
 
@@ -101,10 +119,8 @@ struct Codec {
    * @return The reverse complemented DNA sequence.
    */
   static auto rev_comp(istring_view seq) {
-    auto res = istring{};
-    res.reserve(seq.size());
-    std::transform(seq.rbegin(), seq.rend(), std::back_inserter(res),
-                   [](const auto c) { return c == 4 ? 4 : 3 - c; });
+    auto res = istring(seq.size(), 0);
+    detail::simd::rev_comp(seq.data(), seq.size(), res.data());
     return res;
   }
 
@@ -115,8 +131,8 @@ struct Codec {
    * @return The converted string-based DNA sequence.
    */
   static auto to_string(istring_view seq) {
-    auto res = std::string{};
-    std::ranges::transform(seq, std::back_inserter(res), to_char);
+    auto res = std::string(seq.size(), 0);
+    detail::simd::decode(seq.data(), seq.size(), res.data());
     return res;
   }
 
@@ -127,8 +143,8 @@ struct Codec {
    * @return The converted istring sequence.
    */
   static auto to_istring(std::string_view seq) {
-    auto res = istring{};
-    std::ranges::transform(seq, std::back_inserter(res), to_int);
+    auto res = istring(seq.size(), 0);
+    detail::simd::encode(seq.data(), seq.size(), res.data());
     return res;
   }
 
@@ -156,9 +172,8 @@ struct Codec {
    * @return The reverse complemented string-based DNA sequence.
    */
   static auto rev_comp(std::string_view seq) {
-    auto res = std::string{};
-    res.reserve(seq.size());
-    std::transform(seq.rbegin(), seq.rend(), std::back_inserter(res), comp);
+    auto res = std::string(seq.size(), 0);
+    detail::simd::rev_comp(seq.data(), seq.size(), res.data());
     return res;
   }
 };
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <biovoltron/container/xbit_vector.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace biovoltron {
+
+/**
+ * @ingroup utility
+ * @brief Codec between Phred+33 quality strings and 4-bit quality codes.
+ *
+ * Quality strings take one byte per base, while most sequencers emit no
+ * more than a handful of distinct quality values. QualityCodec maps every
+ * quality character to one of at most 16 codes which are stored in a
+ * QuadbitVector, halving the memory of qualities kept in RAM.
+ *
+ * Two kinds of codecs are available:
+ * - `QualityCodec::illumina()` is lossy and applies Illumina's 8-level
+ *   quality binning (Q0-2, 3-9, 10-19, 20-24, 25-29, 30-34, 35-39, 40+),
+ *   decoding each bin to a representative quality.
+ * - `QualityCodec::lossless(sample)` builds a dictionary from the distinct
+ *   characters of sample and reproduces every quality exactly. It throws
+ *   std::length_error if the sample holds more than 16 distinct characters.
+ *
+ * A code is computed as the number of bin boundaries not greater than the
+ * quality character, so encoding is a fixed sequence of compares without
+ * table lookups which the compiler vectorizes, and decoding expands each
+ * byte of the QuadbitVector into two characters with one table lookup.
+ *
+ * Example
+ * ```cpp
+ * const auto codec = biovoltron::QualityCodec::illumina();
+ * auto codes = codec.encode("II?5+#");
+ * assert(codes.size() == 6);
+ * assert(codec.decode(codes) == "IIB70#");
+ * ```
+ */
+class QualityCodec {
+public:
+  /**
+   * @brief Offset of Phred+33 encoded qualities.
+   */
+  constexpr static auto OFFSET = '!';
+
+  /**
+   * @brief Maximum number of distinct codes.
+   */
+  constexpr static auto MAX_CODES = std::size_t{16};
+
+private:
+  // bounds_[k] is the lowest character encoded to code k, unused codes
+  // have the bound 0xff so they never count.
+  std::array<std::uint8_t, MAX_CODES> bounds_{};
+  std::array<char, MAX_CODES> symbols_{};
+  std::array<std::array<char, 2>, 256> pairs_{};
+  std::array<bool, 256> valid_{};
+  std::size_t size_{};
+  bool lossless_{};
+
+  QualityCodec(std::string_view bounds, std::string_view symbols,
+               bool lossless)
+      : size_(bounds.size()), lossless_(lossless) {
+    bounds_.fill(0xff);
+    std::ranges::copy(bounds, bounds_.begin());
+    bounds_[0] = 0;
+    std::ranges::copy(symbols, symbols_.begin());
+    for (auto i = 0u; i < pairs_.size(); i++)
+      pairs_[i] = {symbols_[i & 0xf], symbols_[i >> 4]};
+    for (auto c : bounds)
+      valid_[static_cast<std::uint8_t>(c)] = true;
+  }
+
+public:
+  /**
+   * @brief Lossy codec with Illumina's 8-level quality binning.
+   */
+  static auto illumina() {
+    constexpr auto q = [](int phred) {
+      return static_cast<char>(OFFSET + phred);
+    };
+    return QualityCodec{
+        std::string{q(0), q(3), q(10), q(20), q(25), q(30), q(35), q(40)},
+        std::string{q(2), q(6), q(15), q(22), q(27), q(33), q(37), q(40)},
+        false};
+  }
+
+  /**
+   * @brief Lossless codec for all quality characters occurring in sample.
+   * @throws std::length_error if sample holds more than 16 distinct
+   * characters.
+   */
+  static auto lossless(std::string_view sample) {
+    auto seen = std::array<bool, 256>{};
+    for (auto c : sample)
+      seen[static_cast<std::uint8_t>(c)] = true;
+    auto symbols = std::string{};
+    for (auto c = 0; c < 256; c++)
+      if (seen[c])
+        symbols += static_cast<char>(c);
+    if (symbols.size() > MAX_CODES)
+      throw std::length_error("QualityCodec");
+    if (symbols.empty())
+      symbols += OFFSET;
+    return QualityCodec{symbols, symbols, true};
+  }
+
+  /**
+   * @brief Number of distinct codes used by the codec.
+   */
+  auto size() const noexcept { return size_; }
+
+  /**
+   * @brief Whether decoding reproduces the encoded qualities exactly.
+   */
+  auto is_lossless() const noexcept { return lossless_; }
+
+  /**
+   * @brief Code of a single quality character.
+   */
+  auto to_code(char c) const noexcept {
+    auto code = std::uint8_t{};
+    for (auto k = std::size_t{1}; k < MAX_CODES; k++)
+      code += static_cast<std::uint8_t>(c) >= bounds_[k];
+    return code;
+  }
+
+  /**
+   * @brief Quality character of a code.
+   */
+  auto to_char(std::uint8_t code) const noexcept { return symbols_[code]; }
+
+  /**
+   * @brief Append the codes of qual to codes.
+   * @throws std::invalid_argument if the codec is lossless and qual holds a
+   * character outside of its dictionary.
+   */
+  template <std::copy_constructible Allocator>
+  auto encode(std::string_view qual,
+              QuadbitVector<std::uint8_t, Allocator> &codes) const {
+    if (lossless_ && !std::ranges::all_of(qual, [this](auto c) {
+          return valid_[static_cast<std::uint8_t>(c)];
+        }))
+      throw std::invalid_argument("QualityCodec: unknown quality");
+
+    auto pos = codes.size();
+    codes.resize(pos + qual.size());
+    if (pos % 2 != 0 && !qual.empty()) {
+      codes[pos++] = to_code(qual.front());
+      qual.remove_prefix(1);
+    }
+
+    auto *out = codes.data() + pos / 2;
+    const auto *in = reinterpret_cast<const std::uint8_t *>(qual.data());
+    const auto pairs = qual.size() / 2;
+    for (auto i = std::size_t{}; i < pairs; i++) {
+      auto lo = std::uint8_t{}, hi = std::uint8_t{};
+      for (auto k = std::size_t{1}; k < MAX_CODES; k++) {
+        lo += in[2 * i] >= bounds_[k];
+        hi += in[2 * i + 1] >= bounds_[k];
+      }
+      out[i] = lo | hi << 4;
+    }
+    if (qual.size() % 2 != 0)
+      codes.back() = to_code(qual.back());
+  }
+
+  /**
+   * @brief Codes of qual in a new QuadbitVector.
+   */
+  auto encode(std::string_view qual) const {
+    auto codes = QuadbitVector<>{};
+    encode(qual, codes);
+    return codes;
+  }
+
+  /**
+   * @brief Append the qualities of codes[pos, pos + n) to qual.
+   */
+  template <std::copy_constructible Allocator>
+  auto decode(const QuadbitVector<std::uint8_t, Allocator> &codes,
+              std::size_t pos, std::size_t n, std::string &qual) const {
+    auto i = qual.size();
+    qual.resize(i + n);
+    if (pos % 2 != 0 && n != 0) {
+      qual[i++] = to_char(codes[pos++]);
+      n--;
+    }
+
+    const auto *in = codes.data() + pos / 2;
+    for (auto j = std::size_t{}; j < n / 2; j++, i += 2)
+      std::ranges::copy(pairs_[in[j]], qual.begin() + i);
+    if (n % 2 != 0)
+      qual[i] = to_char(codes[pos + n - 1]);
+  }
+
+  /**
+   * @brief Qualities of all codes.
+   */
+  template <std::copy_constructible Allocator>
+  auto decode(const QuadbitVector<std::uint8_t, Allocator> &codes) const {
+    auto qual = std::string{};
+    decode(codes, 0, codes.size(), qual);
+    return qual;
+  }
+};
+
+} // namespace biovoltron
@@ -0,0 +1,430 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIOVOLTRON_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace biovoltron {
+
+/**
+ * @ingroup utility
+ * @brief Instruction sets the hot loops of biovoltron are compiled for.
+ */
+enum class SimdLevel { SCALAR, AVX2, AVX512 };
+
+namespace detail {
+
+/**
+ * @brief Best level supported by the CPU and the operating system, lowered
+ * by the environment variable BIOVOLTRON_SIMD (scalar, avx2 or avx512).
+ */
+inline auto detect_simd_level() noexcept {
+  auto level = SimdLevel::SCALAR;
+#ifdef BIOVOLTRON_X86_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    level = SimdLevel::AVX2;
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    level = SimdLevel::AVX512;
+#endif
+  if (const auto *env = std::getenv("BIOVOLTRON_SIMD")) {
+    const auto name = std::string_view{env};
+    if (name == "scalar")
+      level = SimdLevel::SCALAR;
+    else if (name == "avx2")
+      level = std::min(level, SimdLevel::AVX2);
+  }
+  return level;
+}
+
+inline auto &simd_level_storage() noexcept {
+  static auto level = std::atomic<SimdLevel>{detect_simd_level()};
+  return level;
+}
+
+} // namespace detail
+
+/**
+ * @ingroup utility
+ * @brief The instruction set used by the dispatched kernels.
+ *
+ * The kernels of Codec and XbitVector are compiled for several instruction
+ * sets with function target attributes, and the best one supported by the
+ * CPU is selected at run time. So one binary built for the baseline x86-64
+ * runs on every node of a cluster and still uses AVX2 or AVX-512 where
+ * present. The level is detected on first use.
+ */
+inline auto simd_level() noexcept {
+  return detail::simd_level_storage().load(std::memory_order_relaxed);
+}
+
+/**
+ * @ingroup utility
+ * @brief Lower the instruction set used by the kernels, e.g. to compare
+ * them in tests or benchmarks. Levels above the detected one are clamped.
+ *
+ * @return The level in use afterwards.
+ */
+inline auto set_simd_level(SimdLevel level) noexcept {
+  level = std::min(level, detail::detect_simd_level());
+  detail::simd_level_storage().store(level, std::memory_order_relaxed);
+  return level;
+}
+
+} // namespace biovoltron
+
+namespace biovoltron::detail::simd {
+
+// Scalar kernels, they define the results of all others.
+
+constexpr inline auto encode_table = [] {
+  auto table = std::array<std::int8_t, 256>{};
+  table.fill(4);
+  for (auto c : {'a', 'A'})
+    table[c] = 0;
+  for (auto c : {'c', 'C'})
+    table[c] = 1;
+  for (auto c : {'g', 'G'})
+    table[c] = 2;
+  for (auto c : {'t', 'T'})
+    table[c] = 3;
+  return table;
+}();
+
+inline auto encode_scalar(const char *in, std::size_t n, std::int8_t *out) {
+  for (auto i = std::size_t{}; i < n; i++)
+    out[i] = encode_table[static_cast<unsigned char>(in[i])];
+}
+
+inline auto decode_scalar(const std::int8_t *in, std::size_t n, char *out) {
+  for (auto i = std::size_t{}; i < n; i++)
+    out[i] = "ACGTN"[in[i]];
+}
+
+inline auto comp_int(std::int8_t c) noexcept -> std::int8_t {
+  return c == 4 ? 4 : 3 - c;
+}
+
+inline auto comp_char(char c) noexcept {
+  switch (c | 0x20) {
+  case 'a':
+    return 'T';
+  case 'c':
+    return 'G';
+  case 'g':
+    return 'C';
+  case 't':
+    return 'A';
+  default:
+    return 'N';
+  }
+}
+
+inline auto rev_comp_scalar(const std::int8_t *in, std::size_t n,
+                            std::int8_t *out) {
+  for (auto i = std::size_t{}; i < n; i++)
+    out[i] = comp_int(in[n - 1 - i]);
+}
+
+inline auto rev_comp_scalar(const char *in, std::size_t n, char *out) {
+  for (auto i = std::size_t{}; i < n; i++)
+    out[i] = comp_char(in[n - 1 - i]);
+}
+
+/**
+ * @brief Pack the low bits of n values into bytes, 8 / Bits values per
+ * byte starting at the least significant bits, n a multiple of 8 / Bits.
+ */
+template <int Bits>
+inline auto pack_scalar(const std::uint8_t *in, std::size_t n,
+                        std::uint8_t *out) {
+  constexpr auto PER_BYTE = 8 / Bits;
+  constexpr auto MASK = (1u << Bits) - 1;
+  for (auto i = std::size_t{}; i < n; i += PER_BYTE) {
+    auto byte = 0u;
+    for (auto j = 0; j < PER_BYTE; j++)
+      byte |= (in[i + j] & MASK) << (j * Bits);
+    *out++ = byte;
+  }
+}
+
+#ifdef BIOVOLTRON_X86_DISPATCH
+
+// AVX2 kernels, 32 bytes per step and the scalar kernels for the rest.
+
+[[gnu::target("avx2")]] inline auto encode_avx2(const char *in, std::size_t n,
+                                                std::int8_t *out) {
+  const auto lower = _mm256_set1_epi8(0x20);
+  auto i = std::size_t{};
+  for (; i + 32 <= n; i += 32) {
+    const auto c = _mm256_or_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)), lower);
+    const auto a = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('a'));
+    const auto cc = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('c'));
+    const auto g = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('g'));
+    const auto t = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('t'));
+    const auto valid = _mm256_or_si256(_mm256_or_si256(a, cc),
+                                       _mm256_or_si256(g, t));
+    auto r = _mm256_andnot_si256(valid, _mm256_set1_epi8(4));
+    r = _mm256_or_si256(r, _mm256_and_si256(cc, _mm256_set1_epi8(1)));
+    r = _mm256_or_si256(r, _mm256_and_si256(g, _mm256_set1_epi8(2)));
+    r = _mm256_or_si256(r, _mm256_and_si256(t, _mm256_set1_epi8(3)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), r);
+  }
+  encode_scalar(in + i, n - i, out + i);
+}
+
+[[gnu::target("avx2")]] inline auto decode_avx2(const std::int8_t *in,
+                                                std::size_t n, char *out) {
+  const auto table = _mm256_setr_epi8(
+      'A', 'C', 'G', 'T', 'N', 'N', 'N', 'N', 'N', 'N', 'N', 'N', 'N', 'N',
+      'N', 'N', 'A', 'C', 'G', 'T', 'N', 'N', 'N', 'N', 'N', 'N', 'N', 'N',
+      'N', 'N', 'N', 'N');
+  auto i = std::size_t{};
+  for (; i + 32 <= n; i += 32) {
+    const auto v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        _mm256_shuffle_epi8(table, v));
+  }
+  decode_scalar(in + i, n - i, out + i);
+}
+
+/**
+ * @brief Reverse the 32 bytes of v.
+ */
+[[gnu::target("avx2")]] inline auto reverse_avx2(__m256i v) {
+  const auto reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5,
+                                        4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10,
+                                        9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, reverse), 0x4e);
+}
+
+[[gnu::target("avx2")]] inline auto
+rev_comp_avx2(const std::int8_t *in, std::size_t n, std::int8_t *out) {
+  const auto table = _mm256_setr_epi8(3, 2, 1, 0, 4, -2, -3, -4, -5, -6, -7,
+                                      -8, -9, -10, -11, -12, 3, 2, 1, 0, 4, -2,
+                                      -3, -4, -5, -6, -7, -8, -9, -10, -11,
+                                      -12);
+  auto i = std::size_t{};
+  for (; i + 32 <= n; i += 32) {
+    const auto v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(in + n - i - 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        reverse_avx2(_mm256_shuffle_epi8(table, v)));
+  }
+  rev_comp_scalar(in, n - i, out + i);
+}
+
+[[gnu::target("avx2")]] inline auto rev_comp_avx2(const char *in,
+                                                  std::size_t n, char *out) {
+  const auto lower = _mm256_set1_epi8(0x20);
+  auto i = std::size_t{};
+  for (; i + 32 <= n; i += 32) {
+    const auto c = _mm256_or_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + n - i - 32)),
+        lower);
+    auto r = _mm256_set1_epi8('N');
+    r = _mm256_blendv_epi8(r, _mm256_set1_epi8('T'),
+                           _mm256_cmpeq_epi8(c, _mm256_set1_epi8('a')));
+    r = _mm256_blendv_epi8(r, _mm256_set1_epi8('G'),
+                           _mm256_cmpeq_epi8(c, _mm256_set1_epi8('c')));
+    r = _mm256_blendv_epi8(r, _mm256_set1_epi8('C'),
+                           _mm256_cmpeq_epi8(c, _mm256_set1_epi8('g')));
+    r = _mm256_blendv_epi8(r, _mm256_set1_epi8('A'),
+                           _mm256_cmpeq_epi8(c, _mm256_set1_epi8('t')));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), reverse_avx2(r));
+  }
+  rev_comp_scalar(in, n - i, out + i);
+}
+
+/**
+ * @brief Pack 32 values into 32 / (8 / Bits) bytes with multiply-adds:
+ * adjacent values are merged into 16-bit and, for 2 bits, again into 32-bit
+ * lanes whose low bytes are gathered.
+ */
+template <int Bits>
+[[gnu::target("avx2")]] inline auto
+pack_avx2(const std::uint8_t *in, std::size_t n, std::uint8_t *out) {
+  constexpr auto PER_BYTE = 8 / Bits;
+  const auto mask = _mm256_set1_epi8((1 << Bits) - 1);
+  const auto pairs = _mm256_set1_epi16(static_cast<short>(1 | 1 << Bits << 8));
+  auto i = std::size_t{};
+  for (; i + 32 <= n; i += 32, out += 32 / PER_BYTE) {
+    auto v = _mm256_and_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i)), mask);
+    v = _mm256_maddubs_epi16(v, pairs);
+    if constexpr (Bits == 2) {
+      v = _mm256_madd_epi16(v, _mm256_set1_epi32(1 | 16 << 16));
+      const auto gather = _mm256_setr_epi8(
+          0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8,
+          12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+      v = _mm256_shuffle_epi8(v, gather);
+      const auto low = _mm256_cvtsi256_si32(v);
+      const auto high = _mm256_extract_epi32(v, 4);
+      std::memcpy(out, &low, 4);
+      std::memcpy(out + 4, &high, 4);
+    } else {
+      const auto bytes = _mm_packus_epi16(_mm256_castsi256_si128(v),
+                                          _mm256_extracti128_si256(v, 1));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out), bytes);
+    }
+  }
+  pack_scalar<Bits>(in + i, n - i, out);
+}
+
+// AVX-512 kernels, 64 bytes per step and the AVX2 kernels for the rest.
+
+// The lane shuffles are written in their masked form with a full mask, the
+// unmasked ones trip -Wuninitialized in the headers of GCC 12.
+
+/**
+ * @brief The bytes of r where c equals from set to to.
+ */
+[[gnu::target("avx512f,avx512bw")]] inline auto
+replace_avx512(__m512i r, __m512i c, char from, char to) {
+  const auto hit = _mm512_cmpeq_epi8_mask(c, _mm512_set1_epi8(from));
+  return _mm512_mask_mov_epi8(r, hit, _mm512_set1_epi8(to));
+}
+
+/**
+ * @brief Repeat v in the four 128-bit lanes.
+ */
+[[gnu::target("avx512f,avx512bw")]] inline auto lanes_avx512(__m128i v) {
+  const auto w = _mm512_castsi128_si512(v);
+  return _mm512_mask_shuffle_i32x4(w, 0xffff, w, w, 0);
+}
+
+[[gnu::target("avx512f,avx512bw")]] inline auto
+encode_avx512(const char *in, std::size_t n, std::int8_t *out) {
+  const auto lower = _mm512_set1_epi8(0x20);
+  auto i = std::size_t{};
+  for (; i + 64 <= n; i += 64) {
+    const auto c = _mm512_or_si512(_mm512_loadu_si512(in + i), lower);
+    auto r = _mm512_set1_epi8(4);
+    r = replace_avx512(r, c, 'a', 0);
+    r = replace_avx512(r, c, 'c', 1);
+    r = replace_avx512(r, c, 'g', 2);
+    r = replace_avx512(r, c, 't', 3);
+    _mm512_storeu_si512(out + i, r);
+  }
+  encode_avx2(in + i, n - i, out + i);
+}
+
+[[gnu::target("avx512f,avx512bw")]] inline auto
+decode_avx512(const std::int8_t *in, std::size_t n, char *out) {
+  const auto table = lanes_avx512(_mm_setr_epi8(
+      'A', 'C', 'G', 'T', 'N', 'N', 'N', 'N', 'N', 'N', 'N', 'N', 'N', 'N',
+      'N', 'N'));
+  auto i = std::size_t{};
+  for (; i + 64 <= n; i += 64)
+    _mm512_storeu_si512(out + i, _mm512_shuffle_epi8(
+                                     table, _mm512_loadu_si512(in + i)));
+  decode_avx2(in + i, n - i, out + i);
+}
+
+/**
+ * @brief Reverse the 64 bytes of v.
+ */
+[[gnu::target("avx512f,avx512bw")]] inline auto reverse_avx512(__m512i v) {
+  const auto reverse = lanes_avx512(
+      _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+  v = _mm512_shuffle_epi8(v, reverse);
+  return _mm512_mask_shuffle_i64x2(v, 0xff, v, v, 0x1b);
+}
+
+[[gnu::target("avx512f,avx512bw")]] inline auto
+rev_comp_avx512(const std::int8_t *in, std::size_t n, std::int8_t *out) {
+  const auto table = lanes_avx512(_mm_setr_epi8(
+      3, 2, 1, 0, 4, -2, -3, -4, -5, -6, -7, -8, -9, -10, -11, -12));
+  auto i = std::size_t{};
+  for (; i + 64 <= n; i += 64) {
+    const auto v = _mm512_loadu_si512(in + n - i - 64);
+    _mm512_storeu_si512(out + i,
+                        reverse_avx512(_mm512_shuffle_epi8(table, v)));
+  }
+  rev_comp_avx2(in, n - i, out + i);
+}
+
+[[gnu::target("avx512f,avx512bw")]] inline auto
+rev_comp_avx512(const char *in, std::size_t n, char *out) {
+  const auto lower = _mm512_set1_epi8(0x20);
+  auto i = std::size_t{};
+  for (; i + 64 <= n; i += 64) {
+    const auto c = _mm512_or_si512(_mm512_loadu_si512(in + n - i - 64), lower);
+    auto r = _mm512_set1_epi8('N');
+    r = replace_avx512(r, c, 'a', 'T');
+    r = replace_avx512(r, c, 'c', 'G');
+    r = replace_avx512(r, c, 'g', 'C');
+    r = replace_avx512(r, c, 't', 'A');
+    _mm512_storeu_si512(out + i, reverse_avx512(r));
+  }
+  rev_comp_avx2(in, n - i, out + i);
+}
+
+#endif
+
+// Dispatchers.
+
+inline auto encode(const char *in, std::size_t n, std::int8_t *out) {
+#ifdef BIOVOLTRON_X86_DISPATCH
+  switch (simd_level()) {
+  case SimdLevel::AVX512:
+    return encode_avx512(in, n, out);
+  case SimdLevel::AVX2:
+    return encode_avx2(in, n, out);
+  default:
+    break;
+  }
+#endif
+  encode_scalar(in, n, out);
+}
+
+inline auto decode(const std::int8_t *in, std::size_t n, char *out) {
+#ifdef BIOVOLTRON_X86_DISPATCH
+  switch (simd_level()) {
+  case SimdLevel::AVX512:
+    return decode_avx512(in, n, out);
+  case SimdLevel::AVX2:
+    return decode_avx2(in, n, out);
+  default:
+    break;
+  }
+#endif
+  decode_scalar(in, n, out);
+}
+
+template <class Char>
+inline auto rev_comp(const Char *in, std::size_t n, Char *out) {
+#ifdef BIOVOLTRON_X86_DISPATCH
+  switch (simd_level()) {
+  case SimdLevel::AVX512:
+    return rev_comp_avx512(in, n, out);
+  case SimdLevel::AVX2:
+    return rev_comp_avx2(in, n, out);
+  default:
+    break;
+  }
+#endif
+  rev_comp_scalar(in, n, out);
+}
+
+template <int Bits>
+inline auto pack(const std::uint8_t *in, std::size_t n, std::uint8_t *out) {
+#ifdef BIOVOLTRON_X86_DISPATCH
+  if (simd_level() != SimdLevel::SCALAR)
+    return pack_avx2<Bits>(in, n, out);
+#endif
+  pack_scalar<Bits>(in, n, out);
+}
+
+} // namespace biovoltron::detail::simd
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <algorithm>
+#include <biovoltron/file_io/fastq.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace biovoltron {
+
+/**
+ * @ingroup utility
+ * @brief Parameters of a simulated reference genome.
+ */
+struct GenomeProfile {
+  /**
+   * @brief Number of chromosomes, named chr1, chr2, ...
+   */
+  std::size_t chromosomes = 1;
+
+  /**
+   * @brief Length of every chromosome in bases.
+   */
+  std::size_t length = std::size_t{1} << 20;
+
+  /**
+   * @brief Probability of a random base being G or C, rounded to a multiple
+   * of 1/256.
+   */
+  double gc_content = 0.41;
+
+  /**
+   * @brief Fraction of the genome covered by copies of repeat families, there
+   * are no repeats if it or repeat_length is 0.
+   */
+  double repeat_fraction = 0.1;
+
+  std::size_t repeat_families = 16;
+  std::size_t repeat_length = 300;
+
+  /**
+   * @brief Substitution rate of every repeat copy against its family.
+   */
+  double repeat_divergence = 0.02;
+
+  /**
+   * @brief Number of N runs per million bases.
+   */
+  double n_runs_per_mb = 1;
+
+  /**
+   * @brief Mean length of N runs, lengths are uniform in [1, 2 * mean].
+   */
+  std::size_t n_run_length = 1000;
+};
+
+/**
+ * @ingroup utility
+ * @brief Parameters of simulated sequencing reads.
+ *
+ * Error rates and qualities change linearly from the first to the last
+ * base of every read, like the quality decay of short-read sequencers.
+ */
+struct ReadProfile {
+  std::size_t read_length = 150;
+
+  /**
+   * @brief Substitution, insertion and deletion rates at the first base.
+   */
+  double substitution_rate = 0.001;
+  double insertion_rate = 0.0001;
+  double deletion_rate = 0.0001;
+
+  /**
+   * @brief Factor of all error rates at the last base.
+   */
+  double error_growth = 5;
+
+  /**
+   * @brief Mean Phred quality at the first and the last base.
+   */
+  double first_quality = 37;
+  double last_quality = 30;
+
+  /**
+   * @brief Standard deviation of Phred qualities around their mean.
+   */
+  double quality_sd = 3;
+
+  int min_quality = 2;
+  int max_quality = 41;
+
+  /**
+   * @brief Probability of a read coming from the reverse strand.
+   */
+  double reverse_rate = 0.5;
+};
+
+namespace detail {
+
+/**
+ * @brief SplitMix64, a tiny generator which is cheap to seed, so every
+ * chunk of the output gets its own generator derived from its index.
+ */
+struct SplitMix64 {
+  using result_type = std::uint64_t;
+
+  std::uint64_t state;
+
+  constexpr static auto min() noexcept { return result_type{}; }
+  constexpr static auto max() noexcept { return ~result_type{}; }
+
+  constexpr auto operator()() noexcept {
+    auto z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  /**
+   * @brief Uniform integer in [0, n).
+   */
+  auto below(std::uint64_t n) noexcept {
+    return static_cast<std::uint64_t>(
+        (static_cast<unsigned __int128>((*this)()) * n) >> 64);
+  }
+
+  /**
+   * @brief Uniform double in [0, 1).
+   */
+  auto uniform() noexcept { return ((*this)() >> 11) * 0x1p-53; }
+};
+
+/**
+ * @brief Generator for the part id of the output of seed.
+ */
+constexpr auto chunk_generator(std::uint64_t seed, std::uint64_t id) noexcept {
+  auto mix = SplitMix64{seed};
+  mix.state ^= SplitMix64{id ^ 0x5851f42d4c957f2dull}();
+  return SplitMix64{mix()};
+}
+
+/**
+ * @brief Threshold t such that a uniform 64-bit x < t with probability p.
+ */
+inline auto threshold64(double p) noexcept {
+  return p <= 0   ? std::uint64_t{}
+         : p >= 1 ? ~std::uint64_t{}
+                  : static_cast<std::uint64_t>(p * 0x1p64);
+}
+
+/**
+ * @brief Fill [first, last) with random bases of the given GC content,
+ * 7 bases from every 64 random bits, 8 bits to pick strong (GC) or weak
+ * (AT) bases, which rounds GC content to multiples of 1/256, and one bit to
+ * pick the base.
+ */
+inline auto random_bases(SplitMix64 &gen, ichar *first, ichar *last,
+                         double gc_content) {
+  const auto strong =
+      static_cast<unsigned>(std::clamp(gc_content, 0.0, 1.0) * 256 + 0.5);
+  while (first != last) {
+    auto bits = gen();
+    for (auto i = 0; i < 7 && first != last; i++, bits >>= 9)
+      *first++ = (bits & 0xff) < strong ? 1 + (bits >> 8 & 1)
+                                        : 3 * (bits >> 8 & 1);
+  }
+}
+
+/**
+ * @brief Per read position error thresholds and cumulative quality
+ * distribution, compared against uniform random integers.
+ */
+struct PositionModel {
+  std::uint64_t deletion;
+  std::uint64_t insertion;
+  std::uint32_t substitution;
+
+  /**
+   * @brief The normal distribution around the mean quality of the position
+   * rounded to integers and clamped to [min_quality, max_quality].
+   */
+  std::vector<std::uint32_t> qualities;
+};
+
+inline auto position_models(const ReadProfile &profile) {
+  const auto length = profile.read_length;
+  const auto min = profile.min_quality;
+  const auto max = std::max(profile.max_quality, min);
+  auto models = std::vector<PositionModel>(length);
+  for (auto i = std::size_t{}; i < length; i++) {
+    const auto at = length > 1 ? i / double(length - 1) : 0.0;
+    const auto growth = 1 + (profile.error_growth - 1) * at;
+    auto &model = models[i];
+    model.deletion = threshold64(profile.deletion_rate * growth);
+    model.insertion = threshold64(
+        (profile.deletion_rate + profile.insertion_rate) * growth);
+    model.substitution = threshold64(profile.substitution_rate * growth) >> 32;
+
+    const auto mean = profile.first_quality +
+                      (profile.last_quality - profile.first_quality) * at;
+    for (auto q = min; q < max; q++) {
+      const auto z = (q + 0.5 - mean) / profile.quality_sd;
+      const auto p = profile.quality_sd > 0 ? std::erfc(-z / std::sqrt(2.0)) / 2
+                                            : q + 0.5 > mean;
+      model.qualities.push_back(threshold64(p) >> 32);
+    }
+  }
+  return models;
+}
+
+inline auto fill_chunk(istring &seq, std::size_t begin, std::size_t end,
+                       const std::vector<istring> &families,
+                       const GenomeProfile &profile, SplitMix64 gen) {
+  random_bases(gen, seq.data() + begin, seq.data() + end, profile.gc_content);
+  const auto size = end - begin;
+
+  if (!families.empty() && profile.repeat_length <= size) {
+    const auto copies = static_cast<std::size_t>(
+        size * profile.repeat_fraction / profile.repeat_length + 0.5);
+    for (auto c = std::size_t{}; c < copies; c++) {
+      auto copy = families[gen.below(families.size())];
+      for (auto &base : copy)
+        if (gen.uniform() < profile.repeat_divergence)
+          base = (base + 1 + gen.below(3)) % 4;
+      if (gen() & 1)
+        copy = Codec::rev_comp(istring_view{copy});
+      std::ranges::copy(copy, seq.begin() + begin +
+                                  gen.below(size - copy.size() + 1));
+    }
+  }
+
+  const auto expected_runs = size * profile.n_runs_per_mb / 1e6;
+  const auto runs = static_cast<std::size_t>(expected_runs) +
+                    (gen.uniform() < expected_runs - std::floor(expected_runs));
+  for (auto r = std::size_t{}; r < runs && profile.n_run_length != 0; r++) {
+    const auto length = std::min<std::size_t>(
+        1 + gen.below(2 * profile.n_run_length), size);
+    const auto first = begin + gen.below(size - length + 1);
+    std::fill_n(seq.begin() + first, length, 4);
+  }
+}
+
+} // namespace detail
+
+/**
+ * @ingroup utility
+ * @brief Simulate a reference genome.
+ *
+ * Every chromosome is made of independent random bases with the given GC
+ * content, overlaid with diverged copies of a set of random repeat
+ * families on both strands and with runs of N. The chromosomes are
+ * generated in chunks of 1 Mb in parallel, every chunk with a generator
+ * derived from seed and its position, so the genome only depends on seed
+ * and profile but not on the number of threads.
+ *
+ * Example
+ * ```cpp
+ * const auto genome = biovoltron::simulate_genome(
+ *     {.chromosomes = 24, .length = 100'000'000, .repeat_fraction = 0.4}, 1);
+ * auto fa = std::ofstream{"genome.fa"};
+ * for (const auto &chrom : genome)
+ *   fa << chrom << "\n";
+ * ```
+ *
+ * @tparam Encoded Whether to return FastaRecord<true> with 0-4 sequences.
+ */
+template <bool Encoded = false>
+inline auto simulate_genome(const GenomeProfile &profile,
+                            std::uint64_t seed = 0) {
+  constexpr auto CHUNK_SIZE = std::size_t{1} << 20;
+
+  auto family_gen = detail::chunk_generator(seed, ~std::uint64_t{});
+  const auto repeats =
+      profile.repeat_fraction > 0 && profile.repeat_length != 0;
+  auto families = std::vector<istring>(repeats ? profile.repeat_families : 0,
+                                       istring(profile.repeat_length, 0));
+  for (auto &family : families)
+    detail::random_bases(family_gen, family.data(),
+                         family.data() + family.size(), profile.gc_content);
+
+  auto seqs = std::vector<istring>(profile.chromosomes,
+                                   istring(profile.length, 0));
+  const auto chunks = (profile.length + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  auto ids = std::vector<std::size_t>(profile.chromosomes * chunks);
+  std::iota(ids.begin(), ids.end(), 0);
+  std::for_each(std::execution::par, ids.begin(), ids.end(), [&](auto id) {
+    const auto begin = id % chunks * CHUNK_SIZE;
+    detail::fill_chunk(seqs[id / chunks], begin,
+                       std::min(begin + CHUNK_SIZE, profile.length), families,
+                       profile, detail::chunk_generator(seed, id));
+  });
+
+  auto genome = std::vector<FastaRecord<Encoded>>(profile.chromosomes);
+  for (auto c = std::size_t{}; c < genome.size(); c++) {
+    genome[c].name = "chr" + std::to_string(c + 1);
+    if constexpr (Encoded)
+      genome[c].seq = std::move(seqs[c]);
+    else
+      genome[c].seq = Codec::to_string(seqs[c]);
+  }
+  return genome;
+}
+
+/**
+ * @ingroup utility
+ * @brief Simulate reads number first to first + count - 1 sequenced from
+ * genome.
+ *
+ * The start of every read is uniform over the whole genome and its strand
+ * is reverse with `profile.reverse_rate`. Substitutions, insertions and
+ * deletions are introduced with the rates of profile, and qualities are
+ * drawn independently from a normal distribution around the mean quality
+ * of their position. N bases of the genome are kept with the minimum
+ * quality. Reads are named `<chrom>_<start>_<+|->_<number>`, where start
+ * is the 0-based leftmost position of the read on the forward strand.
+ *
+ * Every read only depends on seed, profile, genome and its number, so a
+ * large set of reads can be generated in batches of any size and the reads
+ * of one call are generated in parallel.
+ *
+ * Example
+ * ```cpp
+ * const auto genome = biovoltron::simulate_genome({.length = 1'000'000});
+ * auto fq = std::ofstream{"reads.fq"};
+ * for (auto first = 0; first < 10'000'000; first += 100'000)
+ *   for (const auto &read : biovoltron::simulate_reads(genome, first, 100'000))
+ *     fq << read << "\n";
+ * ```
+ *
+ * @tparam Encoded Whether to return FastqRecord<true> with 0-4 sequences.
+ */
+template <bool Encoded = false, bool GenomeEncoded>
+inline auto
+simulate_reads(const std::vector<FastaRecord<GenomeEncoded>> &genome,
+               std::size_t first, std::size_t count,
+               const ReadProfile &profile = {}, std::uint64_t seed = 0) {
+  auto ends = std::vector<std::size_t>{};
+  for (auto total = std::size_t{}; const auto &chrom : genome)
+    ends.push_back(total += chrom.seq.size());
+  const auto length = profile.read_length;
+  // Deletions consume more reference than the length of the read.
+  const auto span = length + length / 8 + 8;
+  const auto models = detail::position_models(profile);
+
+  auto reads = std::vector<FastqRecord<Encoded>>(
+      genome.empty() || ends.back() == 0 ? 0 : count);
+  auto ids = std::vector<std::size_t>(reads.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  std::for_each(std::execution::par, ids.begin(), ids.end(), [&](auto i) {
+    auto gen = detail::chunk_generator(seed, first + i);
+    const auto pos = gen.below(ends.back());
+    const auto c = std::ranges::upper_bound(ends, pos) - ends.begin();
+    const auto &ref = genome[c].seq;
+    const auto start = std::min<std::size_t>(
+        pos - (ends[c] - ref.size()), ref.size() - std::min(span, ref.size()));
+    const auto reverse = gen.uniform() < profile.reverse_rate;
+
+    auto fragment = istring(std::min(span, ref.size()), 0);
+    for (auto j = std::size_t{}; j < fragment.size(); j++)
+      if constexpr (GenomeEncoded)
+        fragment[j] = ref[start + j];
+      else
+        fragment[j] = Codec::to_int(ref[start + j]);
+    if (reverse)
+      fragment = Codec::rev_comp(istring_view{fragment});
+
+    auto seq = istring{};
+    auto qual = std::string{};
+    seq.reserve(length);
+    qual.reserve(length);
+    auto j = std::size_t{};
+    while (seq.size() < length && j < fragment.size()) {
+      const auto &model = models[seq.size()];
+      const auto r = gen();
+      if (r < model.deletion) {
+        j++;
+        continue;
+      }
+      // The high half of s picks the quality, the low half substitutions.
+      // Counting the thresholds below the draw avoids the mispredicted
+      // branches of a binary search.
+      const auto s = gen();
+      const auto x = static_cast<std::uint32_t>(s >> 32);
+      auto quality = profile.min_quality;
+      for (const auto threshold : model.qualities)
+        quality += threshold <= x;
+      auto base = fragment[j];
+      if (r < model.insertion)
+        base = r & 3;
+      else {
+        j++;
+        if (base != 4 && static_cast<std::uint32_t>(s) < model.substitution)
+          base = (base + 1 + gen.below(3)) % 4;
+      }
+      seq.push_back(base);
+      // Phred+33
+      qual += static_cast<char>('!' +
+                                (base == 4 ? profile.min_quality : quality));
+    }
+
+    auto &read = reads[i];
+    const auto left = reverse ? start + fragment.size() - j : start;
+    read.name = genome[c].name + "_" + std::to_string(left) +
+                (reverse ? "_-_" : "_+_") + std::to_string(first + i);
+    if constexpr (Encoded)
+      read.seq = std::move(seq);
+    else
+      read.seq = Codec::to_string(seq);
+    read.qual = std::move(qual);
+  });
+  return reads;
+}
+
+} // namespace biovoltron
@@ -0,0 +1,92 @@
+#include <biovoltron/algo/align/batch_aligner.hpp>
+#include <biovoltron/utility/simulator.hpp>
+#include <catch.hpp>
+#include <random>
+
+using namespace biovoltron;
+
+namespace {
+
+auto random_seq(std::size_t size, double n_rate, std::mt19937 &gen) {
+  auto base = std::uniform_int_distribution<int>{0, 3};
+  auto coin = std::uniform_real_distribution<double>{};
+  auto seq = istring{};
+  for (auto i = std::size_t{}; i < size; i++)
+    seq += coin(gen) < n_rate ? 4 : base(gen);
+  return seq;
+}
+
+auto one_by_one(const BatchAligner &aligner,
+                const std::vector<istring_view> &queries,
+                const std::vector<istring_view> &refs) {
+  const auto single = PairwiseAligner{
+      .scoring = aligner.scoring, .mode = aligner.mode, .cigar = aligner.cigar};
+  auto alignments = std::vector<Alignment>{};
+  for (auto k = std::size_t{}; k < queries.size(); k++)
+    alignments.push_back(single(queries[k], refs[k]));
+  return alignments;
+}
+
+} // namespace
+
+TEST_CASE("BatchAligner - Same results as PairwiseAligner", "[BatchAligner]") {
+  auto gen = std::mt19937{1};
+  auto size = std::uniform_int_distribution<std::size_t>{0, 200};
+  auto seqs = std::vector<istring>{};
+  for (auto k = 0; k < 2 * 150; k++)
+    seqs.push_back(random_seq(size(gen), 0.02, gen));
+  // Every other pair is related, a query inside a longer reference.
+  for (auto k = 0; k < 150; k += 2) {
+    const auto &ref = seqs[2 * k + 1];
+    const auto begin = ref.size() / 4;
+    seqs[2 * k] = ref.substr(begin, ref.size() / 2);
+    if (!seqs[2 * k].empty())
+      seqs[2 * k][seqs[2 * k].size() / 2] = 4;
+  }
+  // Long local alignments overflow 8-bit scores.
+  seqs[10] = seqs[11] = random_seq(600, 0, gen);
+  auto queries = std::vector<istring_view>{}, refs = queries;
+  for (auto k = std::size_t{}; k < seqs.size(); k += 2) {
+    queries.push_back(seqs[k]);
+    refs.push_back(seqs[k + 1]);
+  }
+
+  const auto scorings = std::vector<AlignScoring>{
+      {}, {.match = 2, .mismatch = 3, .gap_open = 0, .gap_extend = 2}};
+  for (const auto &scoring : scorings)
+    for (const auto mode : {AlignMode::GLOBAL, AlignMode::LOCAL,
+                            AlignMode::SEMI_GLOBAL, AlignMode::EXTEND})
+      for (const auto cigar : {false, true}) {
+        const auto aligner =
+            BatchAligner{.scoring = scoring, .mode = mode, .cigar = cigar};
+        const auto expected = one_by_one(aligner, queries, refs);
+        REQUIRE(aligner(queries, refs) == expected);
+        const auto previous = set_simd_level(SimdLevel::SCALAR);
+        REQUIRE(aligner(queries, refs) == expected);
+        set_simd_level(previous);
+      }
+}
+
+TEST_CASE("BatchAligner - Reads against their origin", "[BatchAligner]") {
+  const auto genome = simulate_genome<true>({.length = 100'000}, 1);
+  const auto reads = simulate_reads<true>(
+      genome, 0, 100, {.substitution_rate = 0.01, .reverse_rate = 0}, 1);
+  auto windows = std::vector<istring_view>{};
+  for (const auto &read : reads) {
+    const auto start = std::stoul(read.name.substr(read.name.find('_') + 1));
+    const auto begin = std::max<std::size_t>(start, 20) - 20;
+    windows.push_back(istring_view{genome[0].seq}.substr(begin, 190));
+  }
+  const auto aligner = BatchAligner{.mode = AlignMode::LOCAL, .cigar = true};
+  const auto alignments = aligner(reads, windows);
+  REQUIRE(alignments.size() == reads.size());
+  for (auto k = std::size_t{}; k < reads.size(); k++) {
+    REQUIRE(alignments[k] ==
+            PairwiseAligner{.mode = AlignMode::LOCAL, .cigar = true}(
+                reads[k].seq, windows[k]));
+    REQUIRE(alignments[k].score > 75);
+  }
+
+  REQUIRE(aligner(std::vector<FastqRecord<true>>{}, {}).empty());
+  REQUIRE_THROWS_AS(aligner(reads, {}), std::invalid_argument);
+}
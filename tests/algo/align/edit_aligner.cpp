@@ -0,0 +1,161 @@
+#include <biovoltron/algo/align/edit_aligner.hpp>
+#include <catch.hpp>
+#include <random>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+auto random_seq(std::size_t size, double n_rate, std::mt19937 &gen) {
+  auto base = std::uniform_int_distribution<int>{0, 3};
+  auto coin = std::uniform_real_distribution<double>{};
+  auto seq = istring{};
+  for (auto i = std::size_t{}; i < size; i++)
+    seq += coin(gen) < n_rate ? 4 : base(gen);
+  return seq;
+}
+
+// A copy of seq with single base substitutions, insertions and deletions,
+// each at the given rate per base.
+auto mutate(istring_view seq, double rate, std::mt19937 &gen) {
+  auto base = std::uniform_int_distribution<int>{0, 3};
+  auto coin = std::uniform_real_distribution<double>{};
+  auto out = istring{};
+  for (const auto c : seq) {
+    if (coin(gen) < rate)
+      out += base(gen);
+    else if (coin(gen) < rate)
+      out += {static_cast<ichar>(base(gen)), c};
+    else if (coin(gen) >= rate)
+      out += c;
+  }
+  return out;
+}
+
+// The distance and smallest text end of the whole matrix.
+auto naive(istring_view pattern, istring_view text, EditMode mode) {
+  const auto m = pattern.size(), n = text.size();
+  auto d = std::vector(m + 1, std::vector<long>(n + 1));
+  for (auto j = 0u; j <= n; j++)
+    d[0][j] = mode == EditMode::INFIX ? 0 : j;
+  for (auto i = 1u; i <= m; i++) {
+    d[i][0] = i;
+    for (auto j = 1u; j <= n; j++)
+      d[i][j] = std::min({d[i - 1][j - 1] + (pattern[i - 1] != text[j - 1]),
+                          d[i - 1][j] + 1, d[i][j - 1] + 1});
+  }
+  if (mode == EditMode::GLOBAL)
+    return std::pair{d[m][n], n};
+  auto best = std::pair{d[m][0], std::size_t{}};
+  for (auto j = 1u; j <= n; j++)
+    if (d[m][j] < best.first)
+      best = {d[m][j], j};
+  return best;
+}
+
+// The edits of a CIGAR, checking that it consumes the aligned parts.
+auto edits(istring_view pattern, istring_view text, const EditAlignment &a) {
+  auto i = std::size_t{}, j = std::size_t{a.text_begin};
+  auto count = 0l;
+  auto in = std::istringstream{a.cigar};
+  auto size = std::size_t{};
+  auto op = char{};
+  while (in >> size >> op) {
+    if (op == 'M')
+      for (auto k = std::size_t{}; k < size; k++)
+        count += pattern[i++] != text[j++];
+    else {
+      count += size;
+      (op == 'I' ? i : j) += size;
+    }
+  }
+  REQUIRE(i == pattern.size());
+  REQUIRE(j == a.text_end);
+  return count;
+}
+
+auto check(istring_view pattern, istring_view text, EditMode mode,
+           std::size_t max_distance) {
+  const auto [distance, end] = naive(pattern, text, mode);
+  auto aligner = EditAligner{.mode = mode, .max_distance = max_distance};
+  const auto alignment = aligner(pattern, text);
+  if (static_cast<std::size_t>(distance) > max_distance) {
+    REQUIRE(alignment == EditAlignment{});
+    return;
+  }
+  REQUIRE(alignment.distance == distance);
+  REQUIRE(alignment.text_end == end);
+  aligner.cigar = true;
+  const auto traced = aligner(pattern, text);
+  REQUIRE(traced.distance == distance);
+  REQUIRE(traced.text_end == end);
+  REQUIRE(edits(pattern, text, traced) == distance);
+  if (mode != EditMode::INFIX)
+    REQUIRE(traced.text_begin == 0);
+}
+
+constexpr auto MODES = {EditMode::GLOBAL, EditMode::PREFIX, EditMode::INFIX};
+
+} // namespace
+
+TEST_CASE("EditAligner - Distances of the whole matrix", "[EditAligner]") {
+  auto gen = std::mt19937{1};
+  auto size = std::uniform_int_distribution<std::size_t>{0, 150};
+  for (const auto mode : MODES)
+    for (auto t = 0; t < 300; t++) {
+      const auto text = random_seq(size(gen), 0.02, gen);
+      auto pattern = mutate(text, 0.05, gen);
+      if (t % 3 == 0)
+        pattern = random_seq(size(gen), 0.02, gen);
+      else if (t % 3 == 1 && text.size() > 20)
+        pattern = mutate(istring_view{text}.substr(10, text.size() - 20),
+                         0.05, gen);
+      for (const auto max_distance : {std::size_t{0}, std::size_t{4},
+                                      std::size_t{20}, std::size_t(-1)})
+        check(pattern, text, mode, max_distance);
+    }
+}
+
+TEST_CASE("EditAligner - Patterns of many blocks", "[EditAligner]") {
+  auto gen = std::mt19937{2};
+  for (const auto mode : MODES)
+    for (const auto rate : {0.005, 0.02, 0.1})
+      for (const auto max_distance : {std::size_t{10}, std::size_t{100},
+                                      std::size_t{300}, std::size_t(-1)}) {
+        const auto text = random_seq(1200, 0.01, gen);
+        check(mutate(text, rate, gen), text, mode, max_distance);
+        check(mutate(istring_view{text}.substr(300, 500), rate, gen), text,
+              mode, max_distance);
+      }
+  const auto text = random_seq(700, 0, gen);
+  check(random_seq(650, 0, gen), text, EditMode::GLOBAL, -1);
+  check(random_seq(300, 0, gen), text, EditMode::INFIX, -1);
+}
+
+TEST_CASE("EditAligner - Edge cases", "[EditAligner]") {
+  const auto acgt = Codec::to_istring("ACGT");
+  auto aligner = EditAligner{.cigar = true};
+  REQUIRE(aligner(acgt, {}) == EditAlignment{4, 0, 0, "4I"});
+  REQUIRE(aligner({}, acgt) == EditAlignment{4, 0, 4, "4D"});
+  REQUIRE(aligner({}, {}) == EditAlignment{0, 0, 0, ""});
+  REQUIRE(aligner(acgt, Codec::to_istring("AGT")) ==
+          EditAlignment{1, 0, 3, "1M1I2M"});
+  aligner.max_distance = 0;
+  REQUIRE(aligner(acgt, Codec::to_istring("AGT")) == EditAlignment{});
+
+  aligner = {.mode = EditMode::PREFIX, .cigar = true};
+  REQUIRE(aligner({}, acgt) == EditAlignment{0, 0, 0, ""});
+  REQUIRE(aligner(acgt, Codec::to_istring("ACGTACGT")) ==
+          EditAlignment{0, 0, 4, "4M"});
+  REQUIRE(aligner(acgt, Codec::to_istring("TTTT")) ==
+          EditAlignment{3, 0, 1, "3I1M"});
+
+  aligner = {.mode = EditMode::INFIX, .cigar = true};
+  REQUIRE(aligner(acgt, Codec::to_istring("TTACGTTACGT")) ==
+          EditAlignment{0, 2, 6, "4M"});
+  REQUIRE(aligner(acgt, Codec::to_istring("GGGG")) ==
+          EditAlignment{3, 0, 1, "2I1M1I"});
+  REQUIRE(aligner(Codec::to_istring("ANGT"), Codec::to_istring("CANGTC")) ==
+          EditAlignment{0, 1, 5, "4M"});
+}
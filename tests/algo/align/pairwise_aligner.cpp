@@ -0,0 +1,209 @@
+#include <biovoltron/algo/align/pairwise_aligner.hpp>
+#include <catch.hpp>
+#include <random>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+auto random_seq(std::size_t size, double n_rate, std::mt19937 &gen) {
+  auto base = std::uniform_int_distribution<int>{0, 3};
+  auto coin = std::uniform_real_distribution<double>{};
+  auto seq = istring{};
+  for (auto i = std::size_t{}; i < size; i++)
+    seq += coin(gen) < n_rate ? 4 : base(gen);
+  return seq;
+}
+
+// A copy of seq with substitutions, insertions and deletions of up to 8
+// bases, each at the given rate per base.
+auto mutate(istring_view seq, double rate, std::mt19937 &gen) {
+  auto base = std::uniform_int_distribution<int>{0, 3};
+  auto length = std::uniform_int_distribution<std::size_t>{1, 8};
+  auto coin = std::uniform_real_distribution<double>{};
+  auto out = istring{};
+  for (auto i = std::size_t{}; i < seq.size(); i++) {
+    if (coin(gen) < rate)
+      out += base(gen);
+    else if (coin(gen) < rate)
+      out += random_seq(length(gen), 0, gen) + seq[i];
+    else if (coin(gen) < rate)
+      i += length(gen) - 1;
+    else
+      out += seq[i];
+  }
+  return out;
+}
+
+// Gotoh's recurrences over the whole matrix, straight from the definition.
+auto naive_score(istring_view q, istring_view r, AlignMode mode,
+                 const AlignScoring &sc) {
+  constexpr auto NEG = -(1l << 40);
+  const auto n = q.size(), m = r.size();
+  const auto local = mode == AlignMode::LOCAL;
+  const auto gap = [&](std::size_t l) {
+    return -(sc.gap_open + sc.gap_extend * static_cast<long>(l));
+  };
+  auto h = std::vector(n + 1, std::vector<long>(m + 1, NEG));
+  auto e = h, f = h;
+  h[0][0] = 0;
+  for (auto j = 1u; j <= m; j++)
+    h[0][j] =
+        mode == AlignMode::GLOBAL || mode == AlignMode::EXTEND ? gap(j) : 0;
+  for (auto i = 1u; i <= n; i++)
+    h[i][0] = local ? 0 : gap(i);
+  auto best = mode == AlignMode::SEMI_GLOBAL ? h[n][0] : 0;
+  for (auto i = 1u; i <= n; i++)
+    for (auto j = 1u; j <= m; j++) {
+      e[i][j] = std::max(h[i][j - 1] - sc.gap_open - sc.gap_extend,
+                         e[i][j - 1] - sc.gap_extend);
+      f[i][j] = std::max(h[i - 1][j] - sc.gap_open - sc.gap_extend,
+                         f[i - 1][j] - sc.gap_extend);
+      h[i][j] = std::max({h[i - 1][j - 1] + sc.score(q[i - 1], r[j - 1]),
+                          e[i][j], f[i][j], local ? 0 : NEG});
+      if (local || mode == AlignMode::EXTEND ||
+          (mode == AlignMode::SEMI_GLOBAL && i == n))
+        best = std::max(best, h[i][j]);
+    }
+  return mode == AlignMode::GLOBAL ? h[n][m] : best;
+}
+
+// The score of a CIGAR, checking that it consumes the aligned parts.
+auto rescore(istring_view query, istring_view ref, const Alignment &a,
+             const AlignScoring &sc) {
+  auto i = std::size_t{a.query_begin}, j = std::size_t{a.ref_begin};
+  auto score = 0l;
+  auto in = std::istringstream{a.cigar};
+  auto size = std::size_t{};
+  auto op = char{};
+  while (in >> size >> op) {
+    if (op == 'M')
+      for (auto k = std::size_t{}; k < size; k++)
+        score += sc.score(query[i++], ref[j++]);
+    else {
+      score -= sc.gap_open + sc.gap_extend * static_cast<long>(size);
+      (op == 'I' ? i : j) += size;
+    }
+  }
+  REQUIRE(i == a.query_end);
+  REQUIRE(j == a.ref_end);
+  return score;
+}
+
+template <class F> auto with_level(SimdLevel level, F &&f) {
+  const auto previous = simd_level();
+  set_simd_level(level);
+  auto result = f();
+  set_simd_level(previous);
+  return result;
+}
+
+constexpr auto MODES = {AlignMode::GLOBAL, AlignMode::LOCAL,
+                        AlignMode::SEMI_GLOBAL, AlignMode::EXTEND};
+
+const auto SCORINGS = std::vector<AlignScoring>{
+    {}, {.match = 2, .mismatch = 3, .gap_open = 0, .gap_extend = 2},
+    {.match = 5, .mismatch = 2, .gap_open = 30, .gap_extend = 3,
+     .ambiguous = 0}};
+
+} // namespace
+
+TEST_CASE("PairwiseAligner - Scores of Gotoh's recurrences",
+          "[PairwiseAligner]") {
+  auto gen = std::mt19937{1};
+  auto size = std::uniform_int_distribution<std::size_t>{0, 120};
+  for (const auto &scoring : SCORINGS)
+    for (const auto mode : MODES)
+      for (auto t = 0; t < 40; t++) {
+        const auto ref = random_seq(size(gen), 0.02, gen);
+        auto query = mutate(ref, 0.05, gen);
+        if (t % 4 == 0)
+          query = random_seq(size(gen), 0.02, gen);
+        else if (t % 4 == 1 && ref.size() > 20)
+          query = mutate(istring_view{ref}.substr(10, ref.size() - 20), 0.05,
+                         gen);
+        const auto aligner =
+            PairwiseAligner{.scoring = scoring, .mode = mode, .cigar = true};
+        const auto alignment = aligner(query, ref);
+        REQUIRE(alignment.score == naive_score(query, ref, mode, scoring));
+        REQUIRE(rescore(query, ref, alignment, scoring) == alignment.score);
+        REQUIRE(with_level(SimdLevel::SCALAR,
+                           [&] { return aligner(query, ref); }) == alignment);
+      }
+}
+
+TEST_CASE("PairwiseAligner - Banded alignments", "[PairwiseAligner]") {
+  auto gen = std::mt19937{2};
+  for (const auto &scoring : SCORINGS)
+    for (const auto mode : MODES)
+      for (const auto band : {0, 1, 5, 16, 40}) {
+        const auto ref = random_seq(300, 0.01, gen);
+        const auto query = mutate(ref, 0.03, gen);
+        const auto full = PairwiseAligner{.scoring = scoring, .mode = mode};
+        auto aligner = full;
+        aligner.band = band;
+        aligner.cigar = true;
+        const auto alignment = aligner(query, ref);
+        REQUIRE(alignment.score <= full(query, ref).score);
+        REQUIRE(rescore(query, ref, alignment, scoring) == alignment.score);
+        REQUIRE(with_level(SimdLevel::SCALAR,
+                           [&] { return aligner(query, ref); }) == alignment);
+        aligner.band = 300;
+        REQUIRE(aligner(query, ref).score == full(query, ref).score);
+      }
+}
+
+TEST_CASE("PairwiseAligner - Scores beyond 8 and 16 bits",
+          "[PairwiseAligner]") {
+  auto gen = std::mt19937{3};
+  const auto ref = random_seq(12'000, 0.001, gen);
+  const auto query = mutate(istring_view{ref}.substr(1000, 2000), 0.002, gen);
+  for (const auto mode : MODES) {
+    const auto aligner = PairwiseAligner{.mode = mode, .cigar = true};
+    const auto alignment = aligner(query, ref);
+    REQUIRE(with_level(SimdLevel::SCALAR,
+                       [&] { return aligner(query, ref); }) == alignment);
+    REQUIRE(rescore(query, ref, alignment, aligner.scoring) ==
+            alignment.score);
+  }
+  REQUIRE(PairwiseAligner{.mode = AlignMode::LOCAL}(query, ref).score > 1500);
+
+  const auto far = random_seq(40'000, 0, gen);
+  const auto head = istring_view{query}.substr(0, 100);
+  const auto global = PairwiseAligner{}(head, far);
+  REQUIRE(global.score < -32768);
+  REQUIRE(with_level(SimdLevel::SCALAR,
+                     [&] { return PairwiseAligner{}(head, far); }) == global);
+}
+
+TEST_CASE("PairwiseAligner - Edge cases", "[PairwiseAligner]") {
+  const auto aligner = PairwiseAligner{.mode = AlignMode::LOCAL, .cigar = true};
+  auto alignment = aligner(Codec::to_istring("ACGTTA"),
+                           Codec::to_istring("GGACGTA"));
+  REQUIRE(alignment == Alignment{4, 0, 4, 2, 6, "4M"});
+  REQUIRE(aligner(Codec::to_istring("AAAA"), Codec::to_istring("CCCC")) ==
+          Alignment{});
+
+  const auto acgt = Codec::to_istring("ACGT");
+  auto global = PairwiseAligner{.cigar = true};
+  REQUIRE(global(acgt, {}) == Alignment{-10, 0, 4, 0, 0, "4I"});
+  REQUIRE(global({}, acgt) == Alignment{-10, 0, 0, 0, 4, "4D"});
+  REQUIRE(global({}, {}) == Alignment{});
+  REQUIRE(global(acgt, acgt) == Alignment{4, 0, 4, 0, 4, "4M"});
+  global.mode = AlignMode::SEMI_GLOBAL;
+  REQUIRE(global(acgt, {}) == Alignment{-10, 0, 4, 0, 0, "4I"});
+  REQUIRE(global({}, acgt) == Alignment{});
+  REQUIRE(global(acgt, Codec::to_istring("TTACGTTT")) ==
+          Alignment{4, 0, 4, 2, 6, "4M"});
+  global.mode = AlignMode::EXTEND;
+  REQUIRE(global(Codec::to_istring("ACGTCCCC"),
+                 Codec::to_istring("ACGTAAAA")) ==
+          Alignment{4, 0, 4, 0, 4, "4M"});
+
+  REQUIRE_THROWS_AS(PairwiseAligner{.scoring = {.mismatch = -1}}(acgt, acgt),
+                    std::invalid_argument);
+  const auto free_gaps = AlignScoring{.gap_open = 0, .gap_extend = 0};
+  REQUIRE_THROWS_AS(PairwiseAligner{.scoring = free_gaps}(acgt, acgt),
+                    std::invalid_argument);
+}
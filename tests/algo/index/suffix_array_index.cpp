@@ -0,0 +1,162 @@
+#include <biovoltron/algo/index/suffix_array_index.hpp>
+#include <catch.hpp>
+#include <random>
+
+using namespace biovoltron;
+
+namespace {
+
+auto random_seq(std::size_t size, double n_rate, std::mt19937 &gen) {
+  auto base = std::uniform_int_distribution<int>{0, 3};
+  auto coin = std::uniform_real_distribution<double>{};
+  auto seq = istring{};
+  for (auto i = std::size_t{}; i < size; i++)
+    seq += coin(gen) < n_rate ? 4 : base(gen);
+  return seq;
+}
+
+// A copy of seq with the given numbers of substitutions and of single base
+// insertions and deletions.
+auto mutate(istring seq, int substitutions, int indels, std::mt19937 &gen) {
+  auto base = std::uniform_int_distribution<int>{0, 3};
+  for (auto e = 0; e < substitutions + indels && !seq.empty(); e++) {
+    const auto i = std::uniform_int_distribution<std::size_t>{
+        0, seq.size() - 1}(gen);
+    if (e < substitutions)
+      seq[i] = base(gen);
+    else if (gen() % 2)
+      seq.insert(seq.begin() + i, static_cast<ichar>(base(gen)));
+    else
+      seq.erase(i, 1);
+  }
+  return seq;
+}
+
+// Every position of the reference, trying every match length.
+auto naive(istring_view ref, istring_view pattern, std::size_t k,
+           SearchMetric metric) {
+  const auto m = pattern.size();
+  auto matches = std::vector<ApproximateMatch>{};
+  for (auto p = std::size_t{}; p < ref.size(); p++) {
+    if (metric == SearchMetric::HAMMING) {
+      if (p + m > ref.size())
+        break;
+      auto d = std::size_t{};
+      for (auto i = std::size_t{}; i < m; i++)
+        d += pattern[i] != ref[p + i];
+      if (d <= k)
+        matches.push_back({p, static_cast<std::uint32_t>(d),
+                           static_cast<std::uint32_t>(m)});
+      continue;
+    }
+    const auto text = ref.substr(p, m + k);
+    auto column = std::vector<std::size_t>(m + 1);
+    std::iota(column.begin(), column.end(), 0);
+    auto best = ApproximateMatch{p, static_cast<std::uint32_t>(k + 1), 0};
+    for (auto j = std::size_t{}; j < text.size(); j++) {
+      auto diagonal = column[0]++;
+      for (auto i = 1u; i <= m; i++) {
+        const auto above = column[i];
+        column[i] = std::min({diagonal + (pattern[i - 1] != text[j]),
+                              column[i] + 1, column[i - 1] + 1});
+        diagonal = above;
+      }
+      if (column[m] < best.distance)
+        best = {p, static_cast<std::uint32_t>(column[m]),
+                static_cast<std::uint32_t>(j + 1)};
+    }
+    if (best.distance <= k)
+      matches.push_back(best);
+  }
+  return matches;
+}
+
+} // namespace
+
+TEST_CASE("SuffixArrayIndex - Exact search", "[SuffixArrayIndex]") {
+  auto gen = std::mt19937{1};
+  const auto ref = random_seq(5000, 0.01, gen);
+  const auto index = SuffixArrayIndex{ref};
+  REQUIRE(index.reference() == ref);
+  REQUIRE(index.suffix_array().size() == ref.size() + 1);
+  REQUIRE(index.find({}).size() == ref.size() + 1);
+  for (const auto length : {1, 3, 5, 8, 12, 30}) {
+    const auto start = gen() % (ref.size() - length);
+    const auto pattern = istring_view{ref}.substr(start, length);
+    auto positions = index.locate(index.find(pattern));
+    std::ranges::sort(positions);
+    auto expected = std::vector<std::uint32_t>{};
+    for (auto p = ref.find(pattern); p != istring::npos;
+         p = ref.find(pattern, p + 1))
+      expected.push_back(p);
+    REQUIRE(positions == expected);
+  }
+  REQUIRE(index.find(random_seq(40, 0, gen)).empty());
+}
+
+TEST_CASE("SuffixArrayIndex - Approximate search", "[SuffixArrayIndex]") {
+  auto gen = std::mt19937{2};
+  auto ref = random_seq(4000, 0.005, gen);
+  // Near repeats, so patterns match at several positions.
+  const auto repeat = istring_view{ref}.substr(1000, 60);
+  for (const auto at : {200, 2500, 3900})
+    ref.replace(at, 60, mutate(istring{repeat}, 2, 0, gen));
+  const auto index = SuffixArrayIndex{ref};
+
+  for (const auto metric : {SearchMetric::HAMMING, SearchMetric::EDIT})
+    for (const auto k : {0, 1, 2, 3})
+      for (auto t = 0; t < 20; t++) {
+        const auto length = std::uniform_int_distribution<std::size_t>{
+            8, 60}(gen);
+        const auto start = gen() % (ref.size() - length);
+        const auto indels = metric == SearchMetric::EDIT ? t % 2 : 0;
+        auto pattern = mutate(ref.substr(start, length), t % 3, indels, gen);
+        if (t % 5 == 0)
+          pattern = istring{repeat.substr(t % 7, 40)};
+        REQUIRE(index.search(pattern, k, metric) ==
+                naive(ref, pattern, k, metric));
+      }
+
+  const auto pattern = random_seq(6, 0, gen);
+  REQUIRE(index.search(istring_view{}, 2).empty());
+  REQUIRE(index.search(pattern, 6).size() == ref.size() - 5);
+  REQUIRE(index.search(pattern, 9, SearchMetric::EDIT).size() == ref.size());
+}
+
+TEST_CASE("SuffixArrayIndex - Batches of patterns", "[SuffixArrayIndex]") {
+  auto gen = std::mt19937{3};
+  const auto ref = random_seq(20'000, 0.001, gen);
+  const auto index = SuffixArrayIndex{ref};
+  auto patterns = std::vector<istring>{};
+  for (auto i = 0; i < 300; i++) {
+    const auto start = gen() % (ref.size() - 50);
+    patterns.push_back(mutate(ref.substr(start, 50), i % 3, i % 2, gen));
+  }
+  patterns.push_back(patterns.front());
+  const auto views = std::vector<istring_view>(patterns.begin(),
+                                               patterns.end());
+  for (const auto metric : {SearchMetric::HAMMING, SearchMetric::EDIT}) {
+    const auto matches = index.search(views, 2, metric);
+    REQUIRE(matches.size() == patterns.size());
+    for (auto i = std::size_t{}; i < patterns.size(); i++)
+      REQUIRE(matches[i] == index.search(patterns[i], 2, metric));
+  }
+}
+
+TEST_CASE("SuffixArrayIndex - K-ordered suffix arrays", "[SuffixArrayIndex]") {
+  auto gen = std::mt19937{4};
+  const auto ref = random_seq(3000, 0.01, gen);
+  const auto index = SuffixArrayIndex<StableSorter<std::uint32_t, 12>>{ref};
+  for (auto t = 0; t < 20; t++) {
+    const auto pattern = mutate(ref.substr(gen() % 2900, 10), t % 3, 0, gen);
+    REQUIRE(index.search(pattern, 1) ==
+            naive(ref, pattern, 1, SearchMetric::HAMMING));
+    REQUIRE(index.search(pattern, 2, SearchMetric::EDIT) ==
+            naive(ref, pattern, 2, SearchMetric::EDIT));
+  }
+  const auto pattern = ref.substr(0, 11);
+  REQUIRE_NOTHROW(index.search(pattern, 3));
+  REQUIRE_THROWS_AS(index.search(pattern, 3, SearchMetric::EDIT),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(index.find(ref.substr(0, 13)), std::invalid_argument);
+}
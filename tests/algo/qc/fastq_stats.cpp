@@ -0,0 +1,108 @@
+#include <biovoltron/algo/qc/fastq_stats.hpp>
+#include <catch.hpp>
+#include <map>
+#include <random>
+#include <sstream>
+
+using namespace biovoltron;
+
+TEST_CASE("FastqStats collecting test", "[FastqStats]") {
+  const auto fastq = std::string{"@r1\nACGT\n+\n!!II\n"
+                                 "@r2\nGGCN\n+\nIIII\n"
+                                 "@r3\nACGT\n+\n!!II\n"
+                                 "@r4\nAT\n+\n55\n"};
+
+  auto stats = FastqStats{};
+  std::istringstream is(fastq);
+  for (auto batch = FastqBatch<>{}; is >> batch;)
+    stats.add(batch);
+
+  REQUIRE(stats.reads == 4);
+  REQUIRE(stats.bases == 14);
+  REQUIRE(stats.max_length() == 4);
+  REQUIRE(stats.length_counts[2] == 1);
+  REQUIRE(stats.length_counts[4] == 3);
+
+  REQUIRE(stats.base_counts[0][0] == 3);
+  REQUIRE(stats.base_counts[2][0] == 1);
+  REQUIRE(stats.base_counts[3][1] == 1);
+  REQUIRE(stats.base_counts[4][3] == 1);
+  REQUIRE(stats.n_count() == 1);
+  REQUIRE(stats.coverage(0) == 4);
+  REQUIRE(stats.coverage(3) == 3);
+  REQUIRE(stats.gc_content() == Approx(7.0 / 13));
+
+  REQUIRE(stats.qual_counts[0 * FastqStats::QUAL_LEVELS + 0] == 2);
+  REQUIRE(stats.qual_counts[0 * FastqStats::QUAL_LEVELS + 40] == 1);
+  REQUIRE(stats.qual_counts[0 * FastqStats::QUAL_LEVELS + 20] == 1);
+  REQUIRE(stats.mean_quality(0) == Approx(15.0));
+  REQUIRE(stats.mean_quality(3) == Approx(40.0));
+
+  REQUIRE(stats.gc_counts[50] == 2);
+  REQUIRE(stats.gc_counts[100] == 1);
+  REQUIRE(stats.gc_counts[0] == 1);
+
+  REQUIRE(stats.prefix_counts.size() == 3);
+  REQUIRE(stats.duplicate_rate() == Approx(0.25));
+}
+
+TEST_CASE("FastqStats merging test", "[FastqStats]") {
+  auto whole = FastqStats{}, part1 = FastqStats{}, part2 = FastqStats{};
+  const auto reads = std::vector<FastqRecord<true>>{
+      {{"r1", "0123"_s}, "IIII"},
+      {{"r2", "012"_s}, "II#"},
+      {{"r3", "33333333"_s}, "########"}};
+
+  for (const auto &read : reads)
+    whole.add(read);
+  part1.add(reads[0]);
+  part2.add(reads[1]);
+  part2.add(reads[2]);
+  part1.merge(part2);
+
+  REQUIRE(part1.reads == whole.reads);
+  REQUIRE(part1.bases == whole.bases);
+  REQUIRE(part1.base_counts == whole.base_counts);
+  REQUIRE(part1.qual_counts == whole.qual_counts);
+  REQUIRE(part1.qual_sums == whole.qual_sums);
+  REQUIRE(part1.length_counts == whole.length_counts);
+  REQUIRE(part1.gc_counts == whole.gc_counts);
+  REQUIRE(part1.prefix_counts == whole.prefix_counts);
+}
+
+TEST_CASE("FastqStats duplicate tracking limit test", "[FastqStats]") {
+  auto gen = std::mt19937{1};
+  auto pool = std::vector<std::string>(FastqStats::DUP_TRACK_LIMIT * 3 / 2);
+  for (auto &seq : pool)
+    for (auto i = 0; i < 30; i++)
+      seq += "ACGT"[gen() % 4];
+  auto reads = std::vector<FastqRecord<>>{};
+  for (auto i = std::size_t{}; i < pool.size() * 2; i++)
+    reads.push_back({{"r", pool[gen() % pool.size()]}, std::string(30, 'I')});
+
+  auto expected = std::map<std::uint64_t, std::uint64_t>{};
+  for (const auto &read : reads)
+    expected[std::hash<std::string_view>{}(read.seq)]++;
+  expected.erase(std::next(expected.begin(), FastqStats::DUP_TRACK_LIMIT),
+                 expected.end());
+
+  auto forward = FastqStats{}, backward = FastqStats{};
+  auto part1 = FastqStats{}, part2 = FastqStats{};
+  for (auto i = std::size_t{}; i < reads.size(); i++) {
+    forward.add(reads[i]);
+    backward.add(reads[reads.size() - 1 - i]);
+    (i % 3 ? part1 : part2).add(reads[i]);
+  }
+  auto merged = part2;
+  merged.merge(part1);
+  part1.merge(part2);
+
+  REQUIRE(forward.prefix_counts.size() == FastqStats::DUP_TRACK_LIMIT);
+  REQUIRE(forward.prefix_counts ==
+          std::unordered_map<std::uint64_t, std::uint64_t>(expected.begin(),
+                                                           expected.end()));
+  for (const auto *stats : {&backward, &part1, &merged}) {
+    REQUIRE(stats->prefix_counts == forward.prefix_counts);
+    REQUIRE(stats->duplicate_rate() == forward.duplicate_rate());
+  }
+}
@@ -0,0 +1,132 @@
+#include <biovoltron/algo/sketch/minimizer.hpp>
+#include <catch.hpp>
+#include <random>
+
+using namespace biovoltron;
+
+namespace {
+
+auto random_seq(std::size_t size, double n_rate, std::mt19937 &gen) {
+  auto base = std::uniform_int_distribution<int>{0, 3};
+  auto coin = std::uniform_real_distribution<double>{};
+  auto seq = istring{};
+  for (auto i = std::size_t{}; i < size; i++)
+    seq += coin(gen) < n_rate ? 4 : base(gen);
+  return seq;
+}
+
+// Straight from the definition: the leftmost smallest hash of every window.
+auto naive_minimizers(istring_view seq, std::size_t w, std::size_t k) {
+  const auto mask = (1ull << 2 * k) - 1;
+  auto hashes = std::vector<std::uint64_t>{};
+  auto reverse = std::vector<bool>{};
+  for (auto p = std::size_t{}; p + k <= seq.size(); p++) {
+    const auto kmer = seq.substr(p, k);
+    const auto rc = Codec::rev_comp(kmer);
+    if (kmer.find(4) != istring_view::npos || istring{kmer} == rc) {
+      hashes.push_back(std::numeric_limits<std::uint64_t>::max());
+      reverse.push_back(false);
+      continue;
+    }
+    const auto fwd = Codec::hash(kmer);
+    const auto rev = Codec::hash(rc);
+    hashes.push_back(invertible_hash(std::min(fwd, rev), mask));
+    reverse.push_back(rev < fwd);
+  }
+  auto out = std::vector<Minimizer>{};
+  for (auto s = std::size_t{}; s + w <= hashes.size(); s++) {
+    const auto window = hashes.begin() + s;
+    const auto it = std::min_element(window, window + w);
+    const auto p = static_cast<std::uint32_t>(it - hashes.begin());
+    if (*it == std::numeric_limits<std::uint64_t>::max())
+      continue;
+    if (out.empty() || out.back().position != p)
+      out.push_back({*it, 0, p, reverse[p]});
+  }
+  return out;
+}
+
+} // namespace
+
+TEST_CASE("invertible_hash - Bijection on 2k bits", "[MinimizerSketch]") {
+  auto gen = std::mt19937_64{1};
+  for (const auto k : {1, 5, 15, 21, 28, 31}) {
+    const auto mask = (1ull << 2 * k) - 1;
+    for (auto i = 0; i < 1000; i++) {
+      const auto key = gen() & mask;
+      const auto hash = invertible_hash(key, mask);
+      REQUIRE(hash <= mask);
+      REQUIRE(invertible_hash_inverse(hash, mask) == key);
+    }
+  }
+  constexpr auto mask = (1ull << 10) - 1;
+  auto seen = std::vector<bool>(mask + 1);
+  for (auto key = 0ull; key <= mask; key++)
+    seen[invertible_hash(key, mask)] = true;
+  REQUIRE(std::ranges::all_of(seen, std::identity{}));
+}
+
+TEST_CASE("MinimizerSketch - Matches the definition", "[MinimizerSketch]") {
+  auto gen = std::mt19937{2};
+  const auto level = simd_level();
+  for (const auto scalar : {false, true}) {
+    if (scalar)
+      set_simd_level(SimdLevel::SCALAR);
+    for (const auto &[w, k] : {std::pair{1, 1}, {5, 4}, {10, 15}, {3, 27},
+                               {50, 12}, {255, 20}}) {
+      const auto sketch = MinimizerSketch(w, k);
+      for (const auto size : {0, 10, 60, 1000, 9000})
+        for (const auto n_rate : {0.0, 0.01, 0.3}) {
+          const auto seq = random_seq(size, n_rate, gen);
+          REQUIRE(sketch(seq) == naive_minimizers(seq, w, k));
+        }
+    }
+    set_simd_level(level);
+  }
+}
+
+TEST_CASE("MinimizerSketch - Strands, keys and inputs", "[MinimizerSketch]") {
+  auto gen = std::mt19937{3};
+  const auto sketch = MinimizerSketch(10, 15);
+  const auto seq = random_seq(5000, 0, gen);
+  const auto minimizers = sketch(seq, 7);
+  REQUIRE(minimizers.size() == Approx(2 * 4986 / 11.0).epsilon(0.1));
+
+  for (const auto &m : minimizers) {
+    REQUIRE(m.id == 7);
+    const auto kmer = istring_view{seq}.substr(m.position, 15);
+    const auto canonical = m.reverse ? Codec::rev_comp(kmer) : istring{kmer};
+    REQUIRE(sketch.key(m) == Codec::hash(canonical));
+  }
+
+  SECTION("The reverse complement has the same minimizers") {
+    auto rc = sketch(Codec::rev_comp(istring_view{seq}), 7);
+    std::ranges::reverse(rc);
+    REQUIRE(rc.size() == minimizers.size());
+    for (auto i = std::size_t{}; i < rc.size(); i++) {
+      REQUIRE(rc[i].hash == minimizers[i].hash);
+      REQUIRE(rc[i].position == 5000 - 15 - minimizers[i].position);
+      REQUIRE(rc[i].reverse != minimizers[i].reverse);
+    }
+  }
+
+  SECTION("DibitVector input") {
+    const auto packed = DibitVector<std::uint32_t>(seq.begin(), seq.end());
+    REQUIRE(sketch(packed, 7) == minimizers);
+  }
+
+  SECTION("Batches") {
+    auto seqs = std::vector<istring>{};
+    for (const auto size : {300, 0, 5000, 40})
+      seqs.push_back(random_seq(size, 0.01, gen));
+    const auto batch = sketch.batch(seqs);
+    auto expected = std::vector<Minimizer>{};
+    for (auto i = 0u; i < seqs.size(); i++)
+      sketch.sketch(seqs[i], i, expected);
+    REQUIRE(batch == expected);
+  }
+
+  REQUIRE_THROWS_AS(MinimizerSketch(0, 15), std::invalid_argument);
+  REQUIRE_THROWS_AS(MinimizerSketch(10, 28), std::invalid_argument);
+  REQUIRE_THROWS_AS(MinimizerSketch(256, 15), std::invalid_argument);
+}
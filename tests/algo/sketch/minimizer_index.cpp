@@ -0,0 +1,165 @@
+#include <biovoltron/algo/sketch/minimizer_index.hpp>
+#include <biovoltron/utility/simulator.hpp>
+#include <catch.hpp>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+auto same_index(const MinimizerIndex &a, const MinimizerIndex &b,
+                const std::vector<Minimizer> &minimizers) {
+  REQUIRE(a.size() == b.size());
+  REQUIRE(a.distinct() == b.distinct());
+  REQUIRE(a.max_occurrences() == b.max_occurrences());
+  REQUIRE(a.names() == b.names());
+  REQUIRE(a.lengths() == b.lengths());
+  for (const auto &m : minimizers)
+    REQUIRE(std::ranges::equal(a.find(m.hash), b.find(m.hash)));
+}
+
+} // namespace
+
+TEST_CASE("MinimizerIndex - Hits of every minimizer", "[MinimizerIndex]") {
+  const auto genome = simulate_genome<true>(
+      {.chromosomes = 3, .length = 200'000, .repeat_fraction = 0.3}, 1);
+  const auto index = MinimizerIndex{genome, 10, 15};
+  REQUIRE(index.names() == std::vector<std::string>{"chr1", "chr2", "chr3"});
+  REQUIRE(index.lengths() == std::vector<std::uint32_t>(3, 200'000));
+
+  auto expected = std::map<std::uint64_t, std::vector<MinimizerHit>>{};
+  auto minimizers = std::vector<Minimizer>{};
+  for (auto id = 0u; id < genome.size(); id++)
+    index.sketch().sketch(genome[id].seq, id, minimizers);
+  for (const auto &m : minimizers)
+    expected[m.hash].push_back({m.id, m.position, m.reverse});
+  REQUIRE(index.size() == minimizers.size());
+  REQUIRE(index.distinct() == expected.size());
+  for (const auto &[hash, hits] : expected)
+    REQUIRE(std::ranges::equal(index.find(hash), hits));
+  REQUIRE(index.find(std::uint64_t{1} << 40).empty());
+
+  SECTION("Repetitive minimizers are filtered") {
+    auto counts = std::vector<std::size_t>{};
+    for (const auto &[hash, hits] : expected)
+      counts.push_back(hits.size());
+    std::ranges::sort(counts);
+    REQUIRE(index.max_occurrences() ==
+            counts[static_cast<std::size_t>(counts.size() * (1 - 2e-4))]);
+    REQUIRE(counts.back() > index.max_occurrences());
+
+    REQUIRE(MinimizerIndex{genome, 10, 15, 0}.max_occurrences() ==
+            std::numeric_limits<std::uint32_t>::max());
+    const auto strict = MinimizerIndex{genome, 10, 15, 0.1};
+    REQUIRE(strict.max_occurrences() < index.max_occurrences());
+    const auto query = istring_view{genome[1].seq}.substr(0, 20'000);
+    auto kept = std::size_t{};
+    for (const auto &m : strict.sketch()(query))
+      if (const auto hits = strict.find(m.hash).size();
+          hits <= strict.max_occurrences())
+        kept += hits;
+    REQUIRE(strict.seeds(query).size() == kept);
+    REQUIRE(kept < strict.seeds(query, -1).size());
+  }
+
+  SECTION("String and encoded references give the same index") {
+    auto decoded = std::vector<FastaRecord<false>>{};
+    for (const auto &record : genome)
+      decoded.push_back(record);
+    same_index(MinimizerIndex{decoded, 10, 15}, index, minimizers);
+  }
+
+  SECTION("Saved and memory mapped") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "biovoltron_index.mmi";
+    {
+      auto os = std::ofstream{path, std::ios::binary};
+      index.save(os);
+    }
+    {
+      const auto loaded = MinimizerIndex::load(path);
+      same_index(loaded, index, minimizers);
+      const auto query = istring_view{genome[2].seq}.substr(5000, 3000);
+      REQUIRE(loaded.seeds(query) == index.seeds(query));
+    }
+    std::filesystem::remove(path);
+  }
+}
+
+TEST_CASE("MinimizerIndex - Seeds of reads", "[MinimizerIndex]") {
+  const auto genome = simulate_genome<true>(
+      {.chromosomes = 2, .length = 100'000, .repeat_fraction = 0}, 2);
+  const auto index = MinimizerIndex{genome, 10, 15};
+  const auto read = istring_view{genome[1].seq}.substr(30'000, 5000);
+  const auto minimizers = index.sketch()(read);
+
+  auto seeds = index.seeds(read);
+  REQUIRE(std::ranges::is_sorted(seeds));
+  const auto on_read = [&](const MinimizerSeed &seed) {
+    return seed.id == 1 && seed.position == seed.query_position + 30'000;
+  };
+  REQUIRE(std::ranges::count_if(seeds, on_read) == std::ssize(minimizers));
+  REQUIRE(std::ranges::all_of(seeds | std::views::filter(on_read),
+                              [](const auto &seed) { return !seed.reverse; }));
+
+  const auto rc = Codec::rev_comp(read);
+  seeds = index.seeds(rc);
+  const auto on_rc = [&](const MinimizerSeed &seed) {
+    return seed.id == 1 && seed.reverse &&
+           seed.position + seed.query_position == 30'000 + 5000 - 15;
+  };
+  REQUIRE(std::ranges::count_if(seeds, on_rc) == std::ssize(minimizers));
+}
+
+TEST_CASE("MinimizerIndex - Edge cases", "[MinimizerIndex]") {
+  const auto empty = MinimizerIndex{std::vector<FastaRecord<>>{}};
+  REQUIRE(empty.size() == 0);
+  REQUIRE(empty.find(0).empty());
+  const auto query = Codec::to_istring("ACGTTGCAACGTAGGCTAGCTAGGATCCA");
+  REQUIRE(empty.seeds(query).empty());
+
+  const auto short_seqs =
+      MinimizerIndex{std::vector<FastaRecord<>>{{"a", "ACGT"}, {"b", ""}}};
+  REQUIRE(short_seqs.size() == 0);
+  REQUIRE(short_seqs.names().size() == 2);
+
+  REQUIRE_THROWS_AS(MinimizerIndex(std::vector<FastaRecord<>>{}, 0, 15),
+                    std::invalid_argument);
+
+  const auto path =
+      std::filesystem::temp_directory_path() / "biovoltron_index_bad.mmi";
+  {
+    auto os = std::ofstream{path, std::ios::binary};
+    os << std::string_view{"BVMMI\0\0\1 truncated", 18};
+  }
+  REQUIRE_THROWS_AS(MinimizerIndex::load(path), std::runtime_error);
+  {
+    auto os = std::ofstream{path, std::ios::binary};
+    empty.save(os);
+  }
+  REQUIRE(MinimizerIndex::load(path).size() == 0);
+
+  // Point the hits of a minimizer past the end of the file.
+  const auto small = MinimizerIndex{std::vector<FastaRecord<>>{
+      {"a", "ACGTTGCAACGTAGGCTAGCTAGGATCCAGTCA"}}};
+  const auto hash = small.sketch()(query).front().hash;
+  REQUIRE_FALSE(small.find(hash).empty());
+  auto saved = std::ostringstream{};
+  small.save(saved);
+  auto bytes = saved.str();
+  const auto at = bytes.find(std::string_view{
+      reinterpret_cast<const char *>(&hash), sizeof(hash)});
+  REQUIRE(at != std::string::npos);
+  std::memset(bytes.data() + at + sizeof(hash), 0xff, sizeof(std::uint32_t));
+  {
+    auto os = std::ofstream{path, std::ios::binary};
+    os << bytes;
+  }
+  const auto corrupt = MinimizerIndex::load(path);
+  REQUIRE_THROWS_AS(corrupt.find(hash), std::runtime_error);
+  std::filesystem::remove(path);
+  REQUIRE_THROWS_AS(MinimizerIndex::load(path), std::runtime_error);
+}
@@ -0,0 +1,122 @@
+#include <biovoltron/algo/sort/external_sorter.hpp>
+#include <biovoltron/file_io/core/header.hpp>
+#include <catch.hpp>
+#include <random>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct IntervalRecord : Record {
+  std::string chrom;
+  std::uint32_t start = 0;
+  std::uint32_t id = 0;
+  double score = 0;
+  istring seq;
+  std::vector<std::string> extras;
+};
+
+struct TestHeader : Header {
+  constexpr static auto START_SYMBOLS = std::array{"#"};
+};
+
+struct NamedRecord : HeaderableRecord {
+  TestHeader *header = nullptr;
+  std::string name;
+};
+
+auto make_records(std::size_t n) {
+  auto gen = std::mt19937{42};
+  auto records = std::vector<IntervalRecord>(n);
+  for (auto i = std::size_t{}; i < n; i++) {
+    auto &record = records[i];
+    record.chrom = "chr" + std::to_string(gen() % 5);
+    record.start = gen() % 1000;
+    record.id = i;
+    record.score = i / 3.0;
+    record.seq = istring(i % 7, i % 5);
+    record.extras = std::vector<std::string>(i % 3, std::to_string(i));
+  }
+  return records;
+}
+
+const auto by_position = [](const IntervalRecord &r) {
+  return std::tie(r.chrom, r.start);
+};
+
+} // namespace
+
+TEST_CASE("External sorter test", "[ExternalSorter]") {
+  const auto records = make_records(5000);
+  auto expected = records;
+  std::ranges::stable_sort(expected, std::ranges::less{}, by_position);
+
+  SECTION("Spilled runs") {
+    for (auto max_records : {std::size_t{1}, std::size_t{333},
+                             std::size_t{4999}, std::size_t{10000}}) {
+      auto sorter = ExternalSorter<IntervalRecord, decltype(by_position)>{
+          by_position, max_records};
+      for (const auto &record : records)
+        sorter.push(record);
+      if (max_records == 333)
+        REQUIRE(sorter.runs() == 15);
+      auto sorted = std::vector<IntervalRecord>{};
+      sorter.merge([&](const auto &record) { sorted.push_back(record); });
+      REQUIRE(sorted == expected);
+      REQUIRE(sorter.runs() == 0);
+    }
+  }
+
+  SECTION("Custom ordering") {
+    const auto by_id = [](const IntervalRecord &r) { return r.id; };
+    auto sorter = ExternalSorter<IntervalRecord, decltype(by_id),
+                                 std::ranges::greater>{
+        by_id, 100, std::filesystem::temp_directory_path()};
+    for (const auto &record : records)
+      sorter.push(record);
+    auto ids = std::vector<std::uint32_t>{};
+    sorter.merge([&](const auto &record) { ids.push_back(record.id); });
+    REQUIRE(ids.size() == records.size());
+    REQUIRE(std::ranges::is_sorted(ids, std::ranges::greater{}));
+  }
+
+  SECTION("Headerable records") {
+    auto header = TestHeader{};
+    const auto by_name = [](const NamedRecord &r) { return r.name; };
+    auto sorter = ExternalSorter<NamedRecord, decltype(by_name)>{by_name, 2};
+    for (auto name : {"d", "b", "c", "a", "e"})
+      sorter.push({{}, &header, name});
+    auto names = std::string{};
+    sorter.merge([&](const auto &record) {
+      REQUIRE(record.header == &header);
+      names += record.name;
+    });
+    REQUIRE(names == "abcde");
+  }
+
+  SECTION("Text streams") {
+    std::ostringstream text;
+    write_records(text, records);
+    std::istringstream is(text.str());
+    std::ostringstream os;
+    sort_records<IntervalRecord>(is, os, by_position, 1000);
+
+    auto parsed = std::vector<IntervalRecord>{};
+    std::istringstream text_is(text.str());
+    for (auto record = IntervalRecord{}; text_is >> record;)
+      parsed.push_back(record);
+    std::ranges::stable_sort(parsed, std::ranges::less{}, by_position);
+    std::ostringstream expected_text;
+    write_records(expected_text, parsed);
+    REQUIRE(os.str() == expected_text.str());
+  }
+
+  SECTION("Empty input") {
+    auto sorter = ExternalSorter<IntervalRecord, decltype(by_position)>{
+        by_position};
+    auto calls = 0;
+    sorter.merge([&](const auto &) { calls++; });
+    REQUIRE(calls == 0);
+  }
+}
@@ -0,0 +1,50 @@
+#include <biovoltron/algo/trimmer/adapter_trimmer.hpp>
+#include <catch.hpp>
+#include <random>
+
+using namespace biovoltron;
+
+TEST_CASE("AdapterTrimmer finding test", "[AdapterTrimmer]") {
+  const auto trimmer = AdapterTrimmer{"AGATCGGAAGAGC", 0.1, 3};
+  const auto find = [&trimmer](std::string_view seq) {
+    return trimmer.find(seq);
+  };
+
+  // Full adapter, adapter prefix and no adapter.
+  REQUIRE(find("CCCCCAGATCGGAAGAGCTTTT") == 5);
+  REQUIRE(find("CCCCCCCCAGATC") == 8);
+  REQUIRE(find("CCCCCCCCCCAGA") == 10);
+  REQUIRE(find("CCCCCCCCCCCAG") == 13);
+  REQUIRE(find("CCCCCCCCCCCCC") == 13);
+  REQUIRE(find("") == 0);
+
+  // One mismatch is allowed in 10 overlapping bases.
+  REQUIRE(find("CCCCAGATCGCAAGAGC") == 4);
+  REQUIRE(find("CCCCAGTTCGCAAGAGC") == 17);
+  REQUIRE(find("CCCCAGANCGGAAGAGC") == 4);
+
+  // Encoded reads.
+  const auto seq = Codec::to_istring("ACGTAGATCGGAAG");
+  const auto read = FastqView<true>{"read", seq, "IIIIIIIIIIIIII"};
+  const auto trimmed = trimmer(read);
+  REQUIRE(trimmed.seq == "0123"_s);
+  REQUIRE(trimmed.qual == "IIII");
+}
+
+TEST_CASE("AdapterTrimmer long sequence test", "[AdapterTrimmer]") {
+  auto gen = std::mt19937{7};
+  auto random_seq = [&gen](std::size_t size) {
+    auto seq = std::string{};
+    for (auto i = std::size_t{}; i < size; i++)
+      seq += "ACGT"[gen() % 4];
+    return seq;
+  };
+
+  const auto adapter = random_seq(100);
+  const auto trimmer = AdapterTrimmer{adapter, 0.05, 5};
+  for (auto insert : {0, 1, 63, 64, 65, 130}) {
+    auto seq = random_seq(insert) + adapter + random_seq(20);
+    seq[insert + 70] = seq[insert + 70] == 'A' ? 'C' : 'A';
+    REQUIRE(trimmer.find(std::string_view{seq}) == insert);
+  }
+}
@@ -0,0 +1,30 @@
+#include <biovoltron/algo/trimmer/all.hpp>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+TEST_CASE("Trimmer concept test", "[Trimmer]") {
+  REQUIRE(Trimmer<QualityTrimmer>);
+  REQUIRE(Trimmer<AdapterTrimmer>);
+  REQUIRE_FALSE(Trimmer<int>);
+}
+
+TEST_CASE("Trimming a batch test", "[Trimmer]") {
+  std::istringstream is("@r1\nACGTAGATCGGA\n+\nIIIIIIIIIIII\n"
+                        "@r2\nACGTACGTACGT\n+\nIIIIIIII####\n"
+                        "@r3\nAGATCGGAAGAG\n+\nIIIIIIIIIIII\n");
+  auto batch = FastqBatch<>{};
+  is >> batch;
+
+  const auto adapter = AdapterTrimmer{"AGATCGGAAGAGC"};
+  const auto quality = QualityTrimmer{.window = 2, .min_quality = 20};
+  const auto reads = trim(batch, adapter, quality);
+  REQUIRE(reads.size() == 3);
+  REQUIRE(reads[0].seq == "ACGT");
+  REQUIRE(reads[0].qual == "IIII");
+  REQUIRE(reads[1].seq == "ACGTACGT");
+  REQUIRE(reads[2].seq.empty());
+  REQUIRE(reads[0].name.data() == batch[0].name.data());
+  REQUIRE(reads[1].seq.data() == batch[1].seq.data());
+}
@@ -0,0 +1,26 @@
+#include <biovoltron/algo/trimmer/quality_trimmer.hpp>
+#include <catch.hpp>
+
+using namespace biovoltron;
+
+TEST_CASE("QualityTrimmer trimming test", "[QualityTrimmer]") {
+  const auto trimmer = QualityTrimmer{.window = 4, .min_quality = 20};
+
+  REQUIRE(trimmer.keep_size("") == 0);
+  REQUIRE(trimmer.keep_size("IIIIIIII") == 8);
+  REQUIRE(trimmer.keep_size("IIIIII##") == 6);
+  REQUIRE(trimmer.keep_size("IIII####") == 3);
+  REQUIRE(trimmer.keep_size("########") == 0);
+  REQUIRE(trimmer.keep_size("II") == 2);
+  REQUIRE(trimmer.keep_size("I#") == 1);
+  REQUIRE(trimmer.keep_size("#I") == 2);
+  REQUIRE(trimmer.keep_size("IIIIIIII#I#I#I") == 14);
+  REQUIRE(trimmer.keep_size("IIIIIIII###I") == 7);
+
+  const auto seq = "0123012"_s;
+  const auto read = FastqView<true>{"read", seq, "IIIII##"};
+  const auto trimmed = trimmer(read);
+  REQUIRE(trimmed.name == "read");
+  REQUIRE(trimmed.seq == "01230"_s);
+  REQUIRE(trimmed.qual == "IIIII");
+}
@@ -0,0 +1,99 @@
+#include <biovoltron/container/record_columns.hpp>
+#include <biovoltron/file_io/core/header.hpp>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct PeakRecord : Record {
+  std::string chrom;
+  std::uint32_t start = 0;
+  std::uint32_t end = 0;
+  double score = 0;
+  istring seq;
+};
+
+struct TestHeader : Header {
+  constexpr static auto START_SYMBOLS = std::array{"#"};
+};
+
+struct AnnotatedRecord : HeaderableRecord {
+  TestHeader *header = nullptr;
+  std::string name;
+  int value = 0;
+};
+
+} // namespace
+
+TEST_CASE("RecordColumns test", "[RecordColumns]") {
+  std::istringstream is("chr2\t300\t350\t0.5\tACGT\n"
+                        "chr1\t100\t150\t2.5\tAC\n"
+                        "chr1\t50\t80\t1\t\n"
+                        "chrX\t100\t120\t3\tTTTT\n");
+  auto records = std::vector<PeakRecord>{};
+  for (auto record = PeakRecord{}; is >> record;)
+    records.push_back(record);
+
+  auto peaks = RecordColumns<PeakRecord>{};
+  STATIC_REQUIRE(RecordColumns<PeakRecord>::COLUMNS == 5);
+  REQUIRE(peaks.empty());
+  peaks.reserve(records.size());
+  for (const auto &record : records)
+    peaks.push_back(record);
+
+  SECTION("Columns") {
+    REQUIRE(peaks.size() == 4);
+    REQUIRE(peaks.column<1>() == std::vector<std::uint32_t>{300, 100, 50, 100});
+    REQUIRE(peaks.column<0>().arena == "chr2chr1chr1chrX");
+    REQUIRE(peaks.get<0>(3) == "chrX");
+    REQUIRE(peaks.get<4>(0) == "0123"_s);
+    REQUIRE(peaks.get<4>(2).empty());
+    REQUIRE(std::ranges::max(peaks.column<3>()) == 3);
+    for (auto i = std::size_t{}; i < records.size(); i++)
+      REQUIRE(peaks[i] == records[i]);
+  }
+
+  SECTION("Filter") {
+    const auto chr1 =
+        peaks.filter<0>([](auto chrom) { return chrom == "chr1"; });
+    REQUIRE(chr1.size() == 2);
+    REQUIRE(chr1[0] == records[1]);
+    REQUIRE(chr1[1] == records[2]);
+    REQUIRE(peaks.find_if<3>([](auto score) { return score > 1; }) ==
+            std::vector<std::size_t>{1, 3});
+    REQUIRE(peaks.filter<1>([](auto) { return false; }).empty());
+  }
+
+  SECTION("Sort") {
+    const auto sorted = peaks.sort_by<1>();
+    REQUIRE(sorted.column<1>() ==
+            std::vector<std::uint32_t>{50, 100, 100, 300});
+    REQUIRE(sorted.get<0>(1) == "chr1");
+    REQUIRE(sorted.get<0>(2) == "chrX");
+    REQUIRE(sorted[3] == records[0]);
+    REQUIRE(peaks.order_by<3>(std::ranges::greater{}) ==
+            std::vector<std::size_t>{3, 1, 2, 0});
+  }
+
+  SECTION("Clear") {
+    peaks.clear();
+    REQUIRE(peaks.empty());
+    peaks.push_back(records[2]);
+    REQUIRE(peaks.size() == 1);
+    REQUIRE(peaks[0] == records[2]);
+  }
+
+  SECTION("Headerable records") {
+    auto header = TestHeader{};
+    auto columns = RecordColumns<AnnotatedRecord>{};
+    STATIC_REQUIRE(RecordColumns<AnnotatedRecord>::COLUMNS == 2);
+    columns.push_back({{}, &header, "a", 2});
+    columns.push_back({{}, &header, "b", 1});
+    const auto sorted = columns.sort_by<1>();
+    REQUIRE(sorted[0].header == &header);
+    REQUIRE(sorted[0].name == "b");
+    REQUIRE(sorted[1].value == 2);
+  }
+}
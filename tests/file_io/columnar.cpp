@@ -0,0 +1,164 @@
+#include <biovoltron/file_io/columnar.hpp>
+#include <catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct VariantRecord : Record {
+  std::string chrom;
+  std::uint32_t pos = 0;
+  std::int64_t delta = 0;
+  double qual = 0;
+  char filter = '.';
+  istring alt;
+  std::string id;
+  std::vector<std::string> info;
+};
+
+auto make_records(std::size_t n) {
+  auto records = std::vector<VariantRecord>(n);
+  for (auto i = std::size_t{}; i < n; i++) {
+    auto &record = records[i];
+    record.chrom = "chr" + std::to_string(1 + i / 100);
+    record.pos = i * 10 + 1;
+    record.delta = static_cast<std::int64_t>(i % 7) - 3;
+    record.qual = i / 8.0;
+    record.filter = i % 3 == 0 ? 'P' : '.';
+    record.alt = istring(i % 5, i % 4);
+    record.id = "rs" + std::to_string(i * 31);
+    record.info = std::vector<std::string>(i % 3, "k=" + std::to_string(i));
+  }
+  return records;
+}
+
+} // namespace
+
+TEST_CASE("Columnar file test", "[Columnar]") {
+  const auto records = make_records(1000);
+
+  SECTION("Round trip in memory") {
+    std::ostringstream os;
+    {
+      auto writer = ColumnarWriter<VariantRecord>{os, 256};
+      for (const auto &record : records)
+        writer.write(record);
+    }
+    const auto data = os.str();
+    const auto reader = ColumnarReader<VariantRecord>::from_memory(data);
+    REQUIRE(reader.size() == 1000);
+    REQUIRE(reader.blocks() == 4);
+    REQUIRE(reader.block_size(3) == 1000 - 3 * 256);
+
+    const auto columns = reader.read_all();
+    REQUIRE(columns.size() == records.size());
+    for (auto i = std::size_t{}; i < records.size(); i++)
+      REQUIRE(columns[i] == records[i]);
+
+    REQUIRE(reader.encoding<0>(0) == ColumnEncoding::DICTIONARY);
+    REQUIRE(reader.encoding<1>(0) == ColumnEncoding::DELTA);
+    REQUIRE(reader.encoding<2>(0) == ColumnEncoding::VARINT);
+    REQUIRE(reader.encoding<3>(0) == ColumnEncoding::PLAIN);
+    REQUIRE(reader.encoding<6>(0) == ColumnEncoding::PLAIN);
+
+    REQUIRE(reader.stats<1>(1) == std::pair{2561u, 5111u});
+    REQUIRE(reader.stats<2>(0) == std::pair{std::int64_t{-3}, std::int64_t{3}});
+    REQUIRE(reader.blocks_overlapping<1>(5000, 6000) ==
+            std::vector<std::size_t>{1, 2});
+    REQUIRE(reader.blocks_overlapping<1>(20000, 30000).empty());
+
+    const auto block = reader.read_block(2);
+    REQUIRE(block.size() == 256);
+    REQUIRE(block[0] == records[512]);
+    REQUIRE(reader.read_column<6>(1)[0] == records[256].id);
+  }
+
+  SECTION("Compression") {
+    std::ostringstream deflated, plain;
+    {
+      auto writer = ColumnarWriter<VariantRecord>{deflated};
+      auto raw_writer =
+          ColumnarWriter<VariantRecord>{plain, 65536, Z_NO_COMPRESSION};
+      for (const auto &record : records) {
+        writer.write(record);
+        raw_writer.write(record);
+      }
+    }
+    REQUIRE(deflated.str().size() < plain.str().size());
+    const auto data = plain.str();
+    const auto columns =
+        ColumnarReader<VariantRecord>::from_memory(data).read_all();
+    REQUIRE(columns[999] == records[999]);
+  }
+
+  SECTION("Memory mapped file") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "biovoltron_columnar.bvc";
+    {
+      auto os = std::ofstream{path, std::ios::binary};
+      auto writer = ColumnarWriter<VariantRecord>{os, 300};
+      for (const auto &record : records)
+        writer.write(record);
+      writer.close();
+      writer.write(records[0]);
+    }
+    {
+      const auto reader = ColumnarReader<VariantRecord>{path};
+      REQUIRE(reader.size() == 1000);
+      REQUIRE(reader.read_block(3)[99] == records[999]);
+    }
+    std::filesystem::remove(path);
+  }
+
+  SECTION("Invalid files") {
+    REQUIRE_THROWS_AS(ColumnarReader<VariantRecord>::from_memory("BVCOL"),
+                      std::runtime_error);
+    std::ostringstream os;
+    ColumnarWriter<VariantRecord>{os}.write(records[0]);
+    const auto data = os.str();
+    struct OtherRecord : Record {
+      std::string chrom;
+      double pos = 0;
+    };
+    REQUIRE_THROWS_AS(ColumnarReader<OtherRecord>::from_memory(data),
+                      std::runtime_error);
+  }
+
+  SECTION("Sizes beyond the file") {
+    struct PosRecord : Record {
+      std::uint32_t pos = 0;
+    };
+    std::ostringstream os;
+    ColumnarWriter<PosRecord>{os}.write({{}, 1});
+    const auto data = os.str();
+    REQUIRE(ColumnarReader<PosRecord>::from_memory(data).size() == 1);
+
+    // The footer ends with the rows of the block and its one chunk:
+    // encoding, deflated, offset, size and raw size, then min and max.
+    auto in = std::string_view{data}.substr(data.size() - 16, 8);
+    const auto footer_size = detail::get_raw<std::uint64_t>(in);
+    const auto footer_end = data.size() - 16;
+    const auto rows_at = footer_end - 2 * sizeof(std::uint32_t) - 6;
+    REQUIRE(data[rows_at] == 1);
+    const auto with = [&](std::size_t at, std::uint64_t value) {
+      auto footer = data.substr(footer_end - footer_size, footer_size);
+      auto varint = std::string{};
+      detail::put_varint(varint, value);
+      footer.replace(at - (footer_end - footer_size), 1, varint);
+      auto file = data.substr(0, footer_end - footer_size) + footer;
+      detail::put_raw(file, std::uint64_t{footer.size()});
+      return file + data.substr(footer_end + 8);
+    };
+    REQUIRE(ColumnarReader<PosRecord>::from_memory(with(rows_at, 1)).size() ==
+            1);
+    REQUIRE_THROWS_AS(
+        ColumnarReader<PosRecord>::from_memory(with(rows_at, 1ull << 40)),
+        std::runtime_error);
+    REQUIRE_THROWS_AS(
+        ColumnarReader<PosRecord>::from_memory(with(rows_at + 5, 1ull << 40)),
+        std::runtime_error);
+  }
+}
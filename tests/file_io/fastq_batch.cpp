@@ -0,0 +1,77 @@
+#include <biovoltron/file_io/fastq_batch.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+TEST_CASE("FastqBatch Test", "[FastqBatch]") {
+  const auto fastq = std::string{"@read1 comment\nACGT\n+\n!@?#\n"
+                                 "@read2\nAC\nGTA\n+read2\n!!!\n!!\n"
+                                 "@read3\n\n+\n\n"};
+
+  SECTION("Parsing from Stream") {
+    std::istringstream stream(fastq);
+    FastqBatch<false> batch;
+    REQUIRE(stream >> batch);
+    REQUIRE(batch.size() == 3);
+
+    REQUIRE(batch[0].name == "read1");
+    REQUIRE(batch[0].seq == "ACGT");
+    REQUIRE(batch[0].qual == "!@?#");
+    REQUIRE(batch[1].name == "read2");
+    REQUIRE(batch[1].seq == "ACGTA");
+    REQUIRE(batch[1].qual == "!!!!!");
+    REQUIRE(batch[2].name == "read3");
+    REQUIRE(batch[2].seq.empty());
+    REQUIRE(batch[2].qual.empty());
+
+    REQUIRE_FALSE(stream >> batch);
+    REQUIRE(batch.empty());
+  }
+
+  SECTION("Parsing with Limited Batch Size") {
+    std::istringstream stream(fastq);
+    FastqBatch<true> batch{.batch_size = 2};
+    REQUIRE(stream >> batch);
+    REQUIRE(batch.size() == 2);
+    REQUIRE(batch[1].seq == "01230"_s);
+
+    const auto capacity = batch.seqs.capacity();
+    REQUIRE(stream >> batch);
+    REQUIRE(batch.size() == 1);
+    REQUIRE(batch[0].name == "read3");
+    REQUIRE(batch.seqs.capacity() == capacity);
+    REQUIRE_FALSE(stream >> batch);
+  }
+
+  SECTION("Consistent with FastqRecord") {
+    std::istringstream batch_stream(fastq), record_stream(fastq);
+    FastqBatch<false> batch;
+    batch_stream >> batch;
+    for (const auto read : batch.views()) {
+      FastqRecord<false> record;
+      record_stream >> record;
+      FastqRecord<false> copy = read;
+      REQUIRE(copy.name == record.name);
+      REQUIRE(copy.seq == record.seq);
+      REQUIRE(copy.qual == record.qual);
+    }
+  }
+
+  SECTION("Truncated Read") {
+    std::istringstream stream("@read1\nACGT\n+\n!@");
+    FastqBatch<false> batch;
+    REQUIRE_THROWS_AS(stream >> batch, std::runtime_error);
+  }
+
+  SECTION("Writing to Stream") {
+    FastqBatch<true> batch;
+    batch.push_back({{"read1", "0123"_s}, "!@?#"});
+    batch.push_back({{"read2", "30"_s}, "II"});
+
+    std::ostringstream stream;
+    stream << batch;
+    REQUIRE(stream.str() == "@read1\nACGT\n+\n!@?#\n@read2\nTA\n+\nII");
+  }
+}
@@ -0,0 +1,113 @@
+#include <biovoltron/file_io/core/header.hpp>
+#include <biovoltron/file_io/core/record.hpp>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct MetaHeader : Header {
+  constexpr static auto START_SYMBOLS = std::array{"##", "#CHROM"};
+};
+
+struct SiteRecord : Record {
+  std::string chrom;
+  std::uint32_t pos = 0;
+};
+
+/**
+ * A non-seekable source which hands out its data in small chunks, like a
+ * pipe or a decompressing stream.
+ */
+class ChunkedBuf : public std::streambuf {
+  std::string data_;
+  std::size_t pos_ = 0;
+  std::size_t chunk_;
+  std::string buffer_;
+
+public:
+  ChunkedBuf(std::string data, std::size_t chunk)
+      : data_(std::move(data)), chunk_(chunk) {}
+
+protected:
+  int_type underflow() override {
+    if (pos_ == data_.size())
+      return traits_type::eof();
+    buffer_ = data_.substr(pos_, chunk_);
+    pos_ += buffer_.size();
+    setg(buffer_.data(), buffer_.data(), buffer_.data() + buffer_.size());
+    return traits_type::to_int_type(buffer_.front());
+  }
+};
+
+constexpr auto VCF_LIKE = "##fileformat=VCFv4.2\n"
+                          "##source=test\n"
+                          "#CHROM\tPOS\n"
+                          "#1\t5\n"
+                          "chr2\t10\n";
+
+} // namespace
+
+TEST_CASE("Header parsing test", "[Header]") {
+  SECTION("Seekable stream") {
+    std::istringstream is(VCF_LIKE);
+    auto header = MetaHeader{};
+    REQUIRE(is >> header);
+    REQUIRE(header.lines == std::vector<std::string>{"##fileformat=VCFv4.2",
+                                                     "##source=test",
+                                                     "#CHROM\tPOS"});
+    auto record = SiteRecord{};
+    REQUIRE(is >> record);
+    REQUIRE(record.chrom == "#1");
+    REQUIRE(is >> record);
+    REQUIRE(record.chrom == "chr2");
+  }
+
+  SECTION("Non-seekable stream") {
+    for (auto chunk : {1, 2, 3, 7, 64}) {
+      auto buf = ChunkedBuf{VCF_LIKE, static_cast<std::size_t>(chunk)};
+      std::istream is(&buf);
+      REQUIRE(is.tellg() == std::istream::pos_type(-1));
+      auto header = MetaHeader{};
+      is >> header;
+      REQUIRE(header.lines == std::vector<std::string>{"##fileformat=VCFv4.2",
+                                                       "##source=test",
+                                                       "#CHROM\tPOS"});
+      // With one character buffered, "#1" can only be told apart from a
+      // header line by reading it, and the stream cannot give it back.
+      if (chunk == 1) {
+        REQUIRE(is.fail());
+        continue;
+      }
+      REQUIRE(is);
+      auto record = SiteRecord{};
+      REQUIRE(is >> record);
+      REQUIRE(record.chrom == "#1");
+      REQUIRE(record.pos == 5);
+    }
+  }
+
+  SECTION("Header only and empty streams") {
+    std::istringstream is("##a\n##b");
+    auto header = MetaHeader{};
+    is >> header;
+    REQUIRE(header.lines == std::vector<std::string>{"##a", "##b"});
+
+    std::istringstream empty;
+    REQUIRE(empty >> header);
+    REQUIRE(header.lines.empty());
+  }
+
+  SECTION("Round trip") {
+    std::istringstream is(VCF_LIKE);
+    auto header = MetaHeader{};
+    is >> header;
+    std::ostringstream os;
+    os << header;
+    std::istringstream again(os.str());
+    auto parsed = MetaHeader{};
+    again >> parsed;
+    REQUIRE(parsed == header);
+  }
+}
@@ -0,0 +1,76 @@
+#include <biovoltron/file_io/core/lazy_record.hpp>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct AnnotationRecord : Record {
+  std::string chrom;
+  std::uint32_t start = 0;
+  std::uint32_t end = 0;
+  double score = 0;
+  istring seq;
+  std::vector<std::string> extras;
+};
+
+} // namespace
+
+TEST_CASE("LazyRecord test", "[LazyRecord]") {
+  std::istringstream is("chr1\t100\t+200\t0.5\tACGT\tx\ty\r\n"
+                        "chr2\t7\n"
+                        "\n");
+  auto lazy = LazyRecord<AnnotationRecord>{};
+  STATIC_REQUIRE(LazyRecord<AnnotationRecord>::FIELDS == 6);
+
+  SECTION("Fields on access") {
+    REQUIRE(is >> lazy);
+    REQUIRE(lazy.line() == "chr1\t100\t+200\t0.5\tACGT\tx\ty");
+    REQUIRE(lazy.size() == 7);
+    REQUIRE(lazy.text<0>() == "chr1");
+    REQUIRE(lazy.text(6) == "y");
+    REQUIRE(lazy.text(7).empty());
+    REQUIRE(lazy.get<1>() == 100);
+    REQUIRE(lazy.get<2>() == 200);
+    REQUIRE(lazy.get<3>() == 0.5);
+    REQUIRE(lazy.get<4>() == "0123"_s);
+    REQUIRE(lazy.text<5>() == "x\ty");
+    REQUIRE(lazy.get<5>() == std::vector<std::string>{"x", "y"});
+
+    REQUIRE(is >> lazy);
+    REQUIRE(lazy.size() == 2);
+    REQUIRE(lazy.get<1>() == 7);
+    REQUIRE(lazy.get<2>() == 0);
+    REQUIRE(lazy.get<4>().empty());
+    REQUIRE(lazy.get<5>().empty());
+
+    REQUIRE(is >> lazy);
+    REQUIRE(lazy.size() == 1);
+    REQUIRE(lazy.text<0>().empty());
+    REQUIRE_FALSE(is >> lazy);
+  }
+
+  SECTION("Same result as eager parsing") {
+    const auto text = is.str();
+    std::istringstream eager_is(text);
+    for (auto record = AnnotationRecord{}; eager_is >> record;) {
+      REQUIRE(is >> lazy);
+      REQUIRE(lazy.to_record() == record);
+    }
+  }
+
+  SECTION("Conversion into existing fields") {
+    auto lazy_line = LazyRecord<AnnotationRecord>{"chrX\t5\t6\t1\tN\ta"};
+    auto extras = std::vector<std::string>{"p", "q", "r"};
+    lazy_line.get<5>(extras);
+    REQUIRE(extras == std::vector<std::string>{"a"});
+    // A written record ends with a tab.
+    LazyRecord<AnnotationRecord>{"chrX\t5\t6\t1\tN\ta\t\t"}.get<5>(extras);
+    REQUIRE(extras == std::vector<std::string>{"a", ""});
+    auto record = AnnotationRecord{};
+    lazy_line.to_record(record);
+    REQUIRE(record.chrom == "chrX");
+    REQUIRE(record.seq == "4"_s);
+  }
+}
@@ -0,0 +1,72 @@
+#include <biovoltron/file_io/paired_fastq.hpp>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+auto make_fastq(int first, int last, char mate) {
+  auto fastq = std::string{};
+  for (auto i = first; i < last; i++)
+    fastq += "@read" + std::to_string(i) + "/" + mate + "\nACGT\n+\nIIII\n";
+  return fastq;
+}
+
+} // namespace
+
+TEST_CASE("PairedFastqReader Test", "[PairedFastqReader]") {
+  SECTION("mate_name") {
+    REQUIRE(PairedFastqReader<>::mate_name("read/1") == "read");
+    REQUIRE(PairedFastqReader<>::mate_name("read/2") == "read");
+    REQUIRE(PairedFastqReader<>::mate_name("read/3") == "read/3");
+    REQUIRE(PairedFastqReader<>::mate_name("read") == "read");
+  }
+
+  SECTION("Two Streams") {
+    std::istringstream r1(make_fastq(0, 10, '1'));
+    std::istringstream r2(make_fastq(0, 10, '2'));
+    auto reader = PairedFastqReader<>{r1, r2, 4};
+    auto sizes = std::vector<std::size_t>{};
+    auto count = 0;
+    for (auto batch = PairedFastqBatch<>{}; reader.read(batch);) {
+      sizes.push_back(batch.size());
+      for (auto i = std::size_t{}; i < batch.size(); i++, count++) {
+        const auto [read1, read2] = batch[i];
+        REQUIRE(read1.name == "read" + std::to_string(count) + "/1");
+        REQUIRE(read2.name == "read" + std::to_string(count) + "/2");
+      }
+    }
+    REQUIRE(sizes == std::vector<std::size_t>{4, 4, 2});
+  }
+
+  SECTION("Interleaved Stream") {
+    auto fastq = std::string{};
+    for (auto i = 0; i < 5; i++)
+      fastq += make_fastq(i, i + 1, '1') + make_fastq(i, i + 1, '2');
+    std::istringstream is(fastq);
+    auto reader = PairedFastqReader<true>{is, 2};
+    auto count = 0;
+    for (auto batch = PairedFastqBatch<true>{}; reader.read(batch);)
+      count += batch.size();
+    REQUIRE(count == 5);
+  }
+
+  SECTION("Truncated Stream") {
+    std::istringstream r1(make_fastq(0, 10, '1'));
+    std::istringstream r2(make_fastq(0, 9, '2'));
+    auto reader = PairedFastqReader<>{r1, r2, 4};
+    auto batch = PairedFastqBatch<>{};
+    REQUIRE(reader.read(batch));
+    REQUIRE(reader.read(batch));
+    REQUIRE_THROWS_AS(reader.read(batch), std::runtime_error);
+  }
+
+  SECTION("Mis-paired Stream") {
+    std::istringstream r1(make_fastq(0, 4, '1'));
+    std::istringstream r2(make_fastq(1, 5, '2'));
+    auto reader = PairedFastqReader<>{r1, r2};
+    auto batch = PairedFastqBatch<>{};
+    REQUIRE_THROWS_AS(reader.read(batch), std::runtime_error);
+  }
+}
@@ -0,0 +1,83 @@
+#include <biovoltron/file_io/core/parallel_reader.hpp>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct IntervalRecord : Record {
+  std::string chrom;
+  std::uint32_t start = 0;
+  std::uint32_t end = 0;
+  double score = 0;
+};
+
+struct CommentHeader : Header {
+  constexpr static auto START_SYMBOLS = std::array{"#"};
+};
+
+struct CallRecord : HeaderableRecord {
+  CommentHeader *header = nullptr;
+  std::string chrom;
+  std::uint32_t pos = 0;
+  istring alt;
+};
+
+} // namespace
+
+TEST_CASE("Parallel record reader test", "[ParallelReader]") {
+  auto text = std::string{};
+  for (auto i = 0; i < 1000; i++)
+    text += "chr" + std::to_string(i % 23) + "\t" + std::to_string(i) + "\t" +
+            std::to_string(i * 2) + "\t" + std::to_string(i / 4.0) + "\n";
+
+  auto expected = std::vector<IntervalRecord>{};
+  {
+    std::istringstream is(text);
+    for (auto record = IntervalRecord{}; is >> record;)
+      expected.push_back(record);
+  }
+  REQUIRE(expected.size() == 1000);
+
+  SECTION("Records in file order") {
+    for (auto [threads, chunk_size] : {std::pair{1, 1 << 20}, std::pair{4, 7},
+                                       std::pair{3, 100}, std::pair{8, 4096}}) {
+      std::istringstream is(text);
+      const auto records =
+          read_records<IntervalRecord>(is, threads, chunk_size);
+      REQUIRE(records == expected);
+    }
+  }
+
+  SECTION("Last line without newline") {
+    text.pop_back();
+    std::istringstream is(text);
+    const auto records = read_records<IntervalRecord>(is, 2, 64);
+    REQUIRE(records == expected);
+  }
+
+  SECTION("Empty stream") {
+    std::istringstream is;
+    REQUIRE(read_records<IntervalRecord>(is).empty());
+  }
+
+  SECTION("Headerable records") {
+    std::istringstream is("#fileformat=test\n"
+                          "#sample\n"
+                          "chr1\t100\tACGT\n"
+                          "chr2\t200\tN\n");
+    auto header = CommentHeader{};
+    const auto records = read_records<CallRecord>(is, header, 2, 5);
+    REQUIRE(header.lines ==
+            std::vector<std::string>{"#fileformat=test", "#sample"});
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].header == &header);
+    REQUIRE(records[0].chrom == "chr1");
+    REQUIRE(records[0].pos == 100);
+    REQUIRE(records[0].alt == "0123"_s);
+    REQUIRE(records[1].header == &header);
+    REQUIRE(records[1].chrom == "chr2");
+    REQUIRE(records[1].alt == "4"_s);
+  }
+}
@@ -0,0 +1,91 @@
+#include <biovoltron/file_io/core/header.hpp>
+#include <biovoltron/file_io/core/record.hpp>
+#include <biovoltron/file_io/fastq_batch.hpp>
+#include <biovoltron/file_io/prefetch.hpp>
+#include <catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct CommentHeader : Header {
+  constexpr static auto START_SYMBOLS = std::array{"#"};
+};
+
+struct SiteRecord : Record {
+  std::string chrom;
+  std::uint32_t pos = 0;
+};
+
+auto make_fastq(std::size_t n) {
+  auto text = std::string{};
+  for (auto i = std::size_t{}; i < n; i++) {
+    const auto seq = std::string(50 + i % 50, "ACGT"[i % 4]);
+    text += "@read" + std::to_string(i) + "\n" + seq + "\n+\n" +
+            std::string(seq.size(), 'I') + "\n";
+  }
+  return text;
+}
+
+} // namespace
+
+TEST_CASE("Prefetching input test", "[Prefetch]") {
+  const auto text = make_fastq(2000);
+
+  SECTION("Wrapped stream") {
+    for (auto [depth, block_size] :
+         {std::pair{1, 1}, std::pair{2, 7}, std::pair{4, 4096}}) {
+      std::istringstream source(text);
+      auto is = PrefetchIstream{source, std::size_t(depth),
+                                std::size_t(block_size)};
+      REQUIRE(std::string{std::istreambuf_iterator<char>{is}, {}} == text);
+    }
+  }
+
+  SECTION("File") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "biovoltron_prefetch.fq";
+    std::ofstream{path} << text;
+
+    auto is = PrefetchIstream{path, 3, 1000};
+    REQUIRE(is);
+    auto batch = FastqBatch<>{};
+    batch.batch_size = 300;
+    auto reads = std::size_t{};
+    auto last = std::string{};
+    while (is >> batch) {
+      reads += batch.size();
+      last = batch[batch.size() - 1].name;
+    }
+    REQUIRE(reads == 2000);
+    REQUIRE(last == "read1999");
+
+    std::filesystem::remove(path);
+    REQUIRE_FALSE(PrefetchIstream{path});
+  }
+
+  SECTION("Header and records") {
+    std::istringstream source("#a\n#b\nchr1\t10\nchr2\t20\n");
+    auto is = PrefetchIstream{source, 2, 3};
+    auto header = CommentHeader{};
+    REQUIRE(is >> header);
+    REQUIRE(header.lines == std::vector<std::string>{"#a", "#b"});
+    auto record = SiteRecord{};
+    REQUIRE(is >> record);
+    REQUIRE(record.chrom == "chr1");
+    REQUIRE(is >> record);
+    REQUIRE(record.pos == 20);
+    REQUIRE_FALSE(is >> record);
+  }
+
+  SECTION("Destroyed before the end") {
+    std::istringstream source(text);
+    auto is = PrefetchIstream{source, 2, 16};
+    auto line = std::string{};
+    REQUIRE(std::getline(is, line));
+    REQUIRE(line == "@read0");
+  }
+}
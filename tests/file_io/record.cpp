@@ -0,0 +1,157 @@
+#include <biovoltron/file_io/core/record.hpp>
+#include <catch.hpp>
+#include <iomanip>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct BedLikeRecord : Record {
+  std::string chrom;
+  std::uint32_t start = 0;
+  std::uint32_t end = 0;
+  double score = 0;
+  char strand = '.';
+  istring seq;
+  std::vector<std::string> extras;
+};
+
+struct ValuesRecord : Record {
+  std::string name;
+  int count = 0;
+  std::vector<int> values;
+};
+
+} // namespace
+
+TEST_CASE("Record parsing test", "[Record]") {
+  SECTION("Parsing from Stream") {
+    std::istringstream is("chr1\t100\t+200\t0.5\t-\tACGT\tx\ty\n"
+                          "chr2 A\t7\n"
+                          "chrM\t1\t2\t1e-3\t+\tN\r\n");
+    auto record = BedLikeRecord{};
+
+    REQUIRE(is >> record);
+    REQUIRE(record.chrom == "chr1");
+    REQUIRE(record.start == 100);
+    REQUIRE(record.end == 200);
+    REQUIRE(record.score == 0.5);
+    REQUIRE(record.strand == '-');
+    REQUIRE(record.seq == "0123"_s);
+    REQUIRE(record.extras == std::vector<std::string>{"x", "y"});
+
+    REQUIRE(is >> record);
+    REQUIRE(record.chrom == "chr2 A");
+    REQUIRE(record.start == 7);
+    REQUIRE(record.end == 0);
+    REQUIRE(record.score == 0);
+    REQUIRE(record.strand == char{});
+    REQUIRE(record.seq.empty());
+    REQUIRE(record.extras.empty());
+
+    REQUIRE(is >> record);
+    REQUIRE(record.chrom == "chrM");
+    REQUIRE(record.score == 1e-3);
+    REQUIRE(record.seq == "4"_s);
+
+    REQUIRE_FALSE(is >> record);
+  }
+
+  SECTION("Writing to Stream") {
+    auto record = BedLikeRecord{};
+    record.chrom = "chr1";
+    record.start = 100;
+    record.end = 200;
+    record.score = 1234567.125;
+    record.strand = '+';
+    record.seq = "0123"_s;
+    record.extras = {"x", "y"};
+
+    std::ostringstream expected;
+    expected << record.chrom << "\t" << record.start << "\t" << record.end
+             << "\t" << record.score << "\t" << record.strand << "\t"
+             << record.seq << "\t" << record.extras << "\t";
+
+    std::ostringstream os;
+    os << record;
+    REQUIRE(os.str() == expected.str());
+    REQUIRE(os.str() == "chr1\t100\t200\t1.23457e+06\t+\tACGT\tx\ty\t");
+
+    os.str({});
+    os.precision(10);
+    os << record;
+    REQUIRE(os.str() == "chr1\t100\t200\t1234567.125\t+\tACGT\tx\ty\t");
+
+    // Other formatting settings go through the operator<< of every field.
+    record.score = 1.5;
+    os.str({});
+    os << std::fixed << std::setprecision(2) << record;
+    REQUIRE(os.str() == "chr1\t100\t200\t1.50\t+\tACGT\tx\ty\t");
+    os.str({});
+    os << std::defaultfloat << std::hex << std::showpos << record;
+    REQUIRE(os.str() == "chr1\t64\tc8\t+1.5\t+\tACGT\tx\ty\t");
+    os.str({});
+    write_records(os, std::vector{record, record});
+    REQUIRE(os.str() == "chr1\t64\tc8\t+1.5\t+\tACGT\tx\ty\t\n"
+                        "chr1\t64\tc8\t+1.5\t+\tACGT\tx\ty\t\n");
+  }
+
+  SECTION("Writing Records in Batch") {
+    auto records = std::vector<BedLikeRecord>(3);
+    records[0].chrom = "chr1";
+    records[1].start = 5;
+    records[2].score = 0.25;
+
+    std::ostringstream os;
+    write_records(os, records, 8);
+    REQUIRE(os.str() == "chr1\t0\t0\t0\t.\t\t\t\n"
+                        "\t5\t0\t0\t.\t\t\t\n"
+                        "\t0\t0\t0.25\t.\t\t\t\n");
+
+    std::istringstream is(os.str());
+    for (const auto &record : records) {
+      auto parsed = BedLikeRecord{};
+      is >> parsed;
+      REQUIRE(parsed.chrom == record.chrom);
+      REQUIRE(parsed.start == record.start);
+      REQUIRE(parsed.score == record.score);
+    }
+  }
+
+  SECTION("Round Trip of Vector Fields") {
+    auto records = std::vector<BedLikeRecord>(4);
+    records[0].chrom = "chr1";
+    records[0].extras = {"x", "y", "z"};
+    records[1].extras = {"x", ""};
+    records[2].extras = {"", "", "x"};
+
+    std::ostringstream os;
+    write_records(os, records);
+    std::istringstream is(os.str());
+    for (const auto &record : records) {
+      auto parsed = BedLikeRecord{};
+      REQUIRE(is >> parsed);
+      REQUIRE(parsed == record);
+    }
+
+    const auto record = ValuesRecord{{}, "a", 1, {1, 2, 3}};
+    os.str({});
+    os << record << "\n" << ValuesRecord{} << "\n";
+    REQUIRE(os.str() == "a\t1\t1\t2\t3\t\n\t0\t\t\n");
+    is.str(os.str());
+    is.clear();
+    auto parsed = ValuesRecord{};
+    REQUIRE(is >> parsed);
+    REQUIRE(parsed == record);
+    REQUIRE(is >> parsed);
+    REQUIRE(parsed == ValuesRecord{});
+  }
+
+  SECTION("Comparing Records") {
+    std::istringstream is("chr1\t1\t2\t0\t+\tA\nchr1\t1\t2\t0\t+\tA\n");
+    auto lhs = BedLikeRecord{}, rhs = BedLikeRecord{};
+    is >> lhs >> rhs;
+    REQUIRE(lhs == rhs);
+  }
+}
@@ -0,0 +1,128 @@
+#include <array>
+#include <biovoltron/file_io/core/record.hpp>
+#include <catch.hpp>
+#include <sstream>
+
+using namespace biovoltron;
+
+namespace {
+
+struct EmptyRecord : Record {};
+
+struct MixedRecord : Record {
+  std::string name;
+  std::array<int, 4> values{};
+  double score = 0;
+  std::vector<std::string> extras;
+};
+
+struct HeaderRecord : HeaderableRecord {
+  const void *header = nullptr;
+  std::string name;
+  int value = 0;
+};
+
+struct WideRecord : Record {
+  int f0 = 0;
+  int f1 = 1;
+  int f2 = 2;
+  int f3 = 3;
+  int f4 = 4;
+  int f5 = 5;
+  int f6 = 6;
+  int f7 = 7;
+  int f8 = 8;
+  int f9 = 9;
+  int f10 = 10;
+  int f11 = 11;
+  int f12 = 12;
+  int f13 = 13;
+  int f14 = 14;
+  int f15 = 15;
+  int f16 = 16;
+  int f17 = 17;
+  int f18 = 18;
+  int f19 = 19;
+  int f20 = 20;
+  int f21 = 21;
+  int f22 = 22;
+  int f23 = 23;
+  int f24 = 24;
+  int f25 = 25;
+  int f26 = 26;
+  int f27 = 27;
+  int f28 = 28;
+  int f29 = 29;
+  int f30 = 30;
+  int f31 = 31;
+  int f32 = 32;
+  int f33 = 33;
+  int f34 = 34;
+  int f35 = 35;
+  int f36 = 36;
+  int f37 = 37;
+  int f38 = 38;
+  int f39 = 39;
+  int f40 = 40;
+  int f41 = 41;
+  int f42 = 42;
+  int f43 = 43;
+  int f44 = 44;
+  int f45 = 45;
+  int f46 = 46;
+  int f47 = 47;
+  int f48 = 48;
+  int f49 = 49;
+  int f50 = 50;
+  int f51 = 51;
+  int f52 = 52;
+  int f53 = 53;
+  int f54 = 54;
+  int f55 = 55;
+  int f56 = 56;
+  int f57 = 57;
+  int f58 = 58;
+  int f59 = 59;
+  int f60 = 60;
+  int f61 = 61;
+  int f62 = 62;
+  int f63 = 63;
+};
+
+} // namespace
+
+TEST_CASE("Record reflection test", "[Tuple]") {
+  SECTION("Fields count") {
+    STATIC_REQUIRE(fields_count<EmptyRecord>() == 0);
+    STATIC_REQUIRE(fields_count<MixedRecord>() == 4);
+    STATIC_REQUIRE(fields_count<HeaderRecord>() == 3);
+    STATIC_REQUIRE(fields_count<WideRecord>() == 64);
+  }
+
+  SECTION("Tuple of fields") {
+    auto record = MixedRecord{};
+    auto fields = to_tuple(record);
+    std::get<0>(fields) = "x";
+    REQUIRE(record.name == "x");
+    REQUIRE(&std::get<3>(fields) == &record.extras);
+
+    auto headed = HeaderRecord{};
+    STATIC_REQUIRE(std::tuple_size_v<decltype(to_tuple(headed))> == 2);
+    REQUIRE(&std::get<0>(to_tuple(headed)) == &headed.name);
+  }
+
+  SECTION("Wide records") {
+    auto record = WideRecord{};
+    auto fields = to_tuple(record);
+    STATIC_REQUIRE(std::tuple_size_v<decltype(fields)> == 64);
+    REQUIRE(std::get<63>(fields) == 63);
+
+    std::ostringstream os;
+    os << record;
+    std::istringstream is(os.str());
+    auto parsed = WideRecord{};
+    parsed.f0 = parsed.f63 = -1;
+    REQUIRE(is >> parsed);
+    REQUIRE(parsed == record);
+  }
+}
@@ -0,0 +1,118 @@
+#include <biovoltron/file_io/fastq.hpp>
+#include <biovoltron/utility/instrumentation.hpp>
+#include <catch.hpp>
+#include <sstream>
+#include <thread>
+
+using namespace biovoltron;
+
+namespace {
+
+auto find_stage(std::string_view name) {
+  for (const auto &stage : Instrumentation::instance().snapshot())
+    if (stage.name == name)
+      return stage;
+  return StageMetrics{};
+}
+
+auto parse_chunk(std::size_t records) {
+  BIOVOLTRON_TIMED_SCOPE(timer, "test/parse_chunk");
+  auto lines = std::vector<std::string>{};
+  for (auto i = std::size_t{}; i < records; i++)
+    lines.push_back(std::string(100, 'A'));
+  BIOVOLTRON_TIMER_ADD(timer, records, records * 100);
+  return lines.size();
+}
+
+} // namespace
+
+TEST_CASE("Instrumentation - Timed scopes and counters", "[utility]") {
+  auto &instrumentation = Instrumentation::instance();
+  instrumentation.reset();
+
+  REQUIRE(parse_chunk(10) == 10);
+  REQUIRE(parse_chunk(5) == 5);
+  for (auto i = 0; i < 3; i++)
+    BIOVOLTRON_COUNT("test/counter", 2, 10);
+
+  auto chunk = find_stage("test/parse_chunk");
+  REQUIRE(chunk.calls == 2);
+  REQUIRE(chunk.records == 15);
+  REQUIRE(chunk.bytes == 1500);
+  REQUIRE(chunk.nanoseconds > 0);
+  REQUIRE(chunk.allocations >= 15);
+  REQUIRE(chunk.records_per_second() > 0);
+
+  const auto counter = find_stage("test/counter");
+  REQUIRE(counter.calls == 0);
+  REQUIRE(counter.records == 6);
+  REQUIRE(counter.bytes == 30);
+  REQUIRE(counter.bytes_per_second() == 0);
+
+  instrumentation.reset();
+  chunk = find_stage("test/parse_chunk");
+  REQUIRE(chunk.calls == 0);
+  REQUIRE(chunk.records == 0);
+}
+
+TEST_CASE("Instrumentation - Concurrent counting", "[utility]") {
+  auto &instrumentation = Instrumentation::instance();
+  instrumentation.reset();
+  auto threads = std::vector<std::thread>{};
+  for (auto t = 0; t < 4; t++)
+    threads.emplace_back([] {
+      for (auto i = 0; i < 1000; i++)
+        BIOVOLTRON_COUNT("test/concurrent", 1, 3);
+    });
+  for (auto &thread : threads)
+    thread.join();
+  const auto stage = find_stage("test/concurrent");
+  REQUIRE(stage.records == 4000);
+  REQUIRE(stage.bytes == 12000);
+}
+
+TEST_CASE("Instrumentation - Phase listener and allocations", "[utility]") {
+  auto &instrumentation = Instrumentation::instance();
+  instrumentation.reset();
+
+  auto phases = std::vector<StageMetrics>{};
+  instrumentation.set_listener(
+      [&phases](std::string_view, const StageMetrics &phase) {
+        phases.push_back(phase);
+      });
+  REQUIRE(instrumentation.listening());
+  parse_chunk(3);
+  parse_chunk(4);
+  instrumentation.set_listener({});
+  REQUIRE_FALSE(instrumentation.listening());
+  parse_chunk(5);
+
+  REQUIRE(phases.size() == 2);
+  REQUIRE(phases[0].name == "test/parse_chunk");
+  REQUIRE(phases[0].calls == 1);
+  REQUIRE(phases[0].records == 3);
+  REQUIRE(phases[1].records == 4);
+  REQUIRE(phases[1].bytes == 400);
+
+  const auto before = Instrumentation::allocations();
+  auto p = std::make_unique<int>(42);
+  REQUIRE(Instrumentation::allocations() == before + 1);
+
+  // The spdlog sinks only have to accept the messages.
+  log_phases();
+  parse_chunk(1);
+  log_metrics();
+  instrumentation.set_listener({});
+}
+
+TEST_CASE("Instrumentation - Hooks of the readers", "[utility]") {
+  Instrumentation::instance().reset();
+  auto is = std::istringstream{"@r1\nACGT\n+\nIIII\n@r2\nAC\n+\nII\n"};
+  auto reads = 0;
+  for (auto record = FastqRecord<>{}; is >> record;)
+    reads++;
+  REQUIRE(reads == 2);
+  const auto stage = find_stage("fastq/read");
+  REQUIRE(stage.records == 2);
+  REQUIRE(stage.bytes == 16);
+}
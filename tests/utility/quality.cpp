@@ -0,0 +1,57 @@
+#include <biovoltron/utility/quality.hpp>
+#include <catch.hpp>
+
+using namespace biovoltron;
+
+TEST_CASE("QualityCodec::illumina - Lossy 8-level binning", "[utility]") {
+  const auto codec = QualityCodec::illumina();
+  REQUIRE(codec.size() == 8);
+  REQUIRE_FALSE(codec.is_lossless());
+
+  auto codes = codec.encode("II?5+#");
+  REQUIRE(codes.size() == 6);
+  REQUIRE(codes == QuadbitVector<>{7, 7, 5, 3, 2, 0});
+  REQUIRE(codec.decode(codes) == "IIB70#");
+
+  // Decoded qualities are stable under re-encoding.
+  const auto all = std::string{"!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJK"};
+  const auto binned = codec.decode(codec.encode(all));
+  REQUIRE(binned.size() == all.size());
+  REQUIRE(codec.decode(codec.encode(binned)) == binned);
+  for (auto i = std::size_t{}; i < all.size(); i++)
+    REQUIRE(codec.to_code(all[i]) == codec.to_code(binned[i]));
+}
+
+TEST_CASE("QualityCodec::lossless - Dictionary coding", "[utility]") {
+  const auto qual = std::string{"FFF:,FF:F,FFFF#:FF,,F"};
+  const auto codec = QualityCodec::lossless(qual);
+  REQUIRE(codec.size() == 4);
+  REQUIRE(codec.is_lossless());
+  REQUIRE(codec.decode(codec.encode(qual)) == qual);
+  REQUIRE_THROWS_AS(codec.encode("FFI"), std::invalid_argument);
+
+  auto many = std::string{};
+  for (auto c = '!'; c < '!' + 17; c++)
+    many += c;
+  REQUIRE_THROWS_AS(QualityCodec::lossless(many), std::length_error);
+}
+
+TEST_CASE("QualityCodec - Appending and partial decoding", "[utility]") {
+  const auto codec = QualityCodec::lossless("ABCDEFGH");
+  const auto quals = std::vector<std::string>{"ABC", "", "DEFGH", "H", "GA"};
+
+  auto codes = QuadbitVector<>{};
+  auto offsets = std::vector<std::size_t>{0};
+  for (const auto &qual : quals) {
+    codec.encode(qual, codes);
+    offsets.push_back(codes.size());
+  }
+  REQUIRE(codes.size() == 11);
+  REQUIRE(codes.num_blocks() == 6);
+
+  for (auto i = std::size_t{}; i < quals.size(); i++) {
+    auto qual = std::string{};
+    codec.decode(codes, offsets[i], offsets[i + 1] - offsets[i], qual);
+    REQUIRE(qual == quals[i]);
+  }
+}
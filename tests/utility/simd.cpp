@@ -0,0 +1,129 @@
+#include <biovoltron/container/xbit_vector.hpp>
+#include <biovoltron/utility/istring.hpp>
+#include <biovoltron/utility/simd.hpp>
+#include <catch.hpp>
+#include <random>
+#include <ranges>
+
+using namespace biovoltron;
+
+namespace {
+
+auto random_text(std::size_t size, std::mt19937 &gen) {
+  constexpr auto alphabet = std::string_view{"ACGTacgtNnXR-"};
+  auto dist = std::uniform_int_distribution<std::size_t>{
+      0, alphabet.size() - 1};
+  auto s = std::string{};
+  for (auto i = std::size_t{}; i < size; i++)
+    s += alphabet[dist(gen)];
+  return s;
+}
+
+/**
+ * @brief Run f once for every level up to the detected one.
+ */
+auto for_each_level(auto f) {
+  const auto detected = set_simd_level(SimdLevel::AVX512);
+  for (auto level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level > detected)
+      break;
+    set_simd_level(level);
+    f(level);
+  }
+  set_simd_level(detected);
+}
+
+} // namespace
+
+TEST_CASE("simd_level - Clamped to the detected level", "[utility]") {
+  const auto detected = set_simd_level(SimdLevel::AVX512);
+  REQUIRE(simd_level() == detected);
+  REQUIRE(set_simd_level(SimdLevel::SCALAR) == SimdLevel::SCALAR);
+  REQUIRE(simd_level() == SimdLevel::SCALAR);
+  set_simd_level(detected);
+}
+
+TEST_CASE("simd - Codec kernels match the scalar definitions", "[utility]") {
+  auto gen = std::mt19937{1};
+  auto sizes = std::vector<std::size_t>{};
+  for (auto size = std::size_t{}; size < 200; size++)
+    sizes.push_back(size);
+  sizes.push_back(4099);
+
+  for (const auto size : sizes) {
+    const auto text = random_text(size, gen);
+    auto ints = istring{};
+    for (const auto c : text)
+      ints += Codec::to_int(c);
+    auto chars = std::string{};
+    for (const auto c : ints)
+      chars += Codec::to_char(c);
+    auto ints_rc = istring{};
+    for (auto it = ints.rbegin(); it != ints.rend(); ++it)
+      ints_rc += *it == 4 ? 4 : 3 - *it;
+    auto text_rc = std::string{};
+    for (auto it = text.rbegin(); it != text.rend(); ++it)
+      text_rc += Codec::comp(*it);
+
+    for_each_level([&](auto) {
+      REQUIRE(Codec::to_istring(text) == ints);
+      REQUIRE(Codec::to_string(ints) == chars);
+      REQUIRE(Codec::rev_comp(istring_view{ints}) == ints_rc);
+      REQUIRE(Codec::rev_comp(std::string_view{text}) == text_rc);
+    });
+  }
+}
+
+TEST_CASE("simd - Codec::hash", "[utility]") {
+  auto gen = std::mt19937{2};
+  const auto seq = Codec::to_istring(random_text(64, gen));
+  for (auto k = std::size_t{}; k <= 32; k++) {
+    const auto kmer = istring_view{seq}.substr(5, k);
+    auto key = 0ull;
+    for (const auto c : kmer)
+      key = key << 2 | (c & 3);
+    REQUIRE(Codec::hash(kmer) == key);
+    if (kmer.find(4) == istring_view::npos)
+      REQUIRE(Codec::rhash(key, k) == kmer);
+  }
+  static_assert(Codec::hash(istring{0, 1, 2, 3, 0, 1, 2, 3, 3}) ==
+                0b00'01'10'11'00'01'10'11'11);
+}
+
+TEST_CASE("simd - XbitVector bulk operations", "[utility]") {
+  auto gen = std::mt19937{3};
+  const auto seq = Codec::to_istring(random_text(1000, gen));
+
+  for_each_level([&](auto) {
+    for (const auto size : {0, 1, 7, 31, 32, 33, 100, 1000}) {
+      const auto view = istring_view{seq}.substr(0, size);
+      auto expected = DibitVector<>{};
+      auto quad = QuadbitVector<std::uint32_t>{};
+      for (const auto c : view) {
+        expected.push_back(c);
+        quad.push_back(c);
+      }
+      REQUIRE(DibitVector<>(view.begin(), view.end()) == expected);
+      REQUIRE(QuadbitVector<std::uint32_t>(view.begin(), view.end()) == quad);
+
+      auto assigned = DibitVector<std::uint64_t>{1, 2, 3};
+      assigned.assign(view.begin(), view.end());
+      REQUIRE(std::ranges::equal(assigned, expected));
+      assigned.insert(assigned.begin(), {1, 2, 3});
+      REQUIRE(std::ranges::equal(assigned | std::views::drop(3), expected));
+
+      auto filled = DibitVector<std::uint16_t>(3, 1);
+      filled.resize(size + 3, 2);
+      filled.insert(filled.begin() + 1, size, 3);
+      REQUIRE(filled.size() == 2 * size + 3);
+      REQUIRE(std::ranges::count(filled, 3) == size);
+      REQUIRE(std::ranges::count(filled, 2) == size);
+      REQUIRE(filled[0] == 1);
+      REQUIRE(filled[size + 2] == 1);
+
+      auto copy = filled;
+      copy.reserve(10000);
+      REQUIRE(copy == filled);
+    }
+  });
+}
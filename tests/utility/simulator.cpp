@@ -0,0 +1,168 @@
+#include <biovoltron/utility/simulator.hpp>
+#include <catch.hpp>
+#include <unordered_map>
+
+using namespace biovoltron;
+
+namespace {
+
+auto parse_origin(const std::string &name) {
+  const auto first = name.find('_');
+  const auto second = name.find('_', first + 1);
+  return std::tuple{name.substr(0, first),
+                    std::stoul(name.substr(first + 1, second - first - 1)),
+                    name[second + 1] == '-'};
+}
+
+} // namespace
+
+TEST_CASE("Simulator - Genome", "[utility]") {
+  const auto profile = GenomeProfile{.chromosomes = 3,
+                                     .length = 1500000,
+                                     .n_runs_per_mb = 4,
+                                     .n_run_length = 100};
+  const auto genome = simulate_genome(profile, 7);
+  REQUIRE(genome.size() == 3);
+  REQUIRE(genome[0].name == "chr1");
+  REQUIRE(genome[2].name == "chr3");
+
+  auto gc = std::size_t{};
+  auto n = std::size_t{};
+  for (const auto &chrom : genome) {
+    REQUIRE(chrom.seq.size() == profile.length);
+    REQUIRE(chrom.seq.find_first_not_of("ACGTN") == std::string::npos);
+    gc += std::ranges::count(chrom.seq, 'C');
+    gc += std::ranges::count(chrom.seq, 'G');
+    n += std::ranges::count(chrom.seq, 'N');
+  }
+  const auto total = 3.0 * profile.length;
+  REQUIRE(gc / (total - n) == Approx(profile.gc_content).margin(0.01));
+  REQUIRE(n > 0);
+  REQUIRE(n < total * 0.01);
+
+  SECTION("Reproducible") {
+    REQUIRE(simulate_genome(profile, 7)[1].seq == genome[1].seq);
+    REQUIRE(simulate_genome(profile, 8)[1].seq != genome[1].seq);
+    const auto encoded = simulate_genome<true>(profile, 7);
+    REQUIRE(encoded[2].seq == Codec::to_istring(genome[2].seq));
+  }
+
+  SECTION("Repeats and N runs are optional") {
+    // Fraction of positions whose 32-mer occurs more than once.
+    const auto repeated = [](const std::string &seq) {
+      auto counts = std::unordered_map<std::string_view, int>{};
+      for (auto i = std::size_t{}; i + 32 <= seq.size(); i++)
+        counts[std::string_view{seq}.substr(i, 32)]++;
+      auto n = std::size_t{};
+      for (auto i = std::size_t{}; i + 32 <= seq.size(); i++)
+        n += counts[std::string_view{seq}.substr(i, 32)] > 1;
+      return n / double(seq.size());
+    };
+
+    const auto plain = simulate_genome(
+        {.length = 100000, .repeat_fraction = 0, .n_runs_per_mb = 0}, 1);
+    REQUIRE(plain[0].seq.find('N') == std::string::npos);
+    REQUIRE(repeated(plain[0].seq) < 0.01);
+    const auto no_repeats = simulate_genome(
+        {.length = 100000, .repeat_length = 0, .n_runs_per_mb = 0}, 1);
+    REQUIRE(no_repeats[0].seq == plain[0].seq);
+
+    const auto repetitive = simulate_genome({.length = 100000,
+                                             .repeat_fraction = 0.5,
+                                             .repeat_families = 2,
+                                             .repeat_length = 200,
+                                             .repeat_divergence = 0,
+                                             .n_runs_per_mb = 0},
+                                            1);
+    REQUIRE(repeated(repetitive[0].seq) > 0.2);
+  }
+}
+
+TEST_CASE("Simulator - Reads", "[utility]") {
+  const auto genome = simulate_genome(
+      {.chromosomes = 2, .length = 200000, .n_runs_per_mb = 0}, 3);
+
+  SECTION("Error-free reads match their origin") {
+    const auto profile = ReadProfile{.read_length = 100,
+                                     .substitution_rate = 0,
+                                     .insertion_rate = 0,
+                                     .deletion_rate = 0};
+    const auto reads = simulate_reads(genome, 0, 500, profile, 11);
+    REQUIRE(reads.size() == 500);
+    auto reverse = std::size_t{};
+    for (const auto &read : reads) {
+      REQUIRE(read.seq.size() == 100);
+      REQUIRE(read.qual.size() == 100);
+      REQUIRE(std::ranges::all_of(read.qual, [](auto q) {
+        return q >= '!' + 2 && q <= '!' + 41;
+      }));
+      const auto [chrom, start, is_reverse] = parse_origin(read.name);
+      const auto &ref = genome[chrom == "chr1" ? 0 : 1].seq;
+      const auto origin = ref.substr(start, 100);
+      reverse += is_reverse;
+      if (is_reverse)
+        REQUIRE(read.seq == Codec::rev_comp(std::string_view{origin}));
+      else
+        REQUIRE(read.seq == origin);
+    }
+    REQUIRE(reverse > 200);
+    REQUIRE(reverse < 300);
+  }
+
+  SECTION("Batches are independent of their split") {
+    const auto all = simulate_reads<true>(genome, 0, 100, {}, 5);
+    const auto tail = simulate_reads<true>(genome, 60, 40, {}, 5);
+    REQUIRE(tail.size() == 40);
+    for (auto i = 0; i < 40; i++) {
+      REQUIRE(tail[i].name == all[60 + i].name);
+      REQUIRE(tail[i].seq == all[60 + i].seq);
+      REQUIRE(tail[i].qual == all[60 + i].qual);
+    }
+    REQUIRE(simulate_reads<true>(genome, 0, 1, {}, 6)[0].seq != all[0].seq);
+  }
+
+  SECTION("Substitution rate and quality profile") {
+    const auto profile = ReadProfile{.read_length = 100,
+                                     .substitution_rate = 0.02,
+                                     .insertion_rate = 0,
+                                     .deletion_rate = 0,
+                                     .error_growth = 1,
+                                     .first_quality = 38,
+                                     .last_quality = 20};
+    const auto reads = simulate_reads(genome, 0, 2000, profile, 13);
+    auto mismatches = std::size_t{};
+    auto first = 0.0;
+    auto last = 0.0;
+    for (const auto &read : reads) {
+      const auto [chrom, start, is_reverse] = parse_origin(read.name);
+      auto origin = genome[chrom == "chr1" ? 0 : 1].seq.substr(start, 100);
+      if (is_reverse)
+        origin = Codec::rev_comp(std::string_view{origin});
+      for (auto i = 0; i < 100; i++)
+        mismatches += read.seq[i] != origin[i];
+      first += read.qual.front() - '!';
+      last += read.qual.back() - '!';
+    }
+    REQUIRE(mismatches / 200000.0 == Approx(0.02).margin(0.003));
+    REQUIRE(first / reads.size() == Approx(38).margin(0.5));
+    REQUIRE(last / reads.size() == Approx(20).margin(0.5));
+  }
+
+  SECTION("Indels change the consumed reference") {
+    const auto profile = ReadProfile{.read_length = 100,
+                                     .substitution_rate = 0,
+                                     .insertion_rate = 0.01,
+                                     .deletion_rate = 0.01};
+    const auto reads = simulate_reads(genome, 0, 200, profile, 17);
+    auto changed = std::size_t{};
+    for (const auto &read : reads) {
+      REQUIRE(read.seq.size() == 100);
+      const auto [chrom, start, is_reverse] = parse_origin(read.name);
+      auto origin = genome[chrom == "chr1" ? 0 : 1].seq.substr(start, 100);
+      if (is_reverse)
+        origin = Codec::rev_comp(std::string_view{origin});
+      changed += read.seq != origin;
+    }
+    REQUIRE(changed > 100);
+  }
+}